@@ -0,0 +1,28 @@
+#ifndef ATRC_CFG_H_
+#define ATRC_CFG_H_
+
+/* ATRC (analog trace plot) Configuration, used when ADC_ENABLE is set */
+
+// Plot area rows (pixels): full scale (255) at the top row, 0 at the bottom;
+// the same band the edge plot (WAVE) uses
+#define ATRC_Y_TOP     40
+#define ATRC_Y_BOTTOM  63
+
+// Horizontal pixels per time division (128 / 16 = 8 divisions across)
+#define ATRC_PX_PER_DIV 16
+
+// Time per division in us at start-up, from the 1-2-5 sequence (0 = auto:
+// follow the period measured on ICP1, as the edge plot does)
+#define ATRC_TIMEBASE_US 0
+
+// 1: peak detect (every column spans the lowest to the highest sample in
+// it, narrow spikes survive slow timebases); 0: decimation (one sample per
+// column, a cleaner trace for smooth signals)
+#define ATRC_PEAK_DETECT 1
+
+// Trigger at start-up: level in 8-bit counts (128 = mid scale) and edge
+// (0 rising, 1 falling, 2 none = free run)
+#define ATRC_TRIGGER_LEVEL 128
+#define ATRC_TRIGGER_EDGE  0
+
+#endif /* ATRC_CFG_H_ */
@@ -0,0 +1,34 @@
+#ifndef ATRC_INT_H_
+#define ATRC_INT_H_
+
+#include "../../Service/std_types.h"
+
+/* ATRC (analog trace plot) Interface
+   Draws the records MCAL/ADC acquires into the plot area, one record column
+   per display column: each column is a vertical span from its lowest to its
+   highest sample, stretched to meet the previous column so the trace stays
+   connected. A tick at the left border marks the trigger level, one at the
+   top the trigger position (left out when the auto trigger took the
+   record). The display follows the record rate: a record that takes longer
+   than a display frame is drawn when it is complete. */
+
+// Start the ADC and the first record at the start-up timebase and trigger
+void ATRC_voidInit(void);
+
+// Time per division in us (1-2-5 steps read best); restarts the record
+void ATRC_voidSetTimebase(u32 Copy_u32UsPerDiv);
+
+// Time per division in effect: the sample rate is rounded to what Timer0 can
+// do, and fast timebases stop at the shortest ADC sample interval
+u32 ATRC_u32GetTimebase(void);
+
+// Pick the 1-2-5 timebase that shows 2-8 periods of the signal
+void ATRC_voidAutoTimebase(u32 Copy_u32PeriodCycles);
+
+// Trigger level (8-bit counts) and edge (ADC_EDGE_*), from the next record
+void ATRC_voidSetTrigger(u8 Copy_u8Level, u8 Copy_u8Edge);
+
+// Draw the record if one is complete and start the next; otherwise nothing
+void ATRC_voidRefresh(void);
+
+#endif /* ATRC_INT_H_ */
@@ -0,0 +1,20 @@
+#ifndef ATRC_PRIV_H_
+#define ATRC_PRIV_H_
+
+/* ATRC (analog trace plot) Private Definitions */
+
+// Plot area in pages
+#define ATRC_FIRST_PAGE  (ATRC_Y_TOP / 8)
+#define ATRC_LAST_PAGE   (ATRC_Y_BOTTOM / 8)
+#define ATRC_PAGES       (ATRC_LAST_PAGE - ATRC_FIRST_PAGE + 1)
+
+// Plot height in rows, minus one: the span an 8-bit sample is scaled to
+#define ATRC_ROWS_SPAN   (ATRC_Y_BOTTOM - ATRC_Y_TOP)
+
+// Trigger marks: level tick width (columns), position tick height (rows)
+#define ATRC_LEVEL_TICK  2
+#define ATRC_POS_TICK    2
+
+#define ATRC_CYCLES_PER_US (F_CPU / 1000000UL)
+
+#endif /* ATRC_PRIV_H_ */
@@ -0,0 +1,138 @@
+/*
+   Analog trace plot: ADC records drawn column by column into the plot area
+*/
+
+#include "../../Service/std_types.h"
+#include "../../MCAL/ADC/ADC_interface.h"
+#include "../../MCAL/ADC/ADC_cfg.h"
+#include "../../HAL/GLCD/GLCD_int.h"
+#include "../../HAL/GFX/GFX_int.h"
+#include "ATRC_cfg.h"
+#include "ATRC_priv.h"
+#include "ATRC_int.h"
+
+#if ADC_ENABLE
+
+#if ATRC_Y_BOTTOM >= GLCD_HEIGHT || ATRC_Y_TOP + 2 > ATRC_Y_BOTTOM
+#error "ATRC plot rows out of range"
+#endif
+#if ADC_COLUMNS != GLCD_WIDTH
+#error "ATRC draws one ADC record column per display column"
+#endif
+
+static u32 tdiv_us = 0;          // Requested time per division (auto timebase hysteresis)
+static u32 tdiv_real_us = 0;     // Time per division the ADC delivers
+static u8  trig_level = ATRC_TRIGGER_LEVEL;
+static u8  trig_edge = ATRC_TRIGGER_EDGE;
+
+// Plot rows of each page, so the rows of a shared page outside the plot stay blank
+static u8 plot_mask[ATRC_PAGES];
+
+/* 8-bit sample -> plot row, full scale at the top */
+static u8 ATRC_u8Row(u8 Copy_u8Sample)
+{
+    return ATRC_Y_BOTTOM - (u8)(((u16)Copy_u8Sample * ATRC_ROWS_SPAN + 127) / 255);
+}
+
+void ATRC_voidInit(void)
+{
+    for (u8 p = 0; p < ATRC_PAGES; p++)
+        plot_mask[p] = GFX_u8PageMask(ATRC_FIRST_PAGE + p, ATRC_Y_TOP, ATRC_Y_BOTTOM);
+
+    GLCD_voidFbClearPages(ATRC_FIRST_PAGE, ATRC_LAST_PAGE);
+    GLCD_voidFlush();
+
+    ADC_voidInit();
+    ADC_voidSetTrigger(trig_level, trig_edge);
+    ATRC_voidSetTimebase((ATRC_TIMEBASE_US != 0) ? ATRC_TIMEBASE_US : 1000);
+}
+
+void ATRC_voidSetTimebase(u32 Copy_u32UsPerDiv)
+{
+    u32 column = Copy_u32UsPerDiv * ATRC_CYCLES_PER_US / ATRC_PX_PER_DIV;
+
+    tdiv_us = Copy_u32UsPerDiv;
+    column = ADC_u32Start(column, ATRC_PEAK_DETECT ? ADC_FOLD_PEAK : ADC_FOLD_DECIMATE);
+    tdiv_real_us = (column * ATRC_PX_PER_DIV + ATRC_CYCLES_PER_US / 2) / ATRC_CYCLES_PER_US;
+}
+
+u32 ATRC_u32GetTimebase(void)
+{
+    return tdiv_real_us;
+}
+
+/* Same rule as the edge plot: keep the timebase while it shows 2-8 periods */
+void ATRC_voidAutoTimebase(u32 Copy_u32PeriodCycles)
+{
+    u32 period_us = Copy_u32PeriodCycles / ATRC_CYCLES_PER_US;
+    u32 step = 1;
+
+    if (tdiv_us * 4 >= period_us && tdiv_us <= period_us)
+        return;
+
+    while (step * 4 < period_us)
+    {
+        // 1 -> 2 -> 5 -> 10 ...
+        u32 decade = step;
+        while (decade >= 10) decade /= 10;
+        step = (decade == 2) ? step / 2 * 5 : step * 2;
+    }
+
+    if (step != tdiv_us)
+        ATRC_voidSetTimebase(step);
+}
+
+void ATRC_voidSetTrigger(u8 Copy_u8Level, u8 Copy_u8Edge)
+{
+    trig_level = Copy_u8Level;
+    trig_edge = Copy_u8Edge;
+    ADC_voidSetTrigger(Copy_u8Level, Copy_u8Edge);
+}
+
+void ATRC_voidRefresh(void)
+{
+    ADC_Column_t col;
+    u8 prev_top = 0, prev_bottom = 0;
+    u8 level_row = ATRC_u8Row(trig_level);
+    u8 triggered;
+
+    if (!ADC_u8RecordReady())
+        return;
+    triggered = ADC_u8Triggered();
+
+    for (u8 x = 0; x < GLCD_WIDTH; x++)
+    {
+        ADC_voidGetColumn(x, &col);
+        u8 top = ATRC_u8Row(col.max);
+        u8 bottom = ATRC_u8Row(col.min);
+
+        // Stretch to meet the previous column: a steep edge becomes one vertical line
+        if (x > 0)
+        {
+            if (prev_bottom < top)
+                top = prev_bottom + 1;
+            else if (prev_top > bottom)
+                bottom = prev_top - 1;
+        }
+        prev_top = ATRC_u8Row(col.max);
+        prev_bottom = ATRC_u8Row(col.min);
+
+        // Compose the column and write it (bytes that do not change stay clean)
+        for (u8 p = 0; p < ATRC_PAGES; p++)
+        {
+            u8 page = ATRC_FIRST_PAGE + p;
+            u8 bits = GFX_u8PageMask(page, top, bottom);
+
+            if (x < ATRC_LEVEL_TICK)
+                bits |= GFX_u8PageMask(page, level_row, level_row);
+            if (triggered && x == ADC_PRETRIGGER)
+                bits |= GFX_u8PageMask(page, ATRC_Y_TOP, ATRC_Y_TOP + ATRC_POS_TICK - 1);
+            GLCD_voidFbWriteByte(page, x, bits & plot_mask[p]);
+        }
+    }
+    GLCD_voidFlush();
+
+    ADC_voidArm();
+}
+
+#endif /* ADC_ENABLE */
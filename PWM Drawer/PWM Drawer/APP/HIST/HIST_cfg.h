@@ -0,0 +1,11 @@
+#ifndef HIST_CFG_H_
+#define HIST_CFG_H_
+
+/* HIST (edge history) Configuration */
+
+// Runs kept, 2 bytes each (max 255). The ATmega32 has 2 KB of RAM and the
+// GLCD framebuffer already takes half of it (budget in main.c); 48 runs =
+// 24 periods of history
+#define HIST_SIZE 48
+
+#endif /* HIST_CFG_H_ */
@@ -0,0 +1,27 @@
+#ifndef HIST_INT_H_
+#define HIST_INT_H_
+
+#include "../../Service/std_types.h"
+
+/* HIST (edge history) Interface
+   Run-length record of the captured signal: one 16-bit entry per constant
+   level stretch instead of one bit per sample, so HIST_SIZE entries cover
+   thousands of plot columns at any timebase. An entry holds the level and
+   the length as a small float (12-bit mantissa, base-4 exponent): exact up
+   to 4095 cycles, within 1/1024 above, up to 4.2 s per entry; longer runs
+   take several entries. The oldest runs are overwritten when full. */
+
+// Forget everything (capture gap: the time between edges is unknown)
+void HIST_voidClear(void);
+
+// Append a finished run: Copy_u8Level held for Copy_u32Cycles
+void HIST_voidAddRun(u32 Copy_u32Cycles, u8 Copy_u8Level);
+
+// Runs currently held
+u8 HIST_u8Count(void);
+
+// Length in cycles and level of a run counted back from the newest (age 0);
+// 0 once the age passes the oldest run
+u32 HIST_u32GetRun(u8 Copy_u8Age, u8 *Copy_pu8Level);
+
+#endif /* HIST_INT_H_ */
@@ -0,0 +1,79 @@
+/*
+   Edge history: run-length ring of the captured signal
+*/
+
+#include "../../Service/std_types.h"
+#include "HIST_cfg.h"
+#include "HIST_int.h"
+
+#if HIST_SIZE < 1 || HIST_SIZE > 255
+#error "HIST_SIZE must be 1-255"
+#endif
+
+// Entry layout: level, exponent e, mantissa m; length = m << (2 * e) cycles
+#define HIST_LEVEL_BIT   0x8000
+#define HIST_EXP_SHIFT   12
+#define HIST_EXP_MAX     7
+#define HIST_MANT_MAX    0x0FFF
+
+static u16 runs[HIST_SIZE];
+static u8  head = 0;       // Next entry to write
+static u8  count = 0;
+
+static void HIST_voidPush(u16 Copy_u16Entry)
+{
+    runs[head] = Copy_u16Entry;
+    if (++head >= HIST_SIZE) head = 0;
+    if (count < HIST_SIZE) count++;
+}
+
+void HIST_voidClear(void)
+{
+    head = 0;
+    count = 0;
+}
+
+void HIST_voidAddRun(u32 Copy_u32Cycles, u8 Copy_u8Level)
+{
+    u16 level = Copy_u8Level ? HIST_LEVEL_BIT : 0;
+
+    do
+    {
+        // Smallest exponent that fits the mantissa; bits below it are dropped
+        u8 e = 0;
+        while (e < HIST_EXP_MAX && (Copy_u32Cycles >> (2 * e)) > HIST_MANT_MAX)
+            e++;
+
+        u32 m = Copy_u32Cycles >> (2 * e);
+
+        // Only a run too long for one entry continues in the next one
+        if (m > HIST_MANT_MAX)
+        {
+            m = HIST_MANT_MAX;
+            Copy_u32Cycles -= m << (2 * e);
+        }
+        else
+        {
+            Copy_u32Cycles = 0;
+        }
+
+        HIST_voidPush(level | ((u16)e << HIST_EXP_SHIFT) | (u16)m);
+    } while (Copy_u32Cycles != 0);
+}
+
+u8 HIST_u8Count(void)
+{
+    return count;
+}
+
+u32 HIST_u32GetRun(u8 Copy_u8Age, u8 *Copy_pu8Level)
+{
+    if (Copy_u8Age >= count) return 0;
+
+    s16 index = (s16)head - 1 - Copy_u8Age;
+    if (index < 0) index += HIST_SIZE;
+
+    u16 entry = runs[index];
+    *Copy_pu8Level = (entry & HIST_LEVEL_BIT) ? 1 : 0;
+    return (u32)(entry & HIST_MANT_MAX) << (2 * ((entry >> HIST_EXP_SHIFT) & HIST_EXP_MAX));
+}
@@ -0,0 +1,9 @@
+#ifndef MCH_CFG_H_
+#define MCH_CFG_H_
+
+/* MCH (multi-channel measurement) Configuration */
+
+// Edges copied out of a channel ring per read (stack buffer of 5 bytes each)
+#define MCH_BATCH 8
+
+#endif /* MCH_CFG_H_ */
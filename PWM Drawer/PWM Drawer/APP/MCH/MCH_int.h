@@ -0,0 +1,30 @@
+#ifndef MCH_INT_H_
+#define MCH_INT_H_
+
+#include "../../Service/std_types.h"
+
+/* MCH (multi-channel measurement) Interface
+   Pairs the edges of the EXTI channels into periods and high times the way
+   main.c does for ICP1, and sums them per channel between reads. Values are
+   CPU cycles. */
+
+typedef struct
+{
+    u16 count;          // Complete periods averaged
+    u32 period;         // Mean period, rounded to nearest
+    u32 high;           // Mean high time, rounded to nearest
+    u32 period_min;
+    u32 period_max;
+} MCH_Result_t;
+
+// Forget the pairing state and the sums of every channel
+void MCH_voidInit(void);
+
+// Drain every EXTI ring and pair the edges (call on every wake-up)
+void MCH_voidProcess(void);
+
+// Averages of a channel since the last call; returns 0 (and leaves
+// *Copy_pResult alone) when no complete period came in meanwhile
+u8 MCH_u8GetResult(u8 Copy_u8Channel, MCH_Result_t *Copy_pResult);
+
+#endif /* MCH_INT_H_ */
@@ -0,0 +1,23 @@
+#ifndef MCH_PRIV_H_
+#define MCH_PRIV_H_
+
+/* MCH (multi-channel measurement) Private Definitions */
+
+// A tick difference this large is a stamp behind the one it is paired with
+#define MCH_BACKWARD 0x80000000UL
+
+// Edge pairing state and running sums of one channel
+typedef struct
+{
+    u32 last_rise;
+    u32 last_fall;
+    u8  have_rise;
+    u8  have_fall;
+    u16 count;          // Complete periods since the last MCH_u8GetResult
+    u32 period_sum;     // CPU cycles
+    u32 high_sum;
+    u32 period_min;
+    u32 period_max;
+} MCH_Chan_t;
+
+#endif /* MCH_PRIV_H_ */
@@ -0,0 +1,106 @@
+/*
+   Per-channel period / high time measurement of the EXTI edge streams
+*/
+
+#include "../../Service/std_types.h"
+#include "../../MCAL/ICU/ICU_interface.h"
+#include "../../MCAL/EXTI/EXTI_interface.h"
+#include "../../MCAL/EXTI/EXTI_cfg.h"
+#include "MCH_cfg.h"
+#include "MCH_priv.h"
+#include "MCH_int.h"
+
+#if EXTI_ENABLE
+
+static MCH_Chan_t chan[EXTI_CHANNELS];
+
+static void MCH_voidClearSums(MCH_Chan_t *Copy_pChan)
+{
+    Copy_pChan->count = 0;
+    Copy_pChan->period_sum = Copy_pChan->high_sum = 0;
+    Copy_pChan->period_min = 0xFFFFFFFFUL;
+    Copy_pChan->period_max = 0;
+}
+
+/* Same pairing as ICP1 in main.c: a rising edge closes the period that
+   started at the previous rising edge, if a falling edge came in between */
+static void MCH_voidEdge(MCH_Chan_t *Copy_pChan, const ICU_Edge_t *Copy_pEdge)
+{
+    u32 ts = Copy_pEdge->timestamp;
+
+    if (Copy_pEdge->flags & ICU_FLAG_GAP)
+        Copy_pChan->have_rise = Copy_pChan->have_fall = 0;
+
+    if (Copy_pEdge->flags & ICU_FLAG_RISING)
+    {
+        u32 period_ticks = ts - Copy_pChan->last_rise;
+        u32 high_ticks = Copy_pChan->last_fall - Copy_pChan->last_rise;
+
+        // A stamp behind its partner (an uncounted Timer1 wrap) would average
+        // in a period of ~2^32 ticks: start over from this edge, as after a gap
+        if (period_ticks >= MCH_BACKWARD || high_ticks >= MCH_BACKWARD)
+            Copy_pChan->have_fall = 0;
+
+        if (Copy_pChan->have_rise && Copy_pChan->have_fall)
+        {
+            u32 period = ICU_u32TicksToCycles(period_ticks, Copy_pEdge->flags);
+            u32 high = ICU_u32TicksToCycles(high_ticks, Copy_pEdge->flags);
+
+            Copy_pChan->period_sum += period;
+            Copy_pChan->high_sum += high;
+            Copy_pChan->count++;
+            if (period < Copy_pChan->period_min) Copy_pChan->period_min = period;
+            if (period > Copy_pChan->period_max) Copy_pChan->period_max = period;
+        }
+        Copy_pChan->last_rise = ts;
+        Copy_pChan->have_rise = 1;
+        Copy_pChan->have_fall = 0;
+    }
+    else if (Copy_pChan->have_rise)
+    {
+        Copy_pChan->last_fall = ts;
+        Copy_pChan->have_fall = 1;
+    }
+}
+
+void MCH_voidInit(void)
+{
+    for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+    {
+        chan[ch].have_rise = chan[ch].have_fall = 0;
+        MCH_voidClearSums(&chan[ch]);
+    }
+}
+
+void MCH_voidProcess(void)
+{
+    ICU_Edge_t batch[MCH_BATCH];
+    u8 n;
+
+    for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+    {
+        while ((n = EXTI_u8ReadEdges(ch, batch, MCH_BATCH)) > 0)
+        {
+            for (u8 i = 0; i < n; i++)
+                MCH_voidEdge(&chan[ch], &batch[i]);
+        }
+    }
+}
+
+u8 MCH_u8GetResult(u8 Copy_u8Channel, MCH_Result_t *Copy_pResult)
+{
+    MCH_Chan_t *c = &chan[Copy_u8Channel];
+
+    if (c->count == 0)
+        return 0;
+
+    Copy_pResult->count = c->count;
+    Copy_pResult->period = (c->period_sum + c->count / 2) / c->count;
+    Copy_pResult->high = (c->high_sum + c->count / 2) / c->count;
+    Copy_pResult->period_min = c->period_min;
+    Copy_pResult->period_max = c->period_max;
+    MCH_voidClearSums(c);
+    return 1;
+}
+
+#endif /* EXTI_ENABLE */
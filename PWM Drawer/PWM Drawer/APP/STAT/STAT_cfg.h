@@ -0,0 +1,15 @@
+#ifndef STAT_CFG_H_
+#define STAT_CFG_H_
+
+/* STAT (period statistics) Configuration */
+
+// Periods per statistics window (2-256): results are published once the
+// window is full and the next one starts from scratch
+#define STAT_WINDOW 64
+
+// 1: the text area shows the period statistics instead of duty / time / div
+#ifndef STAT_PAGE_ENABLE
+#define STAT_PAGE_ENABLE 0
+#endif
+
+#endif /* STAT_CFG_H_ */
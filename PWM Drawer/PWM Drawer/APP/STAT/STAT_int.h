@@ -0,0 +1,47 @@
+#ifndef STAT_INT_H_
+#define STAT_INT_H_
+
+#include "../../Service/std_types.h"
+
+/* STAT (period statistics) Interface
+   Streaming min / max / mean / standard deviation of the period and high
+   time over STAT_WINDOW periods, plus period jitter. Sums are integer
+   (deviations from the window's first sample, so no large squares) and
+   each sample costs a fixed number of operations; the divisions and square
+   roots run once per window, in STAT_u8GetResult(). All values are CPU
+   cycles. */
+
+typedef struct
+{
+    u32 min;
+    u32 max;
+    u32 mean;       // Rounded to nearest
+    u32 stddev;     // Population standard deviation, rounded down
+} STAT_Summary_t;
+
+typedef struct
+{
+    u16 count;              // Periods in the window
+    STAT_Summary_t period;
+    STAT_Summary_t high;
+    u32 jitter_pp;          // Period jitter peak-to-peak (max - min)
+    u32 jitter_rms;         // Period jitter RMS (standard deviation of the period)
+    u32 jitter_c2c;         // Largest change between adjacent periods
+    u8  clamped;            // 1: a sample was more than 2^23 cycles from the window's
+                            // first one, mean / stddev / jitter_rms are approximate
+} STAT_Result_t;
+
+// Drop the open window and the published result
+void STAT_voidReset(void);
+
+// One complete period and the high time inside it
+void STAT_voidAddPeriod(u32 Copy_u32Period, u32 Copy_u32High);
+
+// The next period does not follow the last one (edges lost, clock changed)
+void STAT_voidBreak(void);
+
+// Copy the newest complete window; returns 1 once per new window, 0 if
+// nothing new has been published since the last call
+u8 STAT_u8GetResult(STAT_Result_t *Copy_pResult);
+
+#endif /* STAT_INT_H_ */
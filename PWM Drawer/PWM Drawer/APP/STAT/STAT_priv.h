@@ -0,0 +1,22 @@
+#ifndef STAT_PRIV_H_
+#define STAT_PRIV_H_
+
+/* STAT (period statistics) Private Definitions */
+
+// Deviations from the window's first sample are held to +-2^23 cycles
+// (0.5 s), so the deviation sum fits 32 bits and the sum of squares 64 bits
+// for any window up to 256; a window with a clamped deviation is flagged
+#define STAT_DEV_LIMIT  0x7FFFFFL
+
+// Running sums of one quantity over the open window
+typedef struct
+{
+    u32 ref;        // First sample, deviations are taken from it
+    u32 min;
+    u32 max;
+    s32 dev_sum;    // Sum of (x - ref)
+    u64 dev_sq_sum; // Sum of (x - ref)^2
+    u8  clamped;    // 1: a deviation was held to STAT_DEV_LIMIT
+} STAT_Acc_t;
+
+#endif /* STAT_PRIV_H_ */
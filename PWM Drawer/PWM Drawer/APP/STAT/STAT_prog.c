@@ -0,0 +1,170 @@
+/*
+   Period statistics over a window of captured periods
+*/
+
+#include "../../Service/std_types.h"
+#include "STAT_cfg.h"
+#include "STAT_priv.h"
+#include "STAT_int.h"
+
+#if STAT_WINDOW < 2 || STAT_WINDOW > 256
+#error "STAT_WINDOW must be 2-256"
+#endif
+
+static STAT_Acc_t acc_period;
+static STAT_Acc_t acc_high;
+static u16 count = 0;
+static u32 prev_period = 0;     // For the cycle-to-cycle jitter
+static u8  prev_valid = 0;
+static u32 c2c_max = 0;
+
+// Sums of the last full window, summarised when the result is read
+static STAT_Acc_t done_period;
+static STAT_Acc_t done_high;
+static u32 done_c2c = 0;
+static u8  done_new = 0;
+
+/* Floor of the square root, one result bit per step */
+static u32 STAT_u32Sqrt(u64 Copy_u64Value)
+{
+    u64 root = 0;
+    u64 bit = (u64)1 << 62;
+
+    while (bit > Copy_u64Value)
+        bit >>= 2;
+    while (bit != 0)
+    {
+        if (Copy_u64Value >= root + bit)
+        {
+            Copy_u64Value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (u32)root;
+}
+
+static void STAT_voidAccAdd(STAT_Acc_t *Copy_pAcc, u32 Copy_u32Value)
+{
+    s32 d;
+    u32 ad;
+
+    if (count == 0)
+    {
+        Copy_pAcc->ref = Copy_pAcc->min = Copy_pAcc->max = Copy_u32Value;
+        Copy_pAcc->dev_sum = 0;
+        Copy_pAcc->dev_sq_sum = 0;
+        Copy_pAcc->clamped = 0;
+        return;
+    }
+
+    if (Copy_u32Value < Copy_pAcc->min) Copy_pAcc->min = Copy_u32Value;
+    if (Copy_u32Value > Copy_pAcc->max) Copy_pAcc->max = Copy_u32Value;
+
+    if (Copy_u32Value >= Copy_pAcc->ref)
+    {
+        ad = Copy_u32Value - Copy_pAcc->ref;
+        if (ad > STAT_DEV_LIMIT)
+        {
+            ad = STAT_DEV_LIMIT;
+            Copy_pAcc->clamped = 1;
+        }
+        d = (s32)ad;
+    }
+    else
+    {
+        ad = Copy_pAcc->ref - Copy_u32Value;
+        if (ad > STAT_DEV_LIMIT)
+        {
+            ad = STAT_DEV_LIMIT;
+            Copy_pAcc->clamped = 1;
+        }
+        d = -(s32)ad;
+    }
+    Copy_pAcc->dev_sum += d;
+
+    // Jitter-sized deviations square in 32 bits, the full multiply is the exception
+    if (ad <= 0xFFFF)
+        Copy_pAcc->dev_sq_sum += (u32)(ad * ad);
+    else
+        Copy_pAcc->dev_sq_sum += (u64)ad * ad;
+}
+
+/* Mean and standard deviation from the deviation sums:
+   var = (sum d^2 - (sum d)^2 / n) / n, mean = ref + sum d / n */
+static void STAT_voidAccSummary(const STAT_Acc_t *Copy_pAcc, u16 Copy_u16Count, STAT_Summary_t *Copy_pOut)
+{
+    s32 sum = Copy_pAcc->dev_sum;
+    u32 asum = (sum < 0) ? (u32)-sum : (u32)sum;
+    u32 mean_dev = (asum + Copy_u16Count / 2) / Copy_u16Count;
+    u64 sq_of_sum = (u64)asum * asum / Copy_u16Count;
+
+    Copy_pOut->min = Copy_pAcc->min;
+    Copy_pOut->max = Copy_pAcc->max;
+    Copy_pOut->mean = (sum < 0) ? Copy_pAcc->ref - mean_dev : Copy_pAcc->ref + mean_dev;
+    Copy_pOut->stddev = (Copy_pAcc->dev_sq_sum > sq_of_sum)
+                      ? STAT_u32Sqrt((Copy_pAcc->dev_sq_sum - sq_of_sum) / Copy_u16Count)
+                      : 0;
+}
+
+void STAT_voidReset(void)
+{
+    count = 0;
+    prev_valid = 0;
+    c2c_max = 0;
+    done_new = 0;
+}
+
+void STAT_voidAddPeriod(u32 Copy_u32Period, u32 Copy_u32High)
+{
+    if (count == 0)
+        c2c_max = 0;
+
+    STAT_voidAccAdd(&acc_period, Copy_u32Period);
+    STAT_voidAccAdd(&acc_high, Copy_u32High);
+
+    if (prev_valid)
+    {
+        u32 step = (Copy_u32Period > prev_period) ? Copy_u32Period - prev_period
+                                                  : prev_period - Copy_u32Period;
+        if (step > c2c_max) c2c_max = step;
+    }
+    prev_period = Copy_u32Period;
+    prev_valid = 1;
+
+    if (++count < STAT_WINDOW)
+        return;
+
+    // Window full: hand the sums over and start the next one (a window
+    // nobody read in time is replaced)
+    done_period = acc_period;
+    done_high = acc_high;
+    done_c2c = c2c_max;
+    done_new = 1;
+    count = 0;
+}
+
+void STAT_voidBreak(void)
+{
+    prev_valid = 0;
+}
+
+u8 STAT_u8GetResult(STAT_Result_t *Copy_pResult)
+{
+    if (!done_new)
+        return 0;
+
+    STAT_voidAccSummary(&done_period, STAT_WINDOW, &Copy_pResult->period);
+    STAT_voidAccSummary(&done_high, STAT_WINDOW, &Copy_pResult->high);
+    Copy_pResult->count = STAT_WINDOW;
+    Copy_pResult->jitter_pp = Copy_pResult->period.max - Copy_pResult->period.min;
+    Copy_pResult->jitter_rms = Copy_pResult->period.stddev;
+    Copy_pResult->jitter_c2c = done_c2c;
+    Copy_pResult->clamped = done_period.clamped | done_high.clamped;
+    done_new = 0;
+    return 1;
+}
@@ -0,0 +1,17 @@
+#ifndef STRIP_CFG_H_
+#define STRIP_CFG_H_
+
+/* STRIP (scrolling strip chart) Configuration */
+
+// 1 = main() shows the strip chart instead of the status text and waveform
+#ifndef STRIP_ENABLE
+#define STRIP_ENABLE 0
+#endif
+
+// Measurements averaged into one chart row
+#define STRIP_DECIMATE 8
+
+// Frequency axis: log2 scale from 1 Hz up to 2^STRIP_FREQ_LOG2_MAX Hz
+#define STRIP_FREQ_LOG2_MAX 23
+
+#endif /* STRIP_CFG_H_ */
@@ -0,0 +1,35 @@
+#ifndef STRIP_INT_H_
+#define STRIP_INT_H_
+
+#include "../../Service/std_types.h"
+
+/* STRIP (scrolling strip chart) Interface
+   Duty (left half, linear) and frequency (right half, log2) history, one
+   display row per STRIP_DECIMATE measurements, newest at the bottom.
+   Scrolling uses the KS0108 start line instead of redrawing: rows fill the
+   bottom page one by one, and once it is full the start line moves down a
+   page. The page that scrolled off the top comes back as the new, cleared
+   bottom page, and the header text is redrawn on the page that moved under
+   the top row. So a row costs a few byte writes and a scroll two pages,
+   whatever the chart holds. The GLCD page remapping keeps the header on the
+   top row for the callers. */
+
+// Blank the display, header on top, chart empty
+void STRIP_voidInit(void);
+
+// Header text (up to 21 characters); only changed bytes reach the display
+void STRIP_voidSetHeader(const char *Copy_pcText);
+
+// Add one measurement; every STRIP_DECIMATE of them make a row
+void STRIP_voidAddSample(u16 Copy_u16DutyPermille, u32 Copy_u32FreqHz);
+
+// Push pending rows and header changes to the display
+void STRIP_voidRefresh(void);
+
+// X position of a frequency on the log2 axis (STRIP_HALF .. GLCD_WIDTH - 1)
+u8 STRIP_u8FreqX(u32 Copy_u32FreqHz);
+
+// X position of a duty value (0 .. STRIP_HALF - 1)
+u8 STRIP_u8DutyX(u16 Copy_u16DutyPermille);
+
+#endif /* STRIP_INT_H_ */
@@ -0,0 +1,18 @@
+#ifndef STRIP_PRIV_H_
+#define STRIP_PRIV_H_
+
+/* STRIP (scrolling strip chart) Private Definitions */
+
+// Screen page 0 holds the header text, the chart grows at the bottom page
+#define STRIP_HEADER_PAGE  0
+#define STRIP_BOTTOM_PAGE  (GLCD_PAGES - 1)
+
+// Traces: duty on the left half, frequency on the right half
+#define STRIP_HALF         (GLCD_WIDTH / 2)
+
+// Longest header: one text row of FONT_5x7 (5 columns plus 1 of spacing)
+#define STRIP_HEADER_MAX   (GLCD_WIDTH / 6)
+
+#define STRIP_NO_X         0xFF   // No previous point to connect to
+
+#endif /* STRIP_PRIV_H_ */
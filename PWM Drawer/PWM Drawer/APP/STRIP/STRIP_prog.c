@@ -0,0 +1,136 @@
+/*
+   Strip chart of duty and frequency, scrolled with the KS0108 start line
+*/
+
+#include "../../Service/std_types.h"
+#include "../../HAL/GLCD/GLCD_int.h"
+#include "../../HAL/GFX/GFX_int.h"
+#include "../../HAL/FONT/FONT_int.h"
+#include "STRIP_cfg.h"
+#include "STRIP_priv.h"
+#include "STRIP_int.h"
+
+#if STRIP_ENABLE
+
+static char header[STRIP_HEADER_MAX + 1];
+
+static u8  row = 0;                  // Next row inside the bottom page (0-7)
+static u8  prev_duty_x = STRIP_NO_X; // Points of the previous row, to join up
+static u8  prev_freq_x = STRIP_NO_X;
+
+static u8  samples = 0;
+static u32 duty_sum = 0;
+static u32 freq_sum = 0;
+
+/* Header row: text, then blank to the right border (bytes left over from
+   the chart page it now sits on) */
+static void STRIP_voidDrawHeader(void)
+{
+    FONT_t desc;
+    u8 col = 0;
+
+    // Same advance as the renderer, which skips characters the font lacks
+    FONT_voidLoad(&FONT_5x7, &desc);
+    for (const char *c = header; *c && col < GLCD_WIDTH; c++)
+        if (FONT_u8Has(&desc, *c))
+            col += desc.width + desc.spacing;
+    GLCD_voidFbDisplayString(STRIP_HEADER_PAGE, 0, (const u8 *)header);
+    if (col < GLCD_WIDTH)
+        GFX_voidFillRect(col, STRIP_HEADER_PAGE * 8, GLCD_WIDTH - 1, STRIP_HEADER_PAGE * 8 + 7, GFX_CLEAR);
+}
+
+/* Bottom page full: move the start line down a page. Screen page 1 slides
+   under the header and is overwritten by it, the old header page returns at
+   the bottom and is cleared; nothing else is rewritten */
+static void STRIP_voidScroll(void)
+{
+    GLCD_voidSetStartPage(GLCD_u8GetStartPage() + 1);
+    GLCD_voidFbClearPages(STRIP_BOTTOM_PAGE, STRIP_BOTTOM_PAGE);
+    STRIP_voidDrawHeader();
+    row = 0;
+}
+
+/* One point of a trace, joined to the previous row's point by a horizontal run */
+static void STRIP_voidPlot(u8 Copy_u8X, u8 Copy_u8PrevX)
+{
+    if (Copy_u8PrevX == STRIP_NO_X)
+        Copy_u8PrevX = Copy_u8X;
+    GFX_voidHLine(Copy_u8PrevX, Copy_u8X, STRIP_BOTTOM_PAGE * 8 + row, GFX_SET);
+}
+
+u8 STRIP_u8DutyX(u16 Copy_u16DutyPermille)
+{
+    if (Copy_u16DutyPermille > 1000) Copy_u16DutyPermille = 1000;
+    return (u8)(((u32)Copy_u16DutyPermille * (STRIP_HALF - 1)) / 1000);
+}
+
+/* log2 with 3 fractional bits (the bits right below the leading one),
+   scaled onto the right half */
+u8 STRIP_u8FreqX(u32 Copy_u32FreqHz)
+{
+    u8 msb = 0;
+    u16 log8;
+
+    if (Copy_u32FreqHz == 0) return STRIP_HALF;
+
+    while ((Copy_u32FreqHz >> msb) > 1)
+        msb++;
+    log8 = (u16)msb * 8;
+    if (msb >= 3)
+        log8 += (Copy_u32FreqHz >> (msb - 3)) & 7;
+    else
+        log8 += (Copy_u32FreqHz << (3 - msb)) & 7;
+
+    if (log8 > STRIP_FREQ_LOG2_MAX * 8)
+        log8 = STRIP_FREQ_LOG2_MAX * 8;
+    return STRIP_HALF + (u8)(((u32)log8 * (STRIP_HALF - 1)) / (STRIP_FREQ_LOG2_MAX * 8));
+}
+
+void STRIP_voidInit(void)
+{
+    GLCD_voidSetStartPage(0);
+    GLCD_voidClear();
+    header[0] = '\0';
+    row = 0;
+    prev_duty_x = prev_freq_x = STRIP_NO_X;
+    samples = 0;
+    duty_sum = freq_sum = 0;
+}
+
+void STRIP_voidSetHeader(const char *Copy_pcText)
+{
+    u8 i;
+    for (i = 0; i < STRIP_HEADER_MAX && Copy_pcText[i]; i++)
+        header[i] = Copy_pcText[i];
+    header[i] = '\0';
+    STRIP_voidDrawHeader();
+}
+
+void STRIP_voidAddSample(u16 Copy_u16DutyPermille, u32 Copy_u32FreqHz)
+{
+    duty_sum += Copy_u16DutyPermille;
+    freq_sum += Copy_u32FreqHz;
+    if (++samples < STRIP_DECIMATE)
+        return;
+
+    u8 duty_x = STRIP_u8DutyX((u16)(duty_sum / STRIP_DECIMATE));
+    u8 freq_x = STRIP_u8FreqX(freq_sum / STRIP_DECIMATE);
+    samples = 0;
+    duty_sum = freq_sum = 0;
+
+    if (row >= 8)
+        STRIP_voidScroll();
+
+    STRIP_voidPlot(duty_x, prev_duty_x);
+    STRIP_voidPlot(freq_x, prev_freq_x);
+    prev_duty_x = duty_x;
+    prev_freq_x = freq_x;
+    row++;
+}
+
+void STRIP_voidRefresh(void)
+{
+    GLCD_voidFlush();
+}
+
+#endif /* STRIP_ENABLE */
@@ -0,0 +1,25 @@
+#ifndef TLM_CFG_H_
+#define TLM_CFG_H_
+
+/* TLM (telemetry frames over the USART) Configuration */
+
+// 1: stream measurements on TXD (PD1), see TLM_int.h for the frame format
+#ifndef TLM_ENABLE
+#define TLM_ENABLE 0
+#endif
+
+// Record types sent (1 = on)
+#define TLM_MEAS_ENABLE    1   // Display values, once per display frame
+#define TLM_STATS_ENABLE   1   // STAT window summaries, once per window
+#define TLM_PERIODS_ENABLE 1   // Every captured period and high time, in batches
+
+// Periods per TLM_TYPE_PERIODS frame (1-7: 8 bytes each)
+#define TLM_PERIOD_BATCH 6
+
+// Period frames are only queued while this much of the UART ring stays free
+// afterwards, so a fast signal cannot crowd out the measurement and
+// statistics frames; a batch that does not fit waits for the next period,
+// then is dropped (sequence gap)
+#define TLM_PERIODS_RESERVE (TLM_FRAME_OVERHEAD + TLM_STATS_LEN)
+
+#endif /* TLM_CFG_H_ */
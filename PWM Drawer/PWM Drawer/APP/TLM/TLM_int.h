@@ -0,0 +1,60 @@
+#ifndef TLM_INT_H_
+#define TLM_INT_H_
+
+#include "../../Service/std_types.h"
+#include "../STAT/STAT_int.h"
+
+/* TLM (telemetry frames over the USART) Interface
+   Frame layout, multi-byte fields little endian:
+     0xA5 0x5A | type | seq | len | payload[len] | crc16
+   seq counts every frame built, including the ones the UART ring refused,
+   so a gap in it shows what was lost. The CRC (Service/CRC) covers type
+   through the end of the payload. A reader that loses sync scans for the
+   next 0xA5 0x5A whose frame checks out.
+   Payloads:
+     TLM_TYPE_MEAS    freq u32, freq_frac u8 (freq = value / 10^frac Hz),
+                      duty u16 (0.1 %), period u32 (cycles, 0 = none), flags u8
+     TLM_TYPE_PERIODS first u16 (index of the first period, wraps), then up
+                      to TLM_PERIOD_BATCH x { period u32, high u32 } (cycles)
+     TLM_TYPE_STATS   count u16, period { min max mean stddev } u32,
+                      high { min max mean stddev } u32, jitter pp rms c2c u32,
+                      flags u8
+   Cycles are CPU cycles at F_CPU (16 MHz). This header is shared with the
+   host-side decoder. */
+
+#define TLM_SYNC0 0xA5
+#define TLM_SYNC1 0x5A
+
+#define TLM_TYPE_MEAS    0x01
+#define TLM_TYPE_PERIODS 0x02
+#define TLM_TYPE_STATS   0x03
+
+// TLM_TYPE_MEAS flags
+#define TLM_MEAS_COUNTING 0x01   // Frequency from the gated counter (no duty, no period)
+
+// TLM_TYPE_STATS flags
+#define TLM_STATS_CLAMPED 0x01   // A deviation was clamped: mean, stddev and rms are approximate
+
+#define TLM_HEADER_LEN     5     // Sync x2, type, seq, len
+#define TLM_CRC_LEN        2
+#define TLM_FRAME_OVERHEAD (TLM_HEADER_LEN + TLM_CRC_LEN)
+
+#define TLM_MEAS_LEN    12
+#define TLM_PERIOD_LEN  8
+#define TLM_STATS_LEN   47
+#define TLM_PAYLOAD_MAX 64
+
+// Start the USART and reset the sequence number and the period batch
+void TLM_voidInit(void);
+
+// One display frame's values, as main() shows them
+void TLM_voidSendMeasurement(u32 Copy_u32FreqVal, u8 Copy_u8FreqFrac, u16 Copy_u16DutyPermille,
+                             u32 Copy_u32PeriodCycles, u8 Copy_u8Flags);
+
+// One complete period; a frame goes out every TLM_PERIOD_BATCH periods
+void TLM_voidAddPeriod(u32 Copy_u32Period, u32 Copy_u32High);
+
+// A finished STAT window
+void TLM_voidSendStats(const STAT_Result_t *Copy_pStats);
+
+#endif /* TLM_INT_H_ */
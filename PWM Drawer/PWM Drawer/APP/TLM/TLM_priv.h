@@ -0,0 +1,14 @@
+#ifndef TLM_PRIV_H_
+#define TLM_PRIV_H_
+
+/* TLM (telemetry frames over the USART) Private Definitions */
+
+#if TLM_PERIOD_BATCH < 1 || 2 + TLM_PERIOD_BATCH * TLM_PERIOD_LEN > TLM_PAYLOAD_MAX
+#error "TLM_PERIOD_BATCH does not fit a frame"
+#endif
+
+// Little-endian stores into a payload under construction
+#define TLM_PUT16(p, v) do { (p)[0] = (u8)(v); (p)[1] = (u8)((v) >> 8); (p) += 2; } while (0)
+#define TLM_PUT32(p, v) do { TLM_PUT16(p, (u16)(v)); TLM_PUT16(p, (u16)((u32)(v) >> 16)); } while (0)
+
+#endif /* TLM_PRIV_H_ */
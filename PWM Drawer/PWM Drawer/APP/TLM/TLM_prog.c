@@ -0,0 +1,149 @@
+/*
+   Framed binary telemetry, queued on the interrupt-driven UART
+*/
+
+#include "../../Service/std_types.h"
+#include "../../Service/CRC/CRC_interface.h"
+#include "../../MCAL/UART/UART_interface.h"
+#include "../STAT/STAT_int.h"
+#include "TLM_int.h"
+#include "TLM_cfg.h"
+#include "TLM_priv.h"
+
+#if TLM_ENABLE
+
+static u8 seq = 0;
+
+#if TLM_PERIODS_ENABLE
+static u8  batch[2 + TLM_PERIOD_BATCH * TLM_PERIOD_LEN];
+static u8  batch_count = 0;
+static u16 period_index = 0;     // Index of the next period
+#endif
+
+/* Queue a frame straight from its payload: header, payload and CRC go in as
+   three writes once the ring is known to hold them all (only the main loop
+   writes, the ISR only frees space), so no copy of the frame is built on
+   the stack. Copy_u8Reserve bytes of the ring must stay free after it;
+   returns 0 and queues nothing otherwise */
+static u8 TLM_u8Queue(u8 Copy_u8Type, const u8 *Copy_pu8Payload, u8 Copy_u8Len, u8 Copy_u8Reserve)
+{
+    u8 header[TLM_HEADER_LEN];
+    u8 check[TLM_CRC_LEN];
+    u16 crc;
+
+    if (UART_u8Free() < TLM_FRAME_OVERHEAD + Copy_u8Len + Copy_u8Reserve)
+        return 0;
+
+    header[0] = TLM_SYNC0;
+    header[1] = TLM_SYNC1;
+    header[2] = Copy_u8Type;
+    header[3] = seq++;
+    header[4] = Copy_u8Len;
+    crc = CRC_u16Update(CRC_INIT, header + 2, TLM_HEADER_LEN - 2);
+    crc = CRC_u16Update(crc, Copy_pu8Payload, Copy_u8Len);
+    check[0] = (u8)crc;
+    check[1] = (u8)(crc >> 8);
+
+    UART_u8Write(header, TLM_HEADER_LEN);
+    UART_u8Write(Copy_pu8Payload, Copy_u8Len);
+    UART_u8Write(check, TLM_CRC_LEN);
+    return 1;
+}
+
+/* Queue the frame or drop it; a dropped frame uses up its sequence number
+   all the same, so the reader sees the gap */
+static void TLM_voidSend(u8 Copy_u8Type, const u8 *Copy_pu8Payload, u8 Copy_u8Len, u8 Copy_u8Reserve)
+{
+    if (!TLM_u8Queue(Copy_u8Type, Copy_pu8Payload, Copy_u8Len, Copy_u8Reserve))
+        seq++;
+}
+
+void TLM_voidInit(void)
+{
+    UART_voidInit();
+    seq = 0;
+#if TLM_PERIODS_ENABLE
+    batch_count = 0;
+    period_index = 0;
+#endif
+}
+
+void TLM_voidSendMeasurement(u32 Copy_u32FreqVal, u8 Copy_u8FreqFrac, u16 Copy_u16DutyPermille,
+                             u32 Copy_u32PeriodCycles, u8 Copy_u8Flags)
+{
+#if TLM_MEAS_ENABLE
+    u8 payload[TLM_MEAS_LEN];
+    u8 *p = payload;
+
+    TLM_PUT32(p, Copy_u32FreqVal);
+    *p++ = Copy_u8FreqFrac;
+    TLM_PUT16(p, Copy_u16DutyPermille);
+    TLM_PUT32(p, Copy_u32PeriodCycles);
+    *p++ = Copy_u8Flags;
+    TLM_voidSend(TLM_TYPE_MEAS, payload, TLM_MEAS_LEN, 0);
+#else
+    (void)Copy_u32FreqVal; (void)Copy_u8FreqFrac; (void)Copy_u16DutyPermille;
+    (void)Copy_u32PeriodCycles; (void)Copy_u8Flags;
+#endif
+}
+
+void TLM_voidAddPeriod(u32 Copy_u32Period, u32 Copy_u32High)
+{
+#if TLM_PERIODS_ENABLE
+    u8 *p;
+
+    // A full batch the ring had no room for gets one more try as the next
+    // period arrives (the ring drains a measurement frame within one
+    // period at 1 kHz), then it is dropped
+    if (batch_count == TLM_PERIOD_BATCH)
+    {
+        TLM_voidSend(TLM_TYPE_PERIODS, batch, sizeof(batch), TLM_PERIODS_RESERVE);
+        batch_count = 0;
+    }
+    if (batch_count == 0)
+    {
+        p = batch;
+        TLM_PUT16(p, period_index);
+    }
+    p = batch + 2 + batch_count * TLM_PERIOD_LEN;
+    TLM_PUT32(p, Copy_u32Period);
+    TLM_PUT32(p, Copy_u32High);
+    period_index++;
+
+    if (++batch_count == TLM_PERIOD_BATCH &&
+        TLM_u8Queue(TLM_TYPE_PERIODS, batch, sizeof(batch), TLM_PERIODS_RESERVE))
+        batch_count = 0;
+#else
+    (void)Copy_u32Period; (void)Copy_u32High;
+#endif
+}
+
+static u8 *TLM_pu8PutSummary(u8 *Copy_pu8Dst, const STAT_Summary_t *Copy_pSum)
+{
+    TLM_PUT32(Copy_pu8Dst, Copy_pSum->min);
+    TLM_PUT32(Copy_pu8Dst, Copy_pSum->max);
+    TLM_PUT32(Copy_pu8Dst, Copy_pSum->mean);
+    TLM_PUT32(Copy_pu8Dst, Copy_pSum->stddev);
+    return Copy_pu8Dst;
+}
+
+void TLM_voidSendStats(const STAT_Result_t *Copy_pStats)
+{
+#if TLM_STATS_ENABLE
+    u8 payload[TLM_STATS_LEN];
+    u8 *p = payload;
+
+    TLM_PUT16(p, Copy_pStats->count);
+    p = TLM_pu8PutSummary(p, &Copy_pStats->period);
+    p = TLM_pu8PutSummary(p, &Copy_pStats->high);
+    TLM_PUT32(p, Copy_pStats->jitter_pp);
+    TLM_PUT32(p, Copy_pStats->jitter_rms);
+    TLM_PUT32(p, Copy_pStats->jitter_c2c);
+    *p++ = Copy_pStats->clamped ? TLM_STATS_CLAMPED : 0;
+    TLM_voidSend(TLM_TYPE_STATS, payload, TLM_STATS_LEN, 0);
+#else
+    (void)Copy_pStats;
+#endif
+}
+
+#endif /* TLM_ENABLE */
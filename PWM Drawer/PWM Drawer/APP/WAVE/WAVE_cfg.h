@@ -0,0 +1,34 @@
+#ifndef WAVE_CFG_H_
+#define WAVE_CFG_H_
+
+/* WAVE (measured waveform plot) Configuration */
+
+// Plot area rows (pixels): the high level is drawn at the top row, the low
+// level at the bottom row, edges as a vertical line between them
+#define WAVE_Y_TOP     40
+#define WAVE_Y_BOTTOM  63
+
+// Horizontal pixels per time division (128 / 16 = 8 divisions across)
+#define WAVE_PX_PER_DIV 16
+
+// Time per division in us at start-up, from the 1-2-5 sequence (0 = auto:
+// the main loop picks the timebase that shows 2-8 periods of the signal)
+#define WAVE_TIMEBASE_US 0
+
+// Timebases from this many us per division on roll instead of sweep: the
+// trace scrolls in from the right, as a sweep would take seconds to fill
+#define WAVE_ROLL_FROM_US 100000UL
+
+// Acquisition mode at start-up when the ICU trigger is built in
+// (ICU_TRIGGER_ENABLE): WAVE_ACQ_AUTO, WAVE_ACQ_NORMAL or WAVE_ACQ_SINGLE
+#ifndef WAVE_ACQ_MODE
+#define WAVE_ACQ_MODE WAVE_ACQ_AUTO
+#endif
+
+// Column the trigger edge of a captured record is drawn at
+#define WAVE_TRIG_X 32
+
+// Auto mode: display frames without a trigger before the plot free-runs
+#define WAVE_AUTO_FRAMES 10
+
+#endif /* WAVE_CFG_H_ */
@@ -0,0 +1,74 @@
+#ifndef WAVE_INT_H_
+#define WAVE_INT_H_
+
+#include "../../Service/std_types.h"
+#include "../../MCAL/ICU/ICU_interface.h"
+
+/* WAVE (measured waveform plot) Interface
+   Plots the captured edges themselves on a time/div timebase, like a scope
+   sweep: each sweep starts on a rising edge at the left border and fills the
+   columns from left to right as edges arrive, overwriting the previous sweep
+   in place. Only the columns a new segment covers are composed, into the
+   GLCD framebuffer, so a stable signal costs almost no bus traffic and
+   jitter or irregular pulses show up as they happen.
+   A column keeps the level it saw; one that holds an edge (or a pulse
+   shorter than a column) is drawn as a vertical line.
+   Slow timebases (WAVE_ROLL_FROM_US) roll instead: each closed column goes
+   into a 16-byte ring of level bits and the plot scrolls left by moving the
+   ring head, so a scroll step costs O(1) and no byte copying. In roll mode a
+   pulse shorter than a column is not shown.
+   Every edge is also kept in the run-length history (APP/HIST), which can be
+   viewed frozen, panned and zoomed without waiting for new captures.
+   With the ICU trigger (ICU_TRIGGER_ENABLE) the plot can show triggered
+   records instead, the trigger edge at column WAVE_TRIG_X:
+     auto    records while the trigger keeps firing, free-running otherwise
+     normal  only records; the last one stays until the next
+     single  the first record, then frozen until WAVE_voidArm() */
+
+// Acquisition modes (ICU_TRIGGER_ENABLE)
+#define WAVE_ACQ_AUTO    0
+#define WAVE_ACQ_NORMAL  1
+#define WAVE_ACQ_SINGLE  2
+
+// Acquisition status (WAVE_u8AcqStatus)
+#define WAVE_ACQ_LIVE    0     // Free-running plot
+#define WAVE_ACQ_WAIT    1     // Waiting for the trigger (the last record, if any, stays)
+#define WAVE_ACQ_TRIG    2     // Showing a triggered record, re-armed
+#define WAVE_ACQ_STOP    3     // Single shot taken and frozen
+
+// Clear the plot area and arm the first sweep
+void WAVE_voidInit(void);
+
+// Time per division in us (any value, 1-2-5 steps read best); restarts the sweep
+void WAVE_voidSetTimebase(u32 Copy_u32UsPerDiv);
+u32 WAVE_u32GetTimebase(void);
+
+// Pick the 1-2-5 timebase that shows 2-8 periods of the signal
+void WAVE_voidAutoTimebase(u32 Copy_u32PeriodCycles);
+
+// Feed one captured edge, in capture order
+void WAVE_voidAddEdge(const ICU_Edge_t *Copy_pEdge);
+
+// Push the new columns to the display; a finished sweep is re-armed
+void WAVE_voidRefresh(void);
+
+// Freeze the plot and draw the history instead: the right border is
+// Copy_u32PanUs before the newest edge, Copy_u32UsPerDiv sets the zoom.
+// History recording stops until WAVE_voidLive()
+void WAVE_voidView(u32 Copy_u32PanUs, u32 Copy_u32UsPerDiv);
+
+// Back to the live plot; the history starts over
+void WAVE_voidLive(void);
+
+// Change the acquisition mode; re-arms the trigger (ICU_TRIGGER_ENABLE)
+void WAVE_voidSetAcquisition(u8 Copy_u8Mode);
+
+// Single mode: drop the frozen record and wait for the next trigger
+void WAVE_voidArm(void);
+
+u8 WAVE_u8AcqStatus(void);
+
+// Blank the plot (no edges to show, e.g. while the frequency counter runs)
+void WAVE_voidClear(void);
+
+#endif /* WAVE_INT_H_ */
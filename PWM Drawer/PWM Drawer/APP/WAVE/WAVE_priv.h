@@ -0,0 +1,37 @@
+#ifndef WAVE_PRIV_H_
+#define WAVE_PRIV_H_
+
+/* WAVE (measured waveform plot) Private Definitions */
+
+// Plot area in pages
+#define WAVE_FIRST_PAGE  (WAVE_Y_TOP / 8)
+#define WAVE_LAST_PAGE   (WAVE_Y_BOTTOM / 8)
+#define WAVE_PAGES       (WAVE_LAST_PAGE - WAVE_FIRST_PAGE + 1)
+
+// Levels seen inside one column; both = an edge falls in it
+#define WAVE_SEEN_LOW    0x01
+#define WAVE_SEEN_HIGH   0x02
+#define WAVE_SEEN_EDGE   (WAVE_SEEN_LOW | WAVE_SEEN_HIGH)
+
+// Plot mode
+#define WAVE_MODE_SWEEP  0     // Left to right from a rising edge, overwritten in place
+#define WAVE_MODE_ROLL   1     // Newest column at the right, older ones scroll left
+#define WAVE_MODE_VIEW   2     // Frozen, drawn from the edge history (pan / zoom)
+#define WAVE_MODE_HOLD   3     // Frozen on a triggered record (ICU_TRIGGER_ENABLE)
+
+// Sweep state
+#define WAVE_ARMED       0     // Waiting for a rising edge to start at column 0
+#define WAVE_SWEEP       1     // Columns are being filled left to right
+#define WAVE_DONE        2     // Full width drawn, held until WAVE_voidRefresh()
+
+// Roll ring: one level bit per column
+#define WAVE_ROLL_BYTES  (GLCD_WIDTH / 8)
+#define WAVE_ROLL_MASK   (GLCD_WIDTH - 1)
+
+// Source of the runs a frozen plot is drawn from, newest first (age 0): length
+// in cycles, and its level as WAVE_SEEN_HIGH / WAVE_SEEN_LOW (0 = nothing known)
+typedef u32 (*WAVE_RunFn_t)(u8 Copy_u8Age, u8 *Copy_pu8Seen);
+
+#define WAVE_CYCLES_PER_US (F_CPU / 1000000UL)
+
+#endif /* WAVE_PRIV_H_ */
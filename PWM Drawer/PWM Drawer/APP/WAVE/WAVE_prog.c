@@ -0,0 +1,486 @@
+/*
+   Measured waveform plot: captured edges swept (or rolled) onto a time/div
+   timebase, with a frozen history view
+*/
+
+#include "../../Service/std_types.h"
+#include "../../Service/bit_math.h"
+#include "../../MCAL/ICU/ICU_interface.h"
+#include "../../MCAL/ICU/ICU_cfg.h"
+#include "../../HAL/GLCD/GLCD_int.h"
+#include "../../HAL/GFX/GFX_int.h"
+#include "../HIST/HIST_int.h"
+#include "WAVE_cfg.h"
+#include "WAVE_priv.h"
+#include "WAVE_int.h"
+
+#if WAVE_Y_BOTTOM >= GLCD_HEIGHT || WAVE_Y_TOP + 2 > WAVE_Y_BOTTOM
+#error "WAVE plot rows out of range"
+#endif
+
+// Page bytes of one column for each WAVE_SEEN_* combination (0 = blank)
+static u8 col_bytes[4][WAVE_PAGES];
+
+static u32 tdiv_us = 0;          // Time per division
+static u32 cycles_per_px = 1;    // Time per column
+
+static u8  mode = WAVE_MODE_SWEEP;
+static u8  state = WAVE_ARMED;   // Sweep progress (sweep mode)
+static u8  cur_x = 0;            // Column being filled (sweep mode)
+static u8  cur_seen = 0;         // Levels seen in the open column so far
+static u32 cur_pos = 0;          // Cycles of it already covered
+
+static u8  level = 0;            // Signal level since the last edge
+static u32 last_ts = 0;          // Timestamp of the last edge (timer ticks)
+static u8  ts_valid = 0;         // last_ts and level can be trusted
+
+// Roll ring: bit n of the ring = level of a closed column, head = next to write
+static u8 roll_bits[WAVE_ROLL_BYTES];
+static u8 roll_head = 0;
+static u8 roll_fill = 0;         // Columns holding data (the rest is drawn blank)
+static u8 roll_new = 0;          // Columns pushed since the last refresh
+
+#if ICU_TRIGGER_ENABLE
+static u8  acq_mode = WAVE_ACQ_MODE;
+static u8  acq_status = WAVE_ACQ_LIVE;
+static u8  acq_idle = 0;         // Frames since the last record (auto mode)
+
+// Record being drawn (WAVE_u32CaptureRun)
+static const ICU_Edge_t *cap_edges;
+static u8  cap_count = 0;
+static u32 cap_tail = 0;         // Blank time from the newest edge to the right border
+#endif
+
+/* Compose a column into the framebuffer (bytes that do not change stay clean) */
+static void WAVE_voidPutColumn(u8 Copy_u8X, u8 Copy_u8Seen)
+{
+    for (u8 p = 0; p < WAVE_PAGES; p++)
+        GLCD_voidFbWriteByte(WAVE_FIRST_PAGE + p, Copy_u8X, col_bytes[Copy_u8Seen][p]);
+}
+
+static void WAVE_voidRowBits(u8 Copy_u8Seen, u8 Copy_u8From, u8 Copy_u8To)
+{
+    for (u8 p = 0; p < WAVE_PAGES; p++)
+        col_bytes[Copy_u8Seen][p] |= GFX_u8PageMask(WAVE_FIRST_PAGE + p, Copy_u8From, Copy_u8To);
+}
+
+static u8 WAVE_u8RollBit(u8 Copy_u8Index)
+{
+    Copy_u8Index &= WAVE_ROLL_MASK;
+    return (roll_bits[Copy_u8Index >> 3] >> (Copy_u8Index & 7)) & 1;
+}
+
+/* A column is complete: draw it (sweep) or push its end level into the ring (roll) */
+static void WAVE_voidCloseColumn(u8 Copy_u8Seen)
+{
+    if (mode == WAVE_MODE_SWEEP)
+    {
+        WAVE_voidPutColumn(cur_x, Copy_u8Seen);
+        if (++cur_x >= GLCD_WIDTH)
+            state = WAVE_DONE;
+        return;
+    }
+
+    // Scrolling is the head moving on: nothing is copied
+    if (level)
+        SET_BIT(roll_bits[roll_head >> 3], (roll_head & 7));
+    else
+        CLR_BIT(roll_bits[roll_head >> 3], (roll_head & 7));
+    roll_head = (roll_head + 1) & WAVE_ROLL_MASK;
+    if (roll_fill < GLCD_WIDTH) roll_fill++;
+    roll_new = 1;
+}
+
+/* The current level lasted Copy_u32Cycles more: close every column it
+   crossed, the last one it reaches stays open */
+static void WAVE_voidAdvance(u32 Copy_u32Cycles)
+{
+    u8 seen = level ? WAVE_SEEN_HIGH : WAVE_SEEN_LOW;
+    u32 steps;
+
+    cur_seen |= seen;
+
+    // Short segment inside the open column: no division needed
+    if (Copy_u32Cycles < cycles_per_px - cur_pos)
+    {
+        cur_pos += Copy_u32Cycles;
+        return;
+    }
+
+    steps = Copy_u32Cycles / cycles_per_px;
+    cur_pos += Copy_u32Cycles % cycles_per_px;
+    if (cur_pos >= cycles_per_px)
+    {
+        cur_pos -= cycles_per_px;
+        steps++;
+    }
+
+    // More than a screen of one level looks the same as exactly a screen
+    if (steps > GLCD_WIDTH)
+        steps = GLCD_WIDTH;
+
+    WAVE_voidCloseColumn(cur_seen);
+    while (--steps > 0 && state != WAVE_DONE)
+        WAVE_voidCloseColumn(seen);
+    cur_seen = seen;
+}
+
+/* Plot of the ring, oldest column at the left; an edge shows where the level changes */
+static void WAVE_voidDrawRoll(void)
+{
+    u8 blank = GLCD_WIDTH - roll_fill;
+    u8 index = roll_head - roll_fill;     // Oldest column held
+
+    for (u8 x = 0; x < GLCD_WIDTH; x++)
+    {
+        if (x < blank)
+        {
+            WAVE_voidPutColumn(x, 0);
+            continue;
+        }
+
+        u8 bit = WAVE_u8RollBit(index);
+        u8 seen = bit ? WAVE_SEEN_HIGH : WAVE_SEEN_LOW;
+        if (x > blank && WAVE_u8RollBit(index - 1) != bit)
+            seen = WAVE_SEEN_EDGE;
+        WAVE_voidPutColumn(x, seen);
+        index++;
+    }
+}
+
+/* Plot Copy_u8Runs runs right to left, starting Copy_u32Pan cycles before
+   the end of the newest; runs meeting inside a column make it an edge column */
+static void WAVE_voidDrawRuns(u8 Copy_u8Runs, WAVE_RunFn_t Copy_pfRun, u32 Copy_u32Pan,
+                              u32 Copy_u32CyclesPerPx)
+{
+    s16 x = GLCD_WIDTH - 1;
+    u32 pos = 0;                // Cycles of column x already covered
+    u8 seen = 0;
+
+    for (u8 age = 0; age < Copy_u8Runs && x >= 0; age++)
+    {
+        u8 bit;
+        u32 len = Copy_pfRun(age, &bit);
+
+        if (Copy_u32Pan >= len)
+        {
+            Copy_u32Pan -= len;
+            continue;
+        }
+        len -= Copy_u32Pan;
+        Copy_u32Pan = 0;
+
+        // A run ending exactly on a column border leaves the column open, so
+        // the next (older) run still marks the edge in it
+        seen |= bit;
+        while (x >= 0 && len > Copy_u32CyclesPerPx - pos)
+        {
+            len -= Copy_u32CyclesPerPx - pos;
+            pos = 0;
+            WAVE_voidPutColumn((u8)x, seen);
+            x--;
+            seen = bit;
+        }
+        pos += len;
+    }
+
+    // The oldest partial column, then nothing recorded
+    if (x >= 0 && seen != 0)
+        WAVE_voidPutColumn((u8)x--, seen);
+    while (x >= 0)
+        WAVE_voidPutColumn((u8)x--, 0);
+}
+
+static u32 WAVE_u32HistoryRun(u8 Copy_u8Age, u8 *Copy_pu8Seen)
+{
+    u8 run_level;
+    u32 len = HIST_u32GetRun(Copy_u8Age, &run_level);
+
+    *Copy_pu8Seen = run_level ? WAVE_SEEN_HIGH : WAVE_SEEN_LOW;
+    return len;
+}
+
+#if ICU_TRIGGER_ENABLE
+/* Runs of the record between its edges, after the blank tail if there is one */
+static u32 WAVE_u32CaptureRun(u8 Copy_u8Age, u8 *Copy_pu8Seen)
+{
+    const ICU_Edge_t *edge;
+
+    if (cap_tail != 0)
+    {
+        if (Copy_u8Age == 0)
+        {
+            *Copy_pu8Seen = 0;
+            return cap_tail;
+        }
+        Copy_u8Age--;
+    }
+    edge = &cap_edges[cap_count - 2 - Copy_u8Age];
+    *Copy_pu8Seen = (edge->flags & ICU_FLAG_RISING) ? WAVE_SEEN_HIGH : WAVE_SEEN_LOW;
+    return ICU_u32TicksToCycles(edge[1].timestamp - edge->timestamp, edge->flags);
+}
+
+/* Draw a record with its trigger edge at the left border of column WAVE_TRIG_X */
+static void WAVE_voidDrawCapture(const ICU_Edge_t *Copy_pEdges, u8 Copy_u8Count, u8 Copy_u8Trigger)
+{
+    u32 right = (u32)(GLCD_WIDTH - WAVE_TRIG_X) * cycles_per_px;
+    u32 after = ICU_u32TicksToCycles(Copy_pEdges[Copy_u8Count - 1].timestamp -
+                                     Copy_pEdges[Copy_u8Trigger].timestamp, Copy_pEdges[Copy_u8Trigger].flags);
+
+    cap_edges = Copy_pEdges;
+    cap_count = Copy_u8Count;
+    cap_tail = (after < right) ? right - after : 0;
+    WAVE_voidDrawRuns(Copy_u8Count - 1 + (cap_tail != 0), WAVE_u32CaptureRun,
+                      (after > right) ? after - right : 0, cycles_per_px);
+}
+
+/* Trigger side of a refresh: draw a new record if there is one. Returns 1
+   while the plot belongs to records rather than to the live trace */
+static u8 WAVE_u8Acquire(void)
+{
+    ICU_Edge_t rec[ICU_ACQ_SIZE];
+    u8 trigger;
+    u8 count = ICU_u8ReadCapture(rec, &trigger);
+
+    if (count != 0)
+    {
+        mode = WAVE_MODE_HOLD;
+        WAVE_voidDrawCapture(rec, count, trigger);
+        acq_idle = 0;
+        if (acq_mode == WAVE_ACQ_SINGLE)
+        {
+            acq_status = WAVE_ACQ_STOP;
+        }
+        else
+        {
+            acq_status = WAVE_ACQ_TRIG;
+            ICU_voidArm();
+        }
+        return 1;
+    }
+
+    if (acq_mode != WAVE_ACQ_AUTO)
+        return 1;
+    if (acq_status != WAVE_ACQ_TRIG)
+        return 0;
+    if (++acq_idle < WAVE_AUTO_FRAMES)
+        return 1;
+
+    // No trigger for a while: free-run so the signal stays visible
+    acq_status = WAVE_ACQ_LIVE;
+    WAVE_voidLive();
+    return 0;
+}
+#endif
+
+void WAVE_voidInit(void)
+{
+    for (u8 s = 0; s < 4; s++)
+        for (u8 p = 0; p < WAVE_PAGES; p++)
+            col_bytes[s][p] = 0;
+
+    // 2 pixel thick level lines, full height edges
+    WAVE_voidRowBits(WAVE_SEEN_HIGH, WAVE_Y_TOP, WAVE_Y_TOP + 1);
+    WAVE_voidRowBits(WAVE_SEEN_LOW, WAVE_Y_BOTTOM - 1, WAVE_Y_BOTTOM);
+    WAVE_voidRowBits(WAVE_SEEN_EDGE, WAVE_Y_TOP, WAVE_Y_BOTTOM);
+
+    WAVE_voidSetTimebase(WAVE_TIMEBASE_US ? WAVE_TIMEBASE_US : 1000);
+    WAVE_voidClear();
+#if ICU_TRIGGER_ENABLE
+    WAVE_voidSetAcquisition(WAVE_ACQ_MODE);
+#endif
+}
+
+void WAVE_voidSetTimebase(u32 Copy_u32UsPerDiv)
+{
+    tdiv_us = Copy_u32UsPerDiv;
+    cycles_per_px = Copy_u32UsPerDiv * WAVE_CYCLES_PER_US / WAVE_PX_PER_DIV;
+    if (cycles_per_px == 0)
+        cycles_per_px = 1;
+
+    // Frozen plots keep what they show, the next record uses the new timebase
+    if (mode == WAVE_MODE_VIEW || mode == WAVE_MODE_HOLD)
+        return;
+
+    // Columns already drawn belong to the old timebase: start over
+    mode = (Copy_u32UsPerDiv >= WAVE_ROLL_FROM_US) ? WAVE_MODE_ROLL : WAVE_MODE_SWEEP;
+    state = WAVE_ARMED;
+    roll_fill = 0;
+    roll_new = 1;
+    cur_seen = 0;
+    cur_pos = 0;
+}
+
+u32 WAVE_u32GetTimebase(void)
+{
+    return tdiv_us;
+}
+
+/* Keep the timebase while the screen (8 divisions) holds 2-8 periods, else
+   take the smallest 1-2-5 step holding no more than 8 */
+void WAVE_voidAutoTimebase(u32 Copy_u32PeriodCycles)
+{
+    u32 period_us = Copy_u32PeriodCycles / WAVE_CYCLES_PER_US;
+    u32 step = 1;
+
+    if (tdiv_us * 4 >= period_us && tdiv_us <= period_us)
+        return;
+
+    while (step * 4 < period_us)
+    {
+        // 1 -> 2 -> 5 -> 10 ...
+        u32 decade = step;
+        while (decade >= 10) decade /= 10;
+        step = (decade == 2) ? step / 2 * 5 : step * 2;
+    }
+
+    if (step != tdiv_us)
+        WAVE_voidSetTimebase(step);
+}
+
+void WAVE_voidAddEdge(const ICU_Edge_t *Copy_pEdge)
+{
+    u8 rising = (Copy_pEdge->flags & ICU_FLAG_RISING) ? 1 : 0;
+
+    if (mode == WAVE_MODE_VIEW || mode == WAVE_MODE_HOLD)
+        return;
+
+    // Edges were lost or the timer clock changed: the time since the last one is unknown
+    if (Copy_pEdge->flags & ICU_FLAG_GAP)
+    {
+        ts_valid = 0;
+        HIST_voidClear();
+        if (state == WAVE_SWEEP)
+            state = WAVE_ARMED;
+    }
+
+    if (ts_valid)
+    {
+        u32 cycles = ICU_u32TicksToCycles(Copy_pEdge->timestamp - last_ts, Copy_pEdge->flags);
+
+        HIST_voidAddRun(cycles, level);
+        if (mode == WAVE_MODE_ROLL || state == WAVE_SWEEP)
+            WAVE_voidAdvance(cycles);
+    }
+    else if (mode == WAVE_MODE_ROLL)
+    {
+        // No known time to the previous edge: the roll restarts from here
+        roll_fill = 0;
+        roll_new = 1;
+        cur_seen = 0;
+        cur_pos = 0;
+    }
+    last_ts = Copy_pEdge->timestamp;
+    ts_valid = 1;
+    level = rising;
+
+    if (mode == WAVE_MODE_SWEEP && state == WAVE_ARMED)
+    {
+        if (!rising) return;
+
+        // Rising edge at the left border, so successive sweeps line up
+        state = WAVE_SWEEP;
+        cur_x = 0;
+        cur_pos = 0;
+        cur_seen = WAVE_SEEN_LOW;
+    }
+
+    if (mode == WAVE_MODE_ROLL || state == WAVE_SWEEP)
+        cur_seen |= rising ? WAVE_SEEN_HIGH : WAVE_SEEN_LOW;
+}
+
+void WAVE_voidRefresh(void)
+{
+#if ICU_TRIGGER_ENABLE
+    if (mode != WAVE_MODE_VIEW && WAVE_u8Acquire())
+    {
+        GLCD_voidFlush();
+        return;
+    }
+#endif
+
+    if (mode == WAVE_MODE_SWEEP)
+    {
+        // The open column too, so slow signals grow on screen edge by edge
+        if (state == WAVE_SWEEP)
+            WAVE_voidPutColumn(cur_x, cur_seen);
+    }
+    else if (mode == WAVE_MODE_ROLL && roll_new)
+    {
+        WAVE_voidDrawRoll();
+        roll_new = 0;
+    }
+
+    GLCD_voidFlush();
+
+    if (state == WAVE_DONE)
+        state = WAVE_ARMED;
+}
+
+void WAVE_voidView(u32 Copy_u32PanUs, u32 Copy_u32UsPerDiv)
+{
+    u32 cpp = Copy_u32UsPerDiv * WAVE_CYCLES_PER_US / WAVE_PX_PER_DIV;
+
+    mode = WAVE_MODE_VIEW;
+    WAVE_voidDrawRuns(HIST_u8Count(), WAVE_u32HistoryRun, Copy_u32PanUs * WAVE_CYCLES_PER_US, cpp ? cpp : 1);
+    GLCD_voidFlush();
+}
+
+void WAVE_voidLive(void)
+{
+    mode = WAVE_MODE_SWEEP;
+    ts_valid = 0;
+    HIST_voidClear();
+    WAVE_voidSetTimebase(tdiv_us);
+    WAVE_voidClear();
+}
+
+void WAVE_voidClear(void)
+{
+    GLCD_voidFbClearPages(WAVE_FIRST_PAGE, WAVE_LAST_PAGE);
+    GLCD_voidFlush();
+    state = WAVE_ARMED;
+    roll_fill = 0;
+}
+
+void WAVE_voidSetAcquisition(u8 Copy_u8Mode)
+{
+#if ICU_TRIGGER_ENABLE
+    acq_mode = Copy_u8Mode;
+    acq_idle = 0;
+    ICU_voidArm();
+    if (Copy_u8Mode == WAVE_ACQ_AUTO)
+    {
+        acq_status = WAVE_ACQ_LIVE;
+        if (mode == WAVE_MODE_HOLD)
+            WAVE_voidLive();
+        return;
+    }
+
+    // Nothing on the plot until the trigger fires
+    acq_status = WAVE_ACQ_WAIT;
+    mode = WAVE_MODE_HOLD;
+    WAVE_voidClear();
+#else
+    (void)Copy_u8Mode;
+#endif
+}
+
+/* The frozen record stays on the plot until the next one replaces it */
+void WAVE_voidArm(void)
+{
+#if ICU_TRIGGER_ENABLE
+    ICU_voidArm();
+    if (acq_status == WAVE_ACQ_STOP)
+        acq_status = WAVE_ACQ_WAIT;
+#endif
+}
+
+u8 WAVE_u8AcqStatus(void)
+{
+#if ICU_TRIGGER_ENABLE
+    return acq_status;
+#else
+    return WAVE_ACQ_LIVE;
+#endif
+}
@@ -0,0 +1,14 @@
+#ifndef FONT_CFG_H_
+#define FONT_CFG_H_
+
+/* FONT (bitmap fonts) Configuration */
+
+// 1: main.c shows the frequency in FONT_10x16 on screen pages 0-1 with its
+// unit beside it, duty and period share page 2 ("D=30.0% T=1.000ms").
+// Needs the four-line status area: not with STAT_PAGE_ENABLE, EXTI_ENABLE
+// or STRIP_ENABLE
+#ifndef FONT_BIG_FREQ_ENABLE
+#define FONT_BIG_FREQ_ENABLE 0
+#endif
+
+#endif /* FONT_CFG_H_ */
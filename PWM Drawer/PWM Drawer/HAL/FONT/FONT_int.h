@@ -0,0 +1,43 @@
+#ifndef FONT_INT_H_
+#define FONT_INT_H_
+
+#include "../../Service/std_types.h"
+
+/* FONT (bitmap fonts) Interface
+   Fonts live in program memory, descriptor and glyphs alike: pass the
+   descriptor's flash address (&FONT_5x7) to the renderers, which take a
+   RAM copy with FONT_voidLoad() and read glyph bytes with pgm_read_byte. */
+
+// Font descriptor. Glyphs first..last are stored back to back, each as
+// `pages` rows of `width` column bytes (bit 0 = top pixel of the page)
+typedef struct
+{
+    const u8 *glyphs;  // Flash address of the first glyph
+    u8 first;          // First character code
+    u8 last;           // Last character code
+    u8 width;          // Glyph columns
+    u8 pages;          // Glyph height in 8-pixel pages
+    u8 spacing;        // Blank columns after every glyph
+} FONT_t;
+
+// Widest glyph plus spacing of any font here (column buffers)
+#define FONT_MAX_ADVANCE 12
+
+// 5x7, printable ASCII 32-126, one page, 6 columns per character
+extern const FONT_t FONT_5x7;
+
+// 10x16 digits for large readouts: '-', '.', '/', '0'-'9' on two pages,
+// 12 columns per character; anything else draws as a blank
+extern const FONT_t FONT_10x16;
+
+// Copy a descriptor out of flash
+void FONT_voidLoad(const FONT_t *Copy_pFont, FONT_t *Copy_pDesc);
+
+// 1 if the (loaded) font has a glyph for the character
+u8 FONT_u8Has(const FONT_t *Copy_pDesc, char Copy_cChar);
+
+// Columns of one glyph page plus its spacing into Copy_pu8Cols (a blank
+// cell for characters the font lacks); returns the column count
+u8 FONT_u8Columns(const FONT_t *Copy_pDesc, char Copy_cChar, u8 Copy_u8Page, u8 *Copy_pu8Cols);
+
+#endif /* FONT_INT_H_ */
@@ -0,0 +1,104 @@
+/*
+   Bitmap fonts, kept in program memory (nothing is copied to SRAM)
+*/
+
+#include <avr/pgmspace.h>
+#include "../../Service/std_types.h"
+#include "FONT_int.h"
+
+/* 5x7 font - printable ASCII from space (32) to tilde (126), 5 columns each */
+static const u8 font5x7[] PROGMEM = {
+    0x00,0x00,0x00,0x00,0x00, 0x00,0x00,0x5F,0x00,0x00, 0x00,0x07,0x00,0x07,0x00,
+    0x14,0x7F,0x14,0x7F,0x14, 0x24,0x2A,0x7F,0x2A,0x12, 0x23,0x13,0x08,0x64,0x62,
+    0x36,0x49,0x55,0x22,0x50, 0x00,0x05,0x03,0x00,0x00, 0x00,0x1C,0x22,0x41,0x00,
+    0x00,0x41,0x22,0x1C,0x00, 0x14,0x08,0x3E,0x08,0x14, 0x08,0x08,0x3E,0x08,0x08,
+    0x00,0x50,0x30,0x00,0x00, 0x08,0x08,0x08,0x08,0x08, 0x00,0x60,0x60,0x00,0x00,
+    0x20,0x10,0x08,0x04,0x02, 0x3E,0x51,0x49,0x45,0x3E, 0x00,0x42,0x7F,0x40,0x00,
+    0x42,0x61,0x51,0x49,0x46, 0x21,0x41,0x45,0x4B,0x31, 0x18,0x14,0x12,0x7F,0x10,
+    0x27,0x45,0x45,0x45,0x39, 0x3C,0x4A,0x49,0x49,0x30, 0x01,0x71,0x09,0x05,0x03,
+    0x36,0x49,0x49,0x49,0x36, 0x06,0x49,0x49,0x29,0x1E, 0x00,0x36,0x36,0x00,0x00,
+    0x00,0x56,0x36,0x00,0x00, 0x08,0x14,0x22,0x41,0x00, 0x14,0x14,0x14,0x14,0x14,
+    0x00,0x41,0x22,0x14,0x08, 0x02,0x01,0x51,0x09,0x06, 0x32,0x49,0x79,0x41,0x3E,
+    0x7E,0x11,0x11,0x11,0x7E, 0x7F,0x49,0x49,0x49,0x36, 0x3E,0x41,0x41,0x41,0x22,
+    0x7F,0x41,0x41,0x22,0x1C, 0x7F,0x49,0x49,0x49,0x41, 0x7F,0x09,0x09,0x09,0x01,
+    0x3E,0x41,0x49,0x49,0x7A, 0x7F,0x08,0x08,0x08,0x7F, 0x00,0x41,0x7F,0x41,0x00,
+    0x20,0x40,0x41,0x3F,0x01, 0x7F,0x08,0x14,0x22,0x41, 0x7F,0x40,0x40,0x40,0x40,
+    0x7F,0x02,0x0C,0x02,0x7F, 0x7F,0x04,0x08,0x10,0x7F, 0x3E,0x41,0x41,0x41,0x3E,
+    0x7F,0x09,0x09,0x09,0x06, 0x3E,0x41,0x51,0x21,0x5E, 0x7F,0x09,0x19,0x29,0x46,
+    0x26,0x49,0x49,0x49,0x32, 0x01,0x01,0x7F,0x01,0x01, 0x3F,0x40,0x40,0x40,0x3F,
+    0x1F,0x20,0x40,0x20,0x1F, 0x7F,0x20,0x18,0x20,0x7F, 0x63,0x14,0x08,0x14,0x63,
+    0x07,0x08,0x70,0x08,0x07, 0x61,0x51,0x49,0x45,0x43, 0x00,0x7F,0x41,0x41,0x00,
+    0x02,0x04,0x08,0x10,0x20, 0x00,0x41,0x41,0x7F,0x00, 0x04,0x02,0x01,0x02,0x04,
+    0x40,0x40,0x40,0x40,0x40, 0x00,0x01,0x02,0x04,0x00, 0x20,0x54,0x54,0x54,0x78,
+    0x7F,0x48,0x44,0x44,0x38, 0x38,0x44,0x44,0x44,0x20, 0x38,0x44,0x44,0x48,0x7F,
+    0x38,0x54,0x54,0x54,0x18, 0x08,0x7E,0x09,0x01,0x02, 0x0C,0x52,0x52,0x52,0x3E,
+    0x7F,0x08,0x04,0x04,0x78, 0x00,0x44,0x7D,0x40,0x00, 0x20,0x40,0x44,0x3D,0x00,
+    0x7F,0x10,0x28,0x44,0x00, 0x00,0x41,0x7F,0x40,0x00, 0x7C,0x04,0x18,0x04,0x78,
+    0x7C,0x08,0x04,0x04,0x78, 0x38,0x44,0x44,0x44,0x38, 0x7C,0x14,0x14,0x14,0x08,
+    0x08,0x14,0x14,0x18,0x7C, 0x7C,0x08,0x04,0x04,0x08, 0x48,0x54,0x54,0x54,0x20,
+    0x04,0x3F,0x44,0x40,0x20, 0x3C,0x40,0x40,0x20,0x7C, 0x1C,0x20,0x40,0x20,0x1C,
+    0x3C,0x40,0x30,0x40,0x3C, 0x44,0x28,0x10,0x28,0x44, 0x0C,0x50,0x50,0x50,0x3C,
+    0x44,0x64,0x54,0x4C,0x44, 0x00,0x08,0x36,0x41,0x00, 0x00,0x00,0x7F,0x00,0x00,
+    0x00,0x41,0x36,0x08,0x00, 0x08,0x04,0x08,0x10,0x08,
+};
+
+/* 10x16 digits - '-' (45) to '9' (57), page 0 columns then page 1 columns;
+   ink on rows 1-14 so the baseline matches 5x7 text on the lower page */
+static const u8 font10x16[] PROGMEM = {
+    /* '-' */ 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00,
+             0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    /* '.' */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x00, 0x00, 0x00, 0x70, 0x70, 0x70, 0x00, 0x00, 0x00,
+    /* '/' */ 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xF0, 0x7C, 0x1E, 0x06,
+             0x00, 0x40, 0x70, 0x7C, 0x1F, 0x07, 0x01, 0x00, 0x00, 0x00,
+    /* '0' */ 0xF8, 0xFC, 0x0E, 0x06, 0x06, 0x06, 0x06, 0x0E, 0xFC, 0xF8,
+             0x1F, 0x3F, 0x70, 0x60, 0x60, 0x60, 0x60, 0x70, 0x3F, 0x1F,
+    /* '1' */ 0x00, 0x10, 0x18, 0x0C, 0xFE, 0xFE, 0x00, 0x00, 0x00, 0x00,
+             0x00, 0x60, 0x60, 0x60, 0x7F, 0x7F, 0x60, 0x60, 0x60, 0x00,
+    /* '2' */ 0x18, 0x1C, 0x0E, 0x06, 0x06, 0x86, 0x86, 0xCE, 0xFC, 0x78,
+             0x78, 0x7C, 0x66, 0x63, 0x63, 0x61, 0x61, 0x60, 0x60, 0x60,
+    /* '3' */ 0x04, 0x06, 0x06, 0x86, 0x86, 0x86, 0x86, 0xCE, 0xFC, 0x78,
+             0x20, 0x60, 0x60, 0x61, 0x61, 0x61, 0x61, 0x73, 0x3F, 0x1E,
+    /* '4' */ 0xC0, 0xE0, 0x30, 0x18, 0x0C, 0x06, 0xFE, 0xFE, 0x00, 0x00,
+             0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x7F, 0x7F, 0x03, 0x03,
+    /* '5' */ 0xFE, 0xFE, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0x86, 0x06,
+             0x30, 0x70, 0x60, 0x60, 0x60, 0x60, 0x60, 0x71, 0x3F, 0x1F,
+    /* '6' */ 0xF0, 0xFC, 0x9C, 0xCE, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0x80,
+             0x1F, 0x3F, 0x71, 0x60, 0x60, 0x60, 0x60, 0x71, 0x3F, 0x1F,
+    /* '7' */ 0x06, 0x06, 0x06, 0x06, 0x06, 0x86, 0xE6, 0xF6, 0x3E, 0x1E,
+             0x00, 0x00, 0x00, 0x78, 0x7E, 0x0F, 0x03, 0x00, 0x00, 0x00,
+    /* '8' */ 0x38, 0xFC, 0xEE, 0xC6, 0xC6, 0xC6, 0xC6, 0xEE, 0xFC, 0x38,
+             0x1F, 0x3F, 0x71, 0x60, 0x60, 0x60, 0x60, 0x71, 0x3F, 0x1F,
+    /* '9' */ 0xF8, 0xFC, 0x8E, 0x06, 0x06, 0x06, 0x06, 0x8E, 0xFC, 0xF8,
+             0x00, 0x61, 0x63, 0x63, 0x63, 0x63, 0x73, 0x3B, 0x1F, 0x0F,
+};
+
+const FONT_t FONT_5x7 PROGMEM = { font5x7, 32, 126, 5, 1, 1 };
+const FONT_t FONT_10x16 PROGMEM = { font10x16, '-', '9', 10, 2, 2 };
+
+void FONT_voidLoad(const FONT_t *Copy_pFont, FONT_t *Copy_pDesc)
+{
+    memcpy_P(Copy_pDesc, Copy_pFont, sizeof(FONT_t));
+}
+
+u8 FONT_u8Has(const FONT_t *Copy_pDesc, char Copy_cChar)
+{
+    return (u8)Copy_cChar >= Copy_pDesc->first && (u8)Copy_cChar <= Copy_pDesc->last;
+}
+
+u8 FONT_u8Columns(const FONT_t *Copy_pDesc, char Copy_cChar, u8 Copy_u8Page, u8 *Copy_pu8Cols)
+{
+    u8 width = Copy_pDesc->width;
+    u8 i = 0;
+
+    if (FONT_u8Has(Copy_pDesc, Copy_cChar) && Copy_u8Page < Copy_pDesc->pages)
+    {
+        const u8 *src = Copy_pDesc->glyphs +
+                        ((u16)((u8)Copy_cChar - Copy_pDesc->first) * Copy_pDesc->pages + Copy_u8Page) * width;
+        for (; i < width; i++)
+            Copy_pu8Cols[i] = pgm_read_byte(src + i);
+    }
+    for (; i < width + Copy_pDesc->spacing; i++)
+        Copy_pu8Cols[i] = 0x00;
+    return i;
+}
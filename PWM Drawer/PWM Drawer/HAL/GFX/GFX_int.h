@@ -0,0 +1,34 @@
+#ifndef GFX_INT_H_
+#define GFX_INT_H_
+
+#include "../../Service/std_types.h"
+
+/* GFX (graphics primitives) Interface
+   Drawing on the GLCD framebuffer by whole page bytes: a vertical span
+   costs one masked byte per page it touches instead of one read-modify-
+   write per pixel. Coordinates are pixels (x: 0-127, y: 0-63), ends
+   inclusive and in any order; anything off the screen is clipped.
+   Nothing reaches the display until GLCD_voidFlush(). */
+
+// Pixel operation
+#define GFX_CLEAR   0
+#define GFX_SET     1
+#define GFX_INVERT  2
+
+// Bits of page Copy_u8Page covered by rows Copy_u8Y0..Copy_u8Y1 (Y0 <= Y1)
+u8 GFX_u8PageMask(u8 Copy_u8Page, u8 Copy_u8Y0, u8 Copy_u8Y1);
+
+// Horizontal span on row y, columns x0..x1
+void GFX_voidHLine(u8 Copy_u8X0, u8 Copy_u8X1, u8 Copy_u8Y, u8 Copy_u8Op);
+
+// Vertical span in column x, rows y0..y1
+void GFX_voidVLine(u8 Copy_u8X, u8 Copy_u8Y0, u8 Copy_u8Y1, u8 Copy_u8Op);
+
+// Bresenham line, drawn as one vertical span per column
+void GFX_voidLine(u8 Copy_u8X0, u8 Copy_u8Y0, u8 Copy_u8X1, u8 Copy_u8Y1, u8 Copy_u8Op);
+
+// Rectangle outline / filled rectangle between two corners
+void GFX_voidRect(u8 Copy_u8X0, u8 Copy_u8Y0, u8 Copy_u8X1, u8 Copy_u8Y1, u8 Copy_u8Op);
+void GFX_voidFillRect(u8 Copy_u8X0, u8 Copy_u8Y0, u8 Copy_u8X1, u8 Copy_u8Y1, u8 Copy_u8Op);
+
+#endif /* GFX_INT_H_ */
@@ -0,0 +1,8 @@
+#ifndef GFX_PRIV_H_
+#define GFX_PRIV_H_
+
+/* GFX (graphics primitives) Private Definitions */
+
+#define GFX_SWAP(a, b)  do { u8 t_ = (a); (a) = (b); (b) = t_; } while (0)
+
+#endif /* GFX_PRIV_H_ */
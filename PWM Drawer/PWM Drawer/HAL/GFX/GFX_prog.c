@@ -0,0 +1,151 @@
+/*
+   Graphics primitives on the GLCD framebuffer, written a page byte at a time
+*/
+
+#include "../../Service/std_types.h"
+#include "../GLCD/GLCD_int.h"
+#include "../GLCD/GLCD_cfg.h"
+#include "../GLCD/GLCD_geo.h"
+#include "GFX_priv.h"
+#include "GFX_int.h"
+
+#if !GLCD_FRAMEBUFFER_ENABLE
+#error "GFX draws into the GLCD framebuffer (GLCD_FRAMEBUFFER_ENABLE)"
+#endif
+
+/* Apply an operation to the masked bits of one page byte */
+static void GFX_voidPutBits(u8 Copy_u8Page, u8 Copy_u8X, u8 Copy_u8Mask, u8 Copy_u8Op)
+{
+    u8 data;
+
+    if (Copy_u8Op == GFX_SET && Copy_u8Mask == 0xFF)
+    {
+        // Whole byte: no need to read it back
+        GLCD_voidFbWriteByte(Copy_u8Page, Copy_u8X, 0xFF);
+        return;
+    }
+    if (Copy_u8Op == GFX_CLEAR && Copy_u8Mask == 0xFF)
+    {
+        GLCD_voidFbWriteByte(Copy_u8Page, Copy_u8X, 0x00);
+        return;
+    }
+
+    data = GLCD_u8FbReadByte(Copy_u8Page, Copy_u8X);
+    if (Copy_u8Op == GFX_SET)
+        data |= Copy_u8Mask;
+    else if (Copy_u8Op == GFX_CLEAR)
+        data &= ~Copy_u8Mask;
+    else
+        data ^= Copy_u8Mask;
+    GLCD_voidFbWriteByte(Copy_u8Page, Copy_u8X, data);
+}
+
+u8 GFX_u8PageMask(u8 Copy_u8Page, u8 Copy_u8Y0, u8 Copy_u8Y1)
+{
+    u8 top = Copy_u8Page * 8;
+
+    if (Copy_u8Y1 < top || Copy_u8Y0 > top + 7)
+        return 0;
+    // Clip the rows to this page, the bits are a table load
+    return GLCD_GEO_SPAN((Copy_u8Y0 > top) ? Copy_u8Y0 - top : 0,
+                         (Copy_u8Y1 < top + 7) ? Copy_u8Y1 - top : 7);
+}
+
+void GFX_voidVLine(u8 Copy_u8X, u8 Copy_u8Y0, u8 Copy_u8Y1, u8 Copy_u8Op)
+{
+    if (Copy_u8Y0 > Copy_u8Y1) GFX_SWAP(Copy_u8Y0, Copy_u8Y1);
+    if (Copy_u8X >= GLCD_WIDTH || Copy_u8Y0 >= GLCD_HEIGHT) return;
+    if (Copy_u8Y1 >= GLCD_HEIGHT) Copy_u8Y1 = GLCD_HEIGHT - 1;
+
+    // First and last page take a partial mask, the ones between a full byte
+    for (u8 page = Copy_u8Y0 / 8; page <= Copy_u8Y1 / 8; page++)
+        GFX_voidPutBits(page, Copy_u8X, GFX_u8PageMask(page, Copy_u8Y0, Copy_u8Y1), Copy_u8Op);
+}
+
+void GFX_voidHLine(u8 Copy_u8X0, u8 Copy_u8X1, u8 Copy_u8Y, u8 Copy_u8Op)
+{
+    if (Copy_u8X0 > Copy_u8X1) GFX_SWAP(Copy_u8X0, Copy_u8X1);
+    if (Copy_u8Y >= GLCD_HEIGHT || Copy_u8X0 >= GLCD_WIDTH) return;
+    if (Copy_u8X1 >= GLCD_WIDTH) Copy_u8X1 = GLCD_WIDTH - 1;
+
+    u8 page = Copy_u8Y / 8;
+    u8 mask = GLCD_GEO_MASK(Copy_u8Y);
+    for (u8 x = Copy_u8X0; ; x++)
+    {
+        GFX_voidPutBits(page, x, mask, Copy_u8Op);
+        if (x == Copy_u8X1) break;
+    }
+}
+
+/* Bresenham, stepping x left to right. The rows a steep line covers in one
+   column are gathered and written as a single vertical span, so each column
+   costs one byte per page touched whatever the slope */
+void GFX_voidLine(u8 Copy_u8X0, u8 Copy_u8Y0, u8 Copy_u8X1, u8 Copy_u8Y1, u8 Copy_u8Op)
+{
+    if (Copy_u8X0 > Copy_u8X1)
+    {
+        GFX_SWAP(Copy_u8X0, Copy_u8X1);
+        GFX_SWAP(Copy_u8Y0, Copy_u8Y1);
+    }
+
+    s16 dx = Copy_u8X1 - Copy_u8X0;
+    s16 dy = (Copy_u8Y1 > Copy_u8Y0) ? Copy_u8Y1 - Copy_u8Y0 : Copy_u8Y0 - Copy_u8Y1;
+    s8  sy = (Copy_u8Y1 > Copy_u8Y0) ? 1 : -1;
+    s16 err = dx - dy;
+    u8  x = Copy_u8X0, y = Copy_u8Y0;
+    u8  span_y = y;              // First row of the span open in column x
+
+    for (;;)
+    {
+        if (x == Copy_u8X1 && y == Copy_u8Y1)
+            break;
+
+        s16 e2 = 2 * err;
+        if (e2 > -dy)
+        {
+            // Moving to the next column: close this one's span
+            GFX_voidVLine(x, span_y, y, Copy_u8Op);
+            err -= dy;
+            x++;
+            if (e2 < dx)
+            {
+                err += dx;
+                y += sy;
+            }
+            span_y = y;
+            continue;
+        }
+        err += dx;
+        y += sy;
+    }
+    GFX_voidVLine(x, span_y, y, Copy_u8Op);
+}
+
+void GFX_voidRect(u8 Copy_u8X0, u8 Copy_u8Y0, u8 Copy_u8X1, u8 Copy_u8Y1, u8 Copy_u8Op)
+{
+    if (Copy_u8X0 > Copy_u8X1) GFX_SWAP(Copy_u8X0, Copy_u8X1);
+    if (Copy_u8Y0 > Copy_u8Y1) GFX_SWAP(Copy_u8Y0, Copy_u8Y1);
+
+    GFX_voidVLine(Copy_u8X0, Copy_u8Y0, Copy_u8Y1, Copy_u8Op);
+    if (Copy_u8X1 == Copy_u8X0) return;
+    GFX_voidVLine(Copy_u8X1, Copy_u8Y0, Copy_u8Y1, Copy_u8Op);
+    if (Copy_u8X1 - Copy_u8X0 < 2) return;
+
+    // Corners belong to the sides (an invert must not hit them twice)
+    GFX_voidHLine(Copy_u8X0 + 1, Copy_u8X1 - 1, Copy_u8Y0, Copy_u8Op);
+    if (Copy_u8Y1 != Copy_u8Y0)
+        GFX_voidHLine(Copy_u8X0 + 1, Copy_u8X1 - 1, Copy_u8Y1, Copy_u8Op);
+}
+
+void GFX_voidFillRect(u8 Copy_u8X0, u8 Copy_u8Y0, u8 Copy_u8X1, u8 Copy_u8Y1, u8 Copy_u8Op)
+{
+    if (Copy_u8X0 > Copy_u8X1) GFX_SWAP(Copy_u8X0, Copy_u8X1);
+    if (Copy_u8X0 >= GLCD_WIDTH) return;
+    if (Copy_u8X1 >= GLCD_WIDTH) Copy_u8X1 = GLCD_WIDTH - 1;
+
+    for (u8 x = Copy_u8X0; ; x++)
+    {
+        GFX_voidVLine(x, Copy_u8Y0, Copy_u8Y1, Copy_u8Op);
+        if (x == Copy_u8X1) break;
+    }
+}
@@ -3,18 +3,96 @@
 
 /* GLCD (Graphical LCD) Hardware Configuration - KS0108 128x64 */
 
-// Data port for GLCD data lines (D0-D7)
+// Data port for GLCD data lines (D0-D7). PORTA is also the ADC input port:
+// the analog board (ADC_ENABLE) moves the bus to PORTC, which needs JTAG
+// off (JTAGEN fuse) to free PC2-PC5
+#ifndef GLCD_DATA_PORT
 #define GLCD_DATA_PORT DIO_PORTA
+#endif
 
 // Control port for GLCD control signals
 #define GLCD_CTRL_PORT DIO_PORTB
 
-// Control pin definitions
+// Control pin definitions (the defaults match the Proteus schematic; a board
+// variant can override single pins from the build, e.g. to free T1 on PB1)
+#ifndef GLCD_RS_PIN
 #define GLCD_RS_PIN DIO_PIN_0   // Register Select (Command/Data)
+#endif
+#ifndef GLCD_RW_PIN
 #define GLCD_RW_PIN DIO_PIN_1   // Read/Write Select
+#endif
+#ifndef GLCD_EN_PIN
 #define GLCD_EN_PIN DIO_PIN_2   // Enable Signal
+#endif
+#ifndef GLCD_CS1_PIN
 #define GLCD_CS1_PIN DIO_PIN_3  // Chip Select 1 (Left half: columns 0-63)
+#endif
+#ifndef GLCD_CS2_PIN
 #define GLCD_CS2_PIN DIO_PIN_4  // Chip Select 2 (Right half: columns 64-127)
+#endif
+#ifndef GLCD_RST_PIN
 #define GLCD_RST_PIN DIO_PIN_5  // Reset Signal
+#endif
 
-#endif
\ No newline at end of file
+/* Bus timing
+   GLCD_TIMING_FIXED:   5 us setup + 5 us hold per byte, the original timing
+   GLCD_TIMING_MINIMUM: cycle-counted KS0108 datasheet minimums, plus a fixed
+                        GLCD_T_BUSY_NS wait for the controller after every write
+   GLCD_TIMING_BUSY:    datasheet-minimum strobes, then the status register
+                        (RS = 0, RW = 1) is polled until the controller is ready;
+                        needs RW wired (it is on the default board) */
+#define GLCD_TIMING_FIXED   0
+#define GLCD_TIMING_MINIMUM 1
+#define GLCD_TIMING_BUSY    2
+
+#ifndef GLCD_TIMING_MODE
+#define GLCD_TIMING_MODE GLCD_TIMING_BUSY
+#endif
+
+// Controller busy time after an instruction (GLCD_TIMING_MINIMUM only); the
+// datasheet gives no figure, so keep a margin over what the module was measured at
+#define GLCD_T_BUSY_NS 1000
+
+// Status polls before giving up on a controller that never becomes ready
+// (missing display), so a broken bus cannot hang the firmware
+#define GLCD_BUSY_TIMEOUT 100
+
+/* Shadow framebuffer (8 pages x 128 columns = 1 KB of SRAM)
+   1: GLCD_voidFb* primitives draw into RAM, GLCD_voidFlush() pushes dirty bytes
+   0: framebuffer API is compiled out (WAVE, STRIP, GFX and ATRC draw with it) */
+#ifndef GLCD_FRAMEBUFFER_ENABLE
+#define GLCD_FRAMEBUFFER_ENABLE 1
+#endif
+
+/* Status line cache for GLCD_voidDisplayLine(): the text last drawn on
+   screen pages 0..GLCD_TEXT_LINES-1 (22 bytes of SRAM each), so only glyphs
+   that changed are sent. Pages past it are always redrawn in full */
+#ifndef GLCD_TEXT_LINES
+#define GLCD_TEXT_LINES 4
+#endif
+
+/* Deferred writes (GLCD_voidTick, hooked to the Timer2 tick)
+   1: text, clears, flushes and raw writes queue (chip, page, column, bytes)
+      transfers and return; every tick sends up to GLCD_ASYNC_BUDGET bus
+      cycles of them, so drawing never waits on the bus
+   0: every write goes out on the bus before the call returns */
+#ifndef GLCD_ASYNC_ENABLE
+#define GLCD_ASYNC_ENABLE 0
+#endif
+
+// Transfers waiting at once (power of two, max 128, 5 bytes of SRAM each);
+// their data shares a 256-byte ring
+#define GLCD_QUEUE_SIZE 32
+
+// Bus cycles (data bytes and address commands) per 1 ms tick: 32 cycles of
+// ~3.5 us take about 11 % of the CPU and send a full screen in 33 ms
+#define GLCD_ASYNC_BUDGET 32
+
+/* Bus transaction counters (GLCD_voidGetBusStats)
+   1: count every command/data cycle, used to measure bus traffic per frame
+   0: no counting overhead (default for the target build) */
+#ifndef GLCD_BUS_STATS_ENABLE
+#define GLCD_BUS_STATS_ENABLE 0
+#endif
+
+#endif
@@ -0,0 +1,21 @@
+/*
+   GLCD geometry tables - generated by Sim/gen_glcd_geo.c, do not edit
+*/
+
+#include "GLCD_geo.h"
+
+/* Row -> bit in its page */
+const u8 GLCD_au8RowMask[GLCD_HEIGHT] PROGMEM = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+};
+
+/* Rows y0..y1 of one page (0-7) -> bits, [y0 * 8 + y1] */
+const u8 GLCD_au8SpanMask[64] PROGMEM = {
+    0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0x00, 0x02, 0x06, 0x0E, 0x1E, 0x3E, 0x7E, 0xFE,
+    0x00, 0x00, 0x04, 0x0C, 0x1C, 0x3C, 0x7C, 0xFC, 0x00, 0x00, 0x00, 0x08, 0x18, 0x38, 0x78, 0xF8,
+    0x00, 0x00, 0x00, 0x00, 0x10, 0x30, 0x70, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x60, 0xE0,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+};
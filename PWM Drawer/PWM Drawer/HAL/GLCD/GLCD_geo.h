@@ -0,0 +1,20 @@
+#ifndef GLCD_GEO_H_
+#define GLCD_GEO_H_
+
+#include <avr/pgmspace.h>
+#include "../../Service/std_types.h"
+#include "GLCD_int.h"
+
+/* GLCD geometry lookup tables in flash (GLCD_geo.c, generated on the host by
+   Sim/gen_glcd_geo.c): the bit masks that take variable shifts, a loop on
+   AVR, become one table load. Chip, local column and page stay x >> 6,
+   x & 63 and y >> 3, which are cheaper than a load. Read them through the
+   macros below */
+
+extern const u8 GLCD_au8RowMask[GLCD_HEIGHT];    // 1 << (y % 8)
+extern const u8 GLCD_au8SpanMask[64];            // Rows y0..y1 of a page, [y0 * 8 + y1]
+
+#define GLCD_GEO_MASK(y)        pgm_read_byte(&GLCD_au8RowMask[y])
+#define GLCD_GEO_SPAN(y0, y1)   pgm_read_byte(&GLCD_au8SpanMask[((y0) << 3) | (y1)])
+
+#endif /* GLCD_GEO_H_ */
@@ -2,11 +2,32 @@
 #define GLCD_INT_H_
 
 #include "../../Service/std_types.h"
+#include "../FONT/FONT_int.h"
 
 /* GLCD (Graphical LCD) Interface Header */
 
-// External declaration of 5x7 font array
-extern const u8 font5x7[][5];
+// Display geometry (pixels / 8-pixel pages)
+#define GLCD_WIDTH  128
+#define GLCD_HEIGHT 64
+#define GLCD_PAGES  8
+
+// Bus traffic counters filled when GLCD_BUS_STATS_ENABLE is set in GLCD_cfg.h
+typedef struct
+{
+    u32 commands;      // Command cycles (RS = 0, RW = 0)
+    u32 data_writes;   // Display RAM write cycles (RS = 1, RW = 0)
+    u32 cycles;        // Estimated CPU cycles spent on the bus
+} GLCD_BusStats_t;
+
+// Deferred write queue counters (GLCD_ASYNC_ENABLE)
+typedef struct
+{
+    u16 queued;        // Transfers queued
+    u16 stalls;        // Writes that found the queue full and sent transfers themselves
+    u16 deferred;      // Flushes that left dirty bytes for the next flush (queue full)
+    u8  max_fill;      // Most transfers waiting at once
+    u8  max_bytes;     // Most ring bytes waiting at once
+} GLCD_QueueStats_t;
 
 // Function prototypes for GLCD operations
 
@@ -16,25 +37,99 @@ void GLCD_voidInit(void);
 // Clear entire display
 void GLCD_voidClear(void);
 
-// Set cursor position (x: 0-7 pages, y: 0-127 columns)
+// Set cursor position (x: 0-7 pages, y: 0-127 columns). Nothing is sent:
+// the text and column writes set the controller address when they start,
+// and only if it differs from the one the controller already holds
 void GLCD_voidGotoXY(u8 x, u8 y);
 
-// Display single character
+// Hardware scroll by whole pages: screen page 0 shows display RAM page
+// Copy_u8Page. Pages passed to the text and framebuffer functions are screen
+// pages and follow the scroll; raw GLCD_voidCommand() addressing does not
+void GLCD_voidSetStartPage(u8 Copy_u8Page);
+u8 GLCD_u8GetStartPage(void);
+
+// Display single character (FONT_5x7)
 void GLCD_voidDisplayChar(char c);
 
-// Display string
+// Display string (FONT_5x7)
 void GLCD_voidDisplayString(u8 *str);
 
+// Display text in any font (flash descriptor, e.g. &FONT_10x16) with its
+// top left at page / column; a font taller than a page covers the pages below
+void GLCD_voidDisplayText(const FONT_t *font, u8 page, u8 col, const char *text);
+
+// Display a whole text line at column 0 of a page: only characters that
+// differ from the last line drawn there are rewritten, and leftovers of a
+// longer previous line are blanked (cached pages: GLCD_TEXT_LINES).
+// GLCD_voidDisplayLine draws in FONT_5x7
+void GLCD_voidDisplayLine(u8 page, const char *text);
+void GLCD_voidDisplayLineFont(const FONT_t *font, u8 page, const char *text);
+
 // Display number
 void GLCD_voidDisplayNumber(u32 num);
 
+// Display fixed-point number: num holds the value times 10^decimals (0-9)
+void GLCD_voidDisplayFixed(u32 num, u8 decimals);
+
 // Send command to specific GLCD chip
 void GLCD_voidCommand(u8 cmd, u8 cs);
 
-// Write data to specific GLCD chip
+// Write data to specific GLCD chip, at that chip's current address. The
+// cursor of GLCD_voidGotoXY() is not applied here: to write raw bytes at
+// a position, send the page and column commands with GLCD_voidCommand()
+// first (the address cache follows them, so later text stays correct)
 void GLCD_voidWriteData(u8 data, u8 cs);
 
-/* Read Data Function (to be able to read/write/modify) for vertical lines */
-uint8_t GLCD_voidReadData(u8 cs);
+/* Framebuffer primitives (GLCD_FRAMEBUFFER_ENABLE): these only touch RAM,
+   nothing reaches the display until GLCD_voidFlush() */
+
+// Clear the whole framebuffer
+void GLCD_voidFbClear(void);
+
+// Clear pages first..last (inclusive) across all 128 columns
+void GLCD_voidFbClearPages(u8 first, u8 last);
+
+// Set / clear one pixel (x: 0-127, y: 0-63)
+void GLCD_voidFbSetPixel(u8 x, u8 y);
+void GLCD_voidFbClearPixel(u8 x, u8 y);
+
+// Replace / OR a whole page byte (page: 0-7, col: 0-127), dirty only if it changes
+void GLCD_voidFbWriteByte(u8 page, u8 col, u8 data);
+void GLCD_voidFbOrByte(u8 page, u8 col, u8 mask);
+
+// Read back a page byte from RAM (replaces reading the controller)
+u8 GLCD_u8FbReadByte(u8 page, u8 col);
+
+// Draw a string into the framebuffer at page / column (6 columns per character)
+void GLCD_voidFbDisplayString(u8 page, u8 col, const u8 *str);
+
+// The same in any font
+void GLCD_voidFbDisplayText(const FONT_t *font, u8 page, u8 col, const char *text);
+
+// Push dirty column ranges of every page to the controllers
+void GLCD_voidFlush(void);
+
+/* Deferred writes (GLCD_ASYNC_ENABLE) */
+
+// Send up to GLCD_ASYNC_BUDGET bus cycles of queued transfers; hooked to the
+// Timer2 tick by GLCD_voidInit (runs with interrupts enabled)
+void GLCD_voidTick(void);
+
+// 1 when everything drawn so far is on the display: the queue is empty and
+// no flush left dirty bytes behind. A frame should not start before that
+u8 GLCD_u8FrameDone(void);
+
+// Bus cycles still queued: back-pressure, about this many / GLCD_ASYNC_BUDGET
+// ticks until the display has caught up
+u16 GLCD_u16Backlog(void);
+
+// Send everything queued from the caller, e.g. before a delay with the tick stopped
+void GLCD_voidSync(void);
+
+void GLCD_voidGetQueueStats(GLCD_QueueStats_t *stats);
+
+/* Bus statistics (GLCD_BUS_STATS_ENABLE) */
+void GLCD_voidGetBusStats(GLCD_BusStats_t *stats);
+void GLCD_voidResetBusStats(void);
 
-#endif
\ No newline at end of file
+#endif
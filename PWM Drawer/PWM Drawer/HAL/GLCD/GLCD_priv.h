@@ -10,4 +10,65 @@
 #define GLCD_CMD_SET_X       0xB8  // Set X address (page) - 0-7
 #define GLCD_CMD_START_LINE  0xC0  // Set display start line - 0-63
 
-#endif /* GLCD_PRIV_H_ */
\ No newline at end of file
+// Display geometry
+#define GLCD_CHIP_WIDTH      64    // Columns driven by each KS0108
+#define GLCD_CHIPS           2     // CS1 (left) and CS2 (right)
+
+// Columns per character: 5 font columns + 1 spacing column
+#define GLCD_CHAR_WIDTH      6
+#define GLCD_TEXT_COLS       (128 / GLCD_CHAR_WIDTH)   // Characters on one line
+
+// Controller address not known (after reset)
+#define GLCD_ADDR_UNKNOWN    0xFF
+
+// Framebuffer dirty range marker: low bound above any valid column means clean
+#define GLCD_FB_CLEAN        0xFF
+
+// Control lines set together for each bus cycle (one masked port store)
+#define GLCD_CYCLE_MASK  ((1 << GLCD_RS_PIN) | (1 << GLCD_RW_PIN) | \
+                          (1 << GLCD_CS1_PIN) | (1 << GLCD_CS2_PIN))
+#define GLCD_CS_MASK     ((1 << GLCD_CS1_PIN) | (1 << GLCD_CS2_PIN))
+
+// Deferred transfer (GLCD_ASYNC_ENABLE): len bytes to one chip from page /
+// local column on, taken from the byte ring unless it is a fill or a command
+typedef struct
+{
+    u8 ctl;          // Chip (1 / 2) | GLCD_XFER_* flags
+    u8 page;         // Display RAM page
+    u8 col;          // Local column of the next byte (advanced as bytes go out)
+    u8 len;          // Bytes still to send
+    u8 value;        // Fill byte or command
+} GLCD_Xfer_t;
+
+#define GLCD_XFER_CS_MASK    0x03
+#define GLCD_XFER_CMD        0x04  // One command: value
+#define GLCD_XFER_FILL       0x08  // len copies of value, nothing in the byte ring
+#define GLCD_XFER_HERE       0x10  // No address: bytes go where the controller points
+
+#define GLCD_QUEUE_MASK      (GLCD_QUEUE_SIZE - 1)
+#define GLCD_QUEUE_BYTES     256   // Byte ring, indexed by u8
+
+// Status register bits (RS = 0, RW = 1)
+#define GLCD_STATUS_BUSY     0x80  // Controller still executing the last instruction
+
+// KS0108 bus timing minimums from the datasheet (ns)
+#define GLCD_T_CYC_NS        1000  // E cycle time
+#define GLCD_T_PWEH_NS       450   // E high pulse width
+#define GLCD_T_PWEL_NS       450   // E low pulse width
+#define GLCD_T_AS_NS         140   // Address (RS, RW, CS) setup before E rises
+#define GLCD_T_DSW_NS        200   // Write data setup before E falls
+#define GLCD_T_DDR_NS        320   // Read data valid after E rises
+
+// Nanoseconds -> CPU cycles, rounded up
+#define GLCD_NS_CYCLES(ns)   ((((ns) * (F_CPU / 1000000UL)) + 999) / 1000)
+
+// Approximate CPU cycles per bus cycle at 16 MHz (delays + pin toggling)
+#if GLCD_TIMING_MODE == GLCD_TIMING_FIXED
+#define GLCD_BUS_CYCLES_PER_XFER 172UL   // Two 5 us delays
+#elif GLCD_TIMING_MODE == GLCD_TIMING_MINIMUM
+#define GLCD_BUS_CYCLES_PER_XFER 40UL    // E high + busy wait
+#else
+#define GLCD_BUS_CYCLES_PER_XFER 56UL    // One status poll + E high + E low
+#endif
+
+#endif /* GLCD_PRIV_H_ */
@@ -3,90 +3,362 @@
 */
 
 #include <util/delay.h>
-#include <stdio.h>
+#include <avr/interrupt.h>
+#include <string.h>
 #include "../../Service/bit_math.h"
 #include "../../Service/std_types.h"
+#include "../../Service/FMT/FMT_interface.h"
 #include "../../MCAL/DIO/DIO_interface.h"
+#include "../../MCAL/DIO/DIO_fast.h"
+#include "../../MCAL/TICK/TICK_interface.h"
+#include "../FONT/FONT_int.h"
 #include "GLCD_cfg.h"
 #include "GLCD_priv.h"
 #include "GLCD_int.h"
-
-/* 5x7 Font table - ASCII characters from space (32) to Z (90) */
-const u8 font5x7[][5] = {
-    {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00},
-    {0x14,0x7F,0x14,0x7F,0x14}, {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62},
-    {0x36,0x49,0x55,0x22,0x50}, {0x00,0x05,0x03,0x00,0x00}, {0x00,0x1C,0x22,0x41,0x00},
-    {0x00,0x41,0x22,0x1C,0x00}, {0x14,0x08,0x3E,0x08,0x14}, {0x08,0x08,0x3E,0x08,0x08},
-    {0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x60,0x60,0x00,0x00},
-    {0x20,0x10,0x08,0x04,0x02}, {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00},
-    {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31}, {0x18,0x14,0x12,0x7F,0x10},
-    {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03},
-    {0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, {0x00,0x36,0x36,0x00,0x00},
-    {0x00,0x56,0x36,0x00,0x00}, {0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14},
-    {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06}, {0x32,0x49,0x79,0x41,0x3E},
-    {0x7E,0x11,0x11,0x11,0x7E}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22},
-    {0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01},
-    {0x3E,0x41,0x49,0x49,0x7A}, {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00},
-    {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41}, {0x7F,0x40,0x40,0x40,0x40},
-    {0x7F,0x02,0x0C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E},
-    {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46},
-    {0x26,0x49,0x49,0x49,0x32}, {0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F},
-    {0x1F,0x20,0x40,0x20,0x1F}, {0x7F,0x20,0x18,0x20,0x7F}, {0x63,0x14,0x08,0x14,0x63},
-    {0x07,0x08,0x70,0x08,0x07}, {0x61,0x51,0x49,0x45,0x43},
-};
+#include "GLCD_geo.h"
 
 /* Global variables for cursor position tracking */
-static u8 current_page = 0;  // Current page (0-7)
+static u8 current_page = 0;  // Current page (0-7, display RAM page)
 static u8 current_col = 0;   // Current column (0-127)
 
-/* Send command to GLCD controller */
-void GLCD_voidCommand(u8 cmd, u8 cs)
+/* Hardware scroll: display RAM page shown on the top page row. Callers use
+   screen pages; GLCD_PHYS_PAGE() maps them onto display RAM */
+static u8 page_offset = 0;
+#define GLCD_PHYS_PAGE(page) (((page) + page_offset) & (GLCD_PAGES - 1))
+
+/* Page and column counters of each controller as last set (the column
+   auto-increments on every data write), so address commands are only sent
+   when a write would land somewhere else. GLCD_ADDR_UNKNOWN after reset */
+static u8 chip_page[GLCD_CHIPS] = { GLCD_ADDR_UNKNOWN, GLCD_ADDR_UNKNOWN };
+static u8 chip_col[GLCD_CHIPS] = { GLCD_ADDR_UNKNOWN, GLCD_ADDR_UNKNOWN };
+
+#if GLCD_TEXT_LINES > 0
+/* Text on screen per status line (GLCD_voidDisplayLine), "" when blank, and
+   the font it was drawn in (a line in a taller font covers the pages below) */
+static char text_shown[GLCD_TEXT_LINES][GLCD_TEXT_COLS + 1];
+static const FONT_t *text_font[GLCD_TEXT_LINES];
+#endif
+
+#if GLCD_FRAMEBUFFER_ENABLE
+/* Shadow of both controllers' display RAM, indexed [page][column 0-127] */
+static u8 fb[GLCD_PAGES][GLCD_WIDTH];
+/* Dirty column range per page and chip (local columns 0-63), lo = GLCD_FB_CLEAN when clean */
+static u8 fb_dirty_lo[GLCD_PAGES][GLCD_CHIPS];
+static u8 fb_dirty_hi[GLCD_PAGES][GLCD_CHIPS];
+#endif
+
+#if GLCD_ASYNC_ENABLE
+#if (GLCD_QUEUE_SIZE & GLCD_QUEUE_MASK) != 0 || GLCD_QUEUE_SIZE > 128
+#error "GLCD_QUEUE_SIZE must be a power of two no larger than 128"
+#endif
+
+/* Transfer queue and its byte ring: writers only move the heads, the drain
+   (tick or a writer waiting for room) only the tails. A transfer being sent
+   is updated in place, so a partly sent one resumes at the right column */
+static volatile GLCD_Xfer_t queue[GLCD_QUEUE_SIZE];
+static volatile u8 q_head = 0;
+static volatile u8 q_tail = 0;
+static u8 q_bytes[GLCD_QUEUE_BYTES];
+static volatile u8 qb_head = 0;
+static volatile u8 qb_tail = 0;
+
+/* Set while one context sends transfers: the tick skips its turn then */
+static volatile u8 q_draining = 0;
+
+/* A flush stopped on a full queue: dirty bytes are still in the framebuffer */
+static u8 q_deferred = 0;
+
+static GLCD_QueueStats_t q_stats;
+#endif
+
+#if GLCD_BUS_STATS_ENABLE
+static GLCD_BusStats_t bus_stats;
+#define GLCD_COUNT(field) (bus_stats.field++, bus_stats.cycles += GLCD_BUS_CYCLES_PER_XFER)
+#else
+#define GLCD_COUNT(field)
+#endif
+
+#if GLCD_TIMING_MODE == GLCD_TIMING_BUSY
+/* Read the status register of one chip until it is no longer busy */
+static void GLCD_voidWaitReady(u8 cs)
+{
+    u8 status;
+    u8 tries = GLCD_BUSY_TIMEOUT;
+    u8 ctrl = (1 << GLCD_RW_PIN) | ((cs == 1) ? (1 << GLCD_CS1_PIN) : (1 << GLCD_CS2_PIN));
+
+    // Release the data bus to the controller, no pull-ups
+    DIO_voidFastSetPortDirection(GLCD_DATA_PORT, DIO_PORT_INPUT);
+    DIO_voidFastSetPortValue(GLCD_DATA_PORT, 0);
+    DIO_voidFastSetPortMasked(GLCD_CTRL_PORT, GLCD_CYCLE_MASK, ctrl);
+    __builtin_avr_delay_cycles(GLCD_NS_CYCLES(GLCD_T_AS_NS));
+
+    do
+    {
+        DIO_voidFastSetPin(GLCD_CTRL_PORT, GLCD_EN_PIN);
+        __builtin_avr_delay_cycles(GLCD_NS_CYCLES(GLCD_T_PWEH_NS));  // Covers tDDR too
+        status = DIO_u8FastGetPortValue(GLCD_DATA_PORT);
+        DIO_voidFastClrPin(GLCD_CTRL_PORT, GLCD_EN_PIN);
+        __builtin_avr_delay_cycles(GLCD_NS_CYCLES(GLCD_T_PWEL_NS));
+    } while ((status & GLCD_STATUS_BUSY) && --tries);
+
+    DIO_voidFastSetPortDirection(GLCD_DATA_PORT, DIO_PORT_OUTPUT);
+}
+#endif
+
+/* One write cycle on the bus: RS, RW and the chip selects change in a single
+   port store, then E is strobed (cs: 1 = left, 2 = right) */
+static void GLCD_voidBusWrite(u8 rs, u8 data, u8 cs)
 {
-    // Set RS low for command mode
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_RS_PIN, 0);
-    // Set RW low for write mode
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_RW_PIN, 0);
-    // Output command on data port
-    DIO_voidSetPortValue(GLCD_DATA_PORT, cmd);
+    u8 ctrl = (rs ? (1 << GLCD_RS_PIN) : 0) |
+              ((cs == 1) ? (1 << GLCD_CS1_PIN) : 0) |
+              ((cs == 2) ? (1 << GLCD_CS2_PIN) : 0);   // RW low: write
 
-    // Select appropriate chip (CS1 for left, CS2 for right)
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_CS1_PIN, (cs == 1) ? 1 : 0);
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_CS2_PIN, (cs == 2) ? 1 : 0);
+#if GLCD_TIMING_MODE == GLCD_TIMING_BUSY
+    GLCD_voidWaitReady(cs);
+#endif
 
+    DIO_voidFastSetPortMasked(GLCD_CTRL_PORT, GLCD_CYCLE_MASK, ctrl);
+    // Output command or data on data port
+    DIO_voidFastSetPortValue(GLCD_DATA_PORT, data);
+    // Address setup: with the single-store control write E would otherwise rise
+    // only two or three cycles later, right at the 140 ns limit
+    __builtin_avr_delay_cycles(GLCD_NS_CYCLES(GLCD_T_AS_NS));
+
+#if GLCD_TIMING_MODE == GLCD_TIMING_FIXED
     // Generate enable pulse
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_EN_PIN, 1);
+    DIO_voidFastSetPin(GLCD_CTRL_PORT, GLCD_EN_PIN);
     _delay_us(5);  // Wait for setup time
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_EN_PIN, 0);
+    DIO_voidFastClrPin(GLCD_CTRL_PORT, GLCD_EN_PIN);
 
     // Deselect both chips
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_CS1_PIN, 0);
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_CS2_PIN, 0);
+    DIO_voidFastSetPortMasked(GLCD_CTRL_PORT, GLCD_CS_MASK, 0);
     _delay_us(5);  // Wait for hold time
+#else
+    // Enable pulse at the datasheet minimums; data was set up before E rose,
+    // so tDSW is covered by the high time
+    DIO_voidFastSetPin(GLCD_CTRL_PORT, GLCD_EN_PIN);
+    __builtin_avr_delay_cycles(GLCD_NS_CYCLES(GLCD_T_PWEH_NS));
+    DIO_voidFastClrPin(GLCD_CTRL_PORT, GLCD_EN_PIN);
+
+    // Deselect both chips
+    DIO_voidFastSetPortMasked(GLCD_CTRL_PORT, GLCD_CS_MASK, 0);
+#if GLCD_TIMING_MODE == GLCD_TIMING_MINIMUM
+    // No status reads: wait out the instruction (longer than tPWEL and the cycle time)
+    __builtin_avr_delay_cycles(GLCD_NS_CYCLES(GLCD_T_BUSY_NS));
+#else
+    // E low time; the next cycle starts with a status poll
+    __builtin_avr_delay_cycles(GLCD_NS_CYCLES(GLCD_T_PWEL_NS));
+#endif
+#endif
+}
+
+/* Command cycle on the bus */
+static void GLCD_voidBusCommand(u8 cmd, u8 cs)
+{
+    GLCD_voidBusWrite(0, cmd, cs);
+    GLCD_COUNT(commands);
+
+    // Follow address changes, whoever sends them
+    if ((cmd & 0xF8) == GLCD_CMD_SET_X)
+        chip_page[cs - 1] = cmd & 0x07;
+    else if ((cmd & 0xC0) == GLCD_CMD_SET_Y)
+        chip_col[cs - 1] = cmd & 0x3F;
+}
+
+/* Display RAM write cycle on the bus */
+static void GLCD_voidBusData(u8 data, u8 cs)
+{
+    GLCD_voidBusWrite(1, data, cs);
+    GLCD_COUNT(data_writes);
+
+    if (chip_col[cs - 1] != GLCD_ADDR_UNKNOWN)
+        chip_col[cs - 1] = (chip_col[cs - 1] + 1) & (GLCD_CHIP_WIDTH - 1);
+}
+
+/* Point a controller at page / local column, skipping what it already has;
+   returns the commands that took */
+static u8 GLCD_u8SetAddress(u8 cs, u8 page, u8 local_col)
+{
+    u8 sent = 0;
+
+    if (chip_page[cs - 1] != page)
+    {
+        GLCD_voidBusCommand(GLCD_CMD_SET_X | page, cs);
+        sent++;
+    }
+    if (chip_col[cs - 1] != local_col)
+    {
+        GLCD_voidBusCommand(GLCD_CMD_SET_Y | local_col, cs);
+        sent++;
+    }
+    return sent;
+}
+
+#if GLCD_ASYNC_ENABLE
+/* Send queued transfers for one GLCD_ASYNC_BUDGET of bus cycles (the
+   caller holds q_draining) */
+static void GLCD_voidDrain(void)
+{
+    u8 spent = 0;
+
+    while (spent < GLCD_ASYNC_BUDGET && q_tail != q_head)
+    {
+        volatile GLCD_Xfer_t *x = &queue[q_tail];
+        u8 cs = x->ctl & GLCD_XFER_CS_MASK;
+
+        if (x->ctl & GLCD_XFER_CMD)
+        {
+            GLCD_voidBusCommand(x->value, cs);
+            x->len = 0;
+            spent++;
+        }
+        else
+        {
+            if (!(x->ctl & GLCD_XFER_HERE))
+                spent += GLCD_u8SetAddress(cs, x->page, x->col);
+            while (x->len > 0 && spent < GLCD_ASYNC_BUDGET)
+            {
+                GLCD_voidBusData((x->ctl & GLCD_XFER_FILL) ? x->value : q_bytes[qb_tail++], cs);
+                x->col = (x->col + 1) & (GLCD_CHIP_WIDTH - 1);
+                x->len--;
+                spent++;
+            }
+        }
+
+        if (x->len == 0)
+            q_tail = (q_tail + 1) & GLCD_QUEUE_MASK;
+    }
+}
+
+/* Drain from a writer: the tick cannot run in between, it nests over us */
+static void GLCD_voidDrainHere(void)
+{
+    q_draining = 1;
+    GLCD_voidDrain();
+    q_draining = 0;
+}
+
+static u8 GLCD_u8FreeBytes(void)
+{
+    return (GLCD_QUEUE_BYTES - 1) - (u8)(qb_head - qb_tail);
+}
+
+static u8 GLCD_u8HasRoom(u8 bytes)
+{
+    return ((q_head + 1) & GLCD_QUEUE_MASK) != q_tail && GLCD_u8FreeBytes() >= bytes;
+}
+
+/* Queue one transfer (len 1-64, within one chip's page). Bytes of a data run
+   are copied into the ring; a run continuing the newest transfer is merged
+   into it. With the queue full the writer sends transfers itself until
+   there is room, so this also works before the tick is started */
+static void GLCD_voidQueue(u8 ctl, u8 page, u8 col, const u8 *data, u8 len, u8 value)
+{
+    u8 bytes = (ctl & (GLCD_XFER_CMD | GLCD_XFER_FILL)) ? 0 : len;
+    u8 head, fill, sreg;
+
+    if (!GLCD_u8HasRoom(bytes))
+    {
+        q_stats.stalls++;
+        do GLCD_voidDrainHere(); while (!GLCD_u8HasRoom(bytes));
+    }
+
+    // Past qb_head: the drain does not read them before they are published
+    head = qb_head;
+    for (u8 i = 0; i < bytes; i++)
+        q_bytes[(u8)(head + i)] = data[i];
+
+    // The drain may be partway through the newest transfer: look at it and
+    // publish with the tick held off
+    sreg = SREG_REG;
+    cli();
+    qb_head = head + bytes;
+    if (q_head != q_tail && bytes != 0 && !(ctl & GLCD_XFER_HERE))
+    {
+        volatile GLCD_Xfer_t *last = &queue[(q_head - 1) & GLCD_QUEUE_MASK];
+
+        if (last->ctl == ctl && last->page == page && last->len != 0 &&
+            last->col + last->len == col && col + len <= GLCD_CHIP_WIDTH)
+        {
+            last->len += len;
+            SREG_REG = sreg;
+            return;
+        }
+    }
+    queue[q_head].ctl = ctl;
+    queue[q_head].page = page;
+    queue[q_head].col = col;
+    queue[q_head].len = len;
+    queue[q_head].value = value;
+    q_head = (q_head + 1) & GLCD_QUEUE_MASK;
+    SREG_REG = sreg;
+
+    q_stats.queued++;
+    fill = (q_head - q_tail) & GLCD_QUEUE_MASK;
+    if (fill > q_stats.max_fill) q_stats.max_fill = fill;
+    fill = (GLCD_QUEUE_BYTES - 1) - GLCD_u8FreeBytes();
+    if (fill > q_stats.max_bytes) q_stats.max_bytes = fill;
+}
+#endif
+
+/* Send command to GLCD controller */
+void GLCD_voidCommand(u8 cmd, u8 cs)
+{
+#if GLCD_ASYNC_ENABLE
+    GLCD_voidQueue(cs | GLCD_XFER_CMD, 0, 0, 0, 1, cmd);
+#else
+    GLCD_voidBusCommand(cmd, cs);
+#endif
 }
 
 /* Write data to GLCD display RAM */
 void GLCD_voidWriteData(u8 data, u8 cs)
 {
-    // Set RS high for data mode
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_RS_PIN, 1);
-    // Set RW low for write mode
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_RW_PIN, 0);
-    // Output data on data port
-    DIO_voidSetPortValue(GLCD_DATA_PORT, data);
+#if GLCD_ASYNC_ENABLE
+    GLCD_voidQueue(cs | GLCD_XFER_HERE, 0, 0, &data, 1, 0);
+#else
+    GLCD_voidBusData(data, cs);
+#endif
+}
 
-    // Select appropriate chip
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_CS1_PIN, (cs == 1) ? 1 : 0);
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_CS2_PIN, (cs == 2) ? 1 : 0);
+/* Stream bytes to the display at the cursor: the address is only set when
+   the run starts and when it crosses into the right chip or wraps to the next page */
+static void GLCD_voidWriteColumns(const u8 *cols, u8 count)
+{
+#if GLCD_ASYNC_ENABLE
+    // One transfer per chip / page the run touches
+    while (count > 0)
+    {
+        u8 local = current_col & (GLCD_CHIP_WIDTH - 1);
+        u8 n = GLCD_CHIP_WIDTH - local;
 
-    // Generate enable pulse
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_EN_PIN, 1);
-    _delay_us(5);  // Wait for setup time
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_EN_PIN, 0);
+        if (n > count) n = count;
+        GLCD_voidQueue((current_col < GLCD_CHIP_WIDTH) ? 1 : 2, current_page, local, cols, n, 0);
+        cols += n;
+        count -= n;
+        current_col += n;
+        if (current_col >= GLCD_WIDTH)
+        {
+            current_col = 0;
+            current_page = (current_page + 1) & (GLCD_PAGES - 1);
+        }
+    }
+#else
+    for (u8 i = 0; i < count; i++)
+    {
+        u8 cs = (current_col < GLCD_CHIP_WIDTH) ? 1 : 2;
 
-    // Deselect both chips
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_CS1_PIN, 0);
-    DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_CS2_PIN, 0);
-    _delay_us(5);  // Wait for hold time
+        GLCD_u8SetAddress(cs, current_page, current_col & (GLCD_CHIP_WIDTH - 1));
+        GLCD_voidBusData(cols[i], cs);
+
+        /* Handle page wrap */
+        if (++current_col >= GLCD_WIDTH)
+        {
+            current_col = 0;
+            current_page = (current_page + 1) & (GLCD_PAGES - 1);
+        }
+    }
+#endif
 }
 
 /* Initialize GLCD hardware and controller */
@@ -102,100 +374,82 @@ void GLCD_voidInit(void)
     DIO_voidSetPinDirection(GLCD_CTRL_PORT, GLCD_CS2_PIN, 1);
     DIO_voidSetPinDirection(GLCD_CTRL_PORT, GLCD_RST_PIN, 1);
 
-    // Reset sequence
+#if GLCD_ASYNC_ENABLE
+    // Straight to the bus until the end: the tick must not drain meanwhile
+    q_draining = 1;
+    q_head = q_tail = 0;
+    qb_head = qb_tail = 0;
+    q_deferred = 0;
+#endif
+
+    // Reset sequence (controller addresses are unknown afterwards, start line is 0)
+    page_offset = 0;
+    chip_page[0] = chip_page[1] = GLCD_ADDR_UNKNOWN;
+    chip_col[0] = chip_col[1] = GLCD_ADDR_UNKNOWN;
     DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_RST_PIN, 0);
     _delay_ms(10);  // Hold reset low
     DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_RST_PIN, 1);
     _delay_ms(50);  // Wait for stabilization
 
     // Turn on both display halves
-    GLCD_voidCommand(0x3F, 1);  // Display on for chip 1
-    GLCD_voidCommand(0x3F, 2);  // Display on for chip 2
+    GLCD_voidBusCommand(0x3F, 1);  // Display on for chip 1
+    GLCD_voidBusCommand(0x3F, 2);  // Display on for chip 2
     _delay_ms(100);  // Wait for display ready
 
     // Clear display and reset cursor
     GLCD_voidClear();
+
+#if GLCD_ASYNC_ENABLE
+    q_draining = 0;
+    GLCD_voidSync();
+    TICK_voidSetTask(GLCD_voidTick);
+#endif
 }
 
-/* Set cursor position on display */
+/* Set cursor position on display; the controller address is sent with the next write */
 void GLCD_voidGotoXY(u8 x, u8 y)
 {
     // Update global position variables
-    current_page = x;
+    current_page = GLCD_PHYS_PAGE(x);
     current_col = y;
+}
+
+/* Scroll the display to show screen page 0 from display RAM page Copy_u8Page;
+   the start line moves in whole pages so the page mapping stays exact */
+void GLCD_voidSetStartPage(u8 Copy_u8Page)
+{
+    page_offset = Copy_u8Page & (GLCD_PAGES - 1);
+    GLCD_voidCommand(GLCD_CMD_START_LINE | (page_offset * 8), 1);
+    GLCD_voidCommand(GLCD_CMD_START_LINE | (page_offset * 8), 2);
+
+#if GLCD_TEXT_LINES > 0
+    // Other text is under the cached lines now
+    memset(text_shown, 0, sizeof(text_shown));
+#endif
+}
+
+u8 GLCD_u8GetStartPage(void)
+{
+    return page_offset;
+}
 
-    // Determine which chip to use based on column
-    u8 chip = (y < 64) ? 1 : 2;
-    // Calculate local column within chip (0-63)
-    u8 local_col = (y < 64) ? y : (y - 64);
+/* One page of a glyph at the current position, spacing included */
+static void GLCD_voidDrawGlyph(const FONT_t *desc, char c, u8 glyph_page)
+{
+    u8 cols[FONT_MAX_ADVANCE];
 
-    // Send position commands to appropriate chip
-    GLCD_voidCommand(0xB8 | x, chip);      // Set page
-    GLCD_voidCommand(0x40 | local_col, chip); // Set column
+    GLCD_voidWriteColumns(cols, FONT_u8Columns(desc, c, glyph_page, cols));
 }
 
 /* Display single character at current position */
 void GLCD_voidDisplayChar(char c)
 {
-    // Check if character is in valid range (space to Z)
-    if (c < 32 || c > 90) return;
+    FONT_t desc;
 
-    // Calculate font table index
-    u8 idx = c - 32;
-    
-    /* Write each of 5 font bytes */
-    for (u8 i = 0; i < 5; i++)
-    {
-        // Determine chip and local column
-        u8 chip = (current_col < 64) ? 1 : 2;
-        u8 local_col = (current_col < 64) ? current_col : (current_col - 64);
-        
-        /* Set position before each write */
-        GLCD_voidCommand(0xB8 | current_page, chip);
-        GLCD_voidCommand(0x40 | local_col, chip);
-        
-        /* Write the font byte */
-        GLCD_voidWriteData(font5x7[idx][i], chip);
-        
-        // Move to next column
-        current_col++;
-        
-        /* Handle chip boundary crossing */
-        if (current_col == 64)
-        {
-            /* Moving from chip 1 to chip 2 */
-            GLCD_voidCommand(0xB8 | current_page, 2);
-            GLCD_voidCommand(0x40 | 0, 2);
-        }
-    }
-
-    /* Space between characters */
-    u8 chip = (current_col < 64) ? 1 : 2;
-    u8 local_col = (current_col < 64) ? current_col : (current_col - 64);
-    
-    // Set position for space
-    GLCD_voidCommand(0xB8 | current_page, chip);
-    GLCD_voidCommand(0x40 | local_col, chip);
-    // Write space (blank column)
-    GLCD_voidWriteData(0x00, chip);
-    
-    // Move to next column after space
-    current_col++;
-    
-    /* Handle chip boundary crossing */
-    if (current_col == 64)
-    {
-        GLCD_voidCommand(0xB8 | current_page, 2);
-        GLCD_voidCommand(0x40 | 0, 2);
-    }
-    
-    /* Handle page wrap */
-    if (current_col >= 128)
-    {
-        current_col = 0;
-        current_page++;
-        if (current_page >= 8) current_page = 0;
-    }
+    FONT_voidLoad(&FONT_5x7, &desc);
+    // Characters outside the font are skipped
+    if (FONT_u8Has(&desc, c))
+        GLCD_voidDrawGlyph(&desc, c, 0);
 }
 
 /* Display string starting at current position */
@@ -209,16 +463,129 @@ void GLCD_voidDisplayString(u8 *str)
     }
 }
 
+/* Draw text in any font from page / column on, a glyph page row at a time */
+void GLCD_voidDisplayText(const FONT_t *font, u8 page, u8 col, const char *text)
+{
+    FONT_t desc;
+
+    FONT_voidLoad(font, &desc);
+    for (u8 p = 0; p < desc.pages && page + p < GLCD_PAGES; p++)
+    {
+        u8 x = col;
+
+        // Whole glyphs only, clipped at the right border
+        GLCD_voidGotoXY(page + p, col);
+        for (const char *c = text; *c && x + desc.width + desc.spacing <= GLCD_WIDTH; c++)
+        {
+            GLCD_voidDrawGlyph(&desc, *c, p);
+            x += desc.width + desc.spacing;
+        }
+    }
+}
+
+/* Display a status line, sending only the glyphs that changed. Characters
+   outside the font count as blanks, so they compare like one */
+void GLCD_voidDisplayLine(u8 page, const char *text)
+{
+    GLCD_voidDisplayLineFont(&FONT_5x7, page, text);
+}
+
+void GLCD_voidDisplayLineFont(const FONT_t *font, u8 page, const char *text)
+{
+    FONT_t desc;
+    u8 advance, count;
+
+    FONT_voidLoad(font, &desc);
+    advance = desc.width + desc.spacing;
+    count = GLCD_WIDTH / advance;
+    if (count > GLCD_TEXT_COLS) count = GLCD_TEXT_COLS;
+
+#if GLCD_TEXT_LINES > 0
+    if (page < GLCD_TEXT_LINES)
+    {
+        char *shown = text_shown[page];
+        u8 old_len, len = 0;
+
+        // Another font drew the line: blank it in that font, then start over
+        if (text_font[page] != font)
+        {
+            if (shown[0] != '\0')
+            {
+                memset(shown, ' ', strlen(shown));
+                GLCD_voidDisplayText(text_font[page], page, 0, shown);
+            }
+            shown[0] = '\0';
+            text_font[page] = font;
+        }
+        old_len = strlen(shown);
+
+        // Page row by page row, so a run of changed glyphs streams on
+        // without a new address
+        for (u8 p = 0; p < desc.pages && page + p < GLCD_PAGES; p++)
+        {
+            u8 ended = 0;
+
+            for (u8 i = 0; i < count; i++)
+            {
+                char c = ended ? '\0' : text[i];
+
+                if (c == '\0')
+                {
+                    // Past the new end: only old glyphs still need blanking
+                    ended = 1;
+                    if (i >= old_len) break;
+                }
+                if (!FONT_u8Has(&desc, c)) c = ' ';
+
+                if (i < old_len && shown[i] == c) continue;
+                GLCD_voidGotoXY(page + p, i * advance);
+                GLCD_voidDrawGlyph(&desc, c, p);
+            }
+        }
+
+        // Trailing blanks carry no information, keep the line as short as the text
+        for (u8 i = 0; i < count && text[i] != '\0'; i++)
+        {
+            shown[i] = FONT_u8Has(&desc, text[i]) ? text[i] : ' ';
+            if (shown[i] != ' ') len = i + 1;
+        }
+        shown[len] = '\0';
+        return;
+    }
+#endif
+
+    // Uncached page: every glyph, then blank to the end of the line
+    for (u8 p = 0; p < desc.pages && page + p < GLCD_PAGES; p++)
+    {
+        u8 ended = 0;
+
+        GLCD_voidGotoXY(page + p, 0);
+        for (u8 i = 0; i < count; i++)
+        {
+            if (!ended && text[i] == '\0') ended = 1;
+            GLCD_voidDrawGlyph(&desc, ended ? ' ' : text[i], p);
+        }
+    }
+}
+
 /* Display number at current position */
 void GLCD_voidDisplayNumber(u32 num)
 {
-    char buf[12];
+    char buf[FMT_FIXED_MAX];
     // Convert number to string
-    sprintf(buf, "%lu", num);
+    FMT_u8Unsigned(buf, num);
     // Display the string
     GLCD_voidDisplayString((u8*)buf);
 }
 
+/* Display fixed-point number (num = value * 10^decimals) at current position */
+void GLCD_voidDisplayFixed(u32 num, u8 decimals)
+{
+    char buf[FMT_FIXED_MAX];
+    FMT_u8Fixed(buf, num, decimals);
+    GLCD_voidDisplayString((u8*)buf);
+}
+
 /* Clear entire display */
 void GLCD_voidClear(void)
 {
@@ -228,51 +595,250 @@ void GLCD_voidClear(void)
         // Clear both chips
         for (u8 chip = 1; chip <= 2; chip++)
         {
-            // Set page address
-            GLCD_voidCommand(0xB8 | page, chip);
-            // Set column to 0
-            GLCD_voidCommand(0x40, chip);
+#if GLCD_ASYNC_ENABLE
+            // No bytes to store: one fill transfer per chip page
+            GLCD_voidQueue(chip | GLCD_XFER_FILL, page, 0, 0, GLCD_CHIP_WIDTH, 0x00);
+#else
+            // Page address, column 0 (after 64 writes the column is back at 0)
+            GLCD_u8SetAddress(chip, page, 0);
 
             // Clear all 64 columns in this page
             for (u8 col = 0; col < 64; col++)
             {
-                GLCD_voidWriteData(0x00, chip);
+                GLCD_voidBusData(0x00, chip);
             }
+#endif
         }
     }
     // Reset cursor to top-left
-    current_page = 0;
+    current_page = GLCD_PHYS_PAGE(0);
     current_col = 0;
+
+#if GLCD_TEXT_LINES > 0
+    memset(text_shown, 0, sizeof(text_shown));
+#endif
+
+#if GLCD_FRAMEBUFFER_ENABLE
+    // Display is blank now, so is the shadow and nothing is pending
+    memset(fb, 0, sizeof(fb));
+    memset(fb_dirty_lo, GLCD_FB_CLEAN, sizeof(fb_dirty_lo));
+    memset(fb_dirty_hi, 0, sizeof(fb_dirty_hi));
+#endif
+#if GLCD_ASYNC_ENABLE
+    q_deferred = 0;
+#endif
+}
+
+#if GLCD_FRAMEBUFFER_ENABLE
+
+/* Grow the dirty range of one page to cover a column */
+static void GLCD_voidFbMarkDirty(u8 page, u8 col)
+{
+    u8 chip = (col < GLCD_CHIP_WIDTH) ? 0 : 1;
+    u8 local_col = col & (GLCD_CHIP_WIDTH - 1);
+
+    if (fb_dirty_lo[page][chip] == GLCD_FB_CLEAN || local_col < fb_dirty_lo[page][chip])
+        fb_dirty_lo[page][chip] = local_col;
+    if (local_col > fb_dirty_hi[page][chip])
+        fb_dirty_hi[page][chip] = local_col;
+}
+
+/* Replace a display RAM page byte, only dirtying it if the value changes */
+static void GLCD_voidFbPut(u8 phys_page, u8 col, u8 data)
+{
+    if (fb[phys_page][col] == data) return;
+    fb[phys_page][col] = data;
+    GLCD_voidFbMarkDirty(phys_page, col);
+}
+
+/* Clear the whole framebuffer */
+void GLCD_voidFbClear(void)
+{
+    GLCD_voidFbClearPages(0, GLCD_PAGES - 1);
+}
+
+/* Clear pages first..last across all columns (only non-blank bytes become dirty) */
+void GLCD_voidFbClearPages(u8 first, u8 last)
+{
+    for (u8 page = first; page <= last && page < GLCD_PAGES; page++)
+    {
+        for (u8 col = 0; col < GLCD_WIDTH; col++)
+        {
+            GLCD_voidFbWriteByte(page, col, 0x00);
+        }
+    }
+}
+
+/* Set one pixel */
+void GLCD_voidFbSetPixel(u8 x, u8 y)
+{
+    if (x >= GLCD_WIDTH || y >= GLCD_HEIGHT) return;
+    GLCD_voidFbOrByte(y >> 3, x, GLCD_GEO_MASK(y));
+}
+
+/* Clear one pixel */
+void GLCD_voidFbClearPixel(u8 x, u8 y)
+{
+    if (x >= GLCD_WIDTH || y >= GLCD_HEIGHT) return;
+    u8 page = GLCD_PHYS_PAGE(y >> 3);
+    GLCD_voidFbPut(page, x, fb[page][x] & ~GLCD_GEO_MASK(y));
 }
 
-/* Read data from GLCD display RAM */
-uint8_t GLCD_u8ReadData(u8 cs)
-{
-	// Set RS high for data mode
-	DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_RS_PIN, 1);
-	// Set RW high for read mode
-	DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_RW_PIN, 1);
-	
-	// Set data port pins as INPUT (read mode)
-	DIO_voidSetPortDirection(GLCD_DATA_PORT, 0x00);
-	
-	// Select appropriate chip
-	DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_CS1_PIN, (cs == 1) ? 1 : 0);
-	DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_CS2_PIN, (cs == 2) ? 1 : 0);
-	
-	// Generate enable pulse
-	DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_EN_PIN, 1);
-	_delay_us(5);
-	uint8_t data = DIO_u8GetPortValue(GLCD_DATA_PORT);
-	DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_EN_PIN, 0);
-	
-	// Set data port back to OUTPUT
-	DIO_voidSetPortDirection(GLCD_DATA_PORT, 0xFF);
-	
-	// Deselect both chips
-	DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_CS1_PIN, 0);
-	DIO_voidSetPinValue(GLCD_CTRL_PORT, GLCD_CS2_PIN, 0);
-	_delay_us(5);
-	
-	return data;
+/* Replace a page byte, only dirtying it if the value changes */
+void GLCD_voidFbWriteByte(u8 page, u8 col, u8 data)
+{
+    if (page >= GLCD_PAGES || col >= GLCD_WIDTH) return;
+    GLCD_voidFbPut(GLCD_PHYS_PAGE(page), col, data);
+}
+
+/* OR bits into a page byte */
+void GLCD_voidFbOrByte(u8 page, u8 col, u8 mask)
+{
+    if (page >= GLCD_PAGES || col >= GLCD_WIDTH) return;
+    page = GLCD_PHYS_PAGE(page);
+    GLCD_voidFbPut(page, col, fb[page][col] | mask);
+}
+
+/* Read a page byte back from the shadow */
+u8 GLCD_u8FbReadByte(u8 page, u8 col)
+{
+    if (page >= GLCD_PAGES || col >= GLCD_WIDTH) return 0;
+    return fb[GLCD_PHYS_PAGE(page)][col];
+}
+
+/* Draw a string into the framebuffer (6 columns per character, clipped at
+   the right border); characters outside the font are skipped */
+void GLCD_voidFbDisplayString(u8 page, u8 col, const u8 *str)
+{
+    GLCD_voidFbDisplayText(&FONT_5x7, page, col, (const char *)str);
+}
+
+void GLCD_voidFbDisplayText(const FONT_t *font, u8 page, u8 col, const char *text)
+{
+    FONT_t desc;
+    u8 cols[FONT_MAX_ADVANCE];
+
+    FONT_voidLoad(font, &desc);
+    for (u8 p = 0; p < desc.pages && page + p < GLCD_PAGES; p++)
+    {
+        u8 phys = GLCD_PHYS_PAGE(page + p);
+        u8 x = col;
+
+        for (const char *c = text; *c && x < GLCD_WIDTH; c++)
+        {
+            if (!FONT_u8Has(&desc, *c)) continue;
+
+            u8 n = FONT_u8Columns(&desc, *c, p, cols);
+            for (u8 i = 0; i < n && x < GLCD_WIDTH; i++, x++)
+                GLCD_voidFbPut(phys, x, cols[i]);
+        }
+    }
+}
+
+/* Push dirty ranges: one page + one column command per range, then the
+   controller's column auto-increment streams the bytes */
+void GLCD_voidFlush(void)
+{
+#if GLCD_ASYNC_ENABLE
+    q_deferred = 0;
+#endif
+
+    for (u8 page = 0; page < GLCD_PAGES; page++)
+    {
+        for (u8 chip = 0; chip < GLCD_CHIPS; chip++)
+        {
+            u8 lo = fb_dirty_lo[page][chip];
+            if (lo == GLCD_FB_CLEAN) continue;
+
+            u8 hi = fb_dirty_hi[page][chip];
+            const u8 *src = &fb[page][chip * GLCD_CHIP_WIDTH];
+
+#if GLCD_ASYNC_ENABLE
+            // Queue what fits and never wait: the rest stays dirty for the
+            // next flush, so a large redraw cannot stall the caller
+            while (lo <= hi && GLCD_u8HasRoom(1))
+            {
+                u8 n = hi - lo + 1;
+                if (n > GLCD_u8FreeBytes()) n = GLCD_u8FreeBytes();
+                GLCD_voidQueue(chip + 1, page, lo, &src[lo], n, 0);
+                lo += n;
+            }
+            if (lo <= hi)
+            {
+                fb_dirty_lo[page][chip] = lo;
+                q_deferred = 1;
+                q_stats.deferred++;
+                return;
+            }
+#else
+            GLCD_u8SetAddress(chip + 1, page, lo);
+            for (u8 col = lo; col <= hi; col++)
+                GLCD_voidBusData(src[col], chip + 1);
+#endif
+
+            fb_dirty_lo[page][chip] = GLCD_FB_CLEAN;
+            fb_dirty_hi[page][chip] = 0;
+        }
+    }
+}
+
+#endif /* GLCD_FRAMEBUFFER_ENABLE */
+
+#if GLCD_ASYNC_ENABLE
+
+/* Tick task: one budget of bus cycles, unless a writer is draining already */
+void GLCD_voidTick(void)
+{
+    if (q_draining)
+        return;
+    q_draining = 1;
+    GLCD_voidDrain();
+    q_draining = 0;
+}
+
+u8 GLCD_u8FrameDone(void)
+{
+    return q_tail == q_head && !q_deferred;
+}
+
+/* Data bytes plus one address cycle per transfer (an upper bound) */
+u16 GLCD_u16Backlog(void)
+{
+    u16 total = 0;
+    u8 sreg = SREG_REG;
+
+    cli();
+    for (u8 i = q_tail; i != q_head; i = (i + 1) & GLCD_QUEUE_MASK)
+        total += queue[i].len + 1;
+    SREG_REG = sreg;
+    return total;
 }
+
+void GLCD_voidSync(void)
+{
+    while (q_tail != q_head)
+        GLCD_voidDrainHere();
+}
+
+void GLCD_voidGetQueueStats(GLCD_QueueStats_t *stats)
+{
+    *stats = q_stats;
+}
+
+#endif /* GLCD_ASYNC_ENABLE */
+
+#if GLCD_BUS_STATS_ENABLE
+
+/* Copy out the bus counters */
+void GLCD_voidGetBusStats(GLCD_BusStats_t *stats)
+{
+    *stats = bus_stats;
+}
+
+/* Start a new measurement window */
+void GLCD_voidResetBusStats(void)
+{
+    memset(&bus_stats, 0, sizeof(bus_stats));
+}
+
+#endif /* GLCD_BUS_STATS_ENABLE */
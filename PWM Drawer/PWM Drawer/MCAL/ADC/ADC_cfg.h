@@ -0,0 +1,48 @@
+#ifndef ADC_CFG_H_
+#define ADC_CFG_H_
+
+/* ADC (timer-triggered analog acquisition) Configuration */
+
+/* 1: analog trace in place of the edge plot. The inputs ADC0-ADC7 are PA0-PA7,
+   the GLCD data bus on the default board, so the bus has to move to another
+   port first (main.c checks). Timer0 paces the conversions, so this excludes
+   FCNT_ENABLE, which gates its counter with Timer0 */
+#ifndef ADC_ENABLE
+#define ADC_ENABLE 0
+#endif
+
+// Input channel (0-7 = ADC0 on PA0 ... ADC7 on PA7)
+#define ADC_CHANNEL 0
+
+// Reference: 0 = AREF pin, 1 = AVCC (capacitor on AREF), 3 = internal 2.56 V
+#define ADC_REFERENCE 1
+
+// ADC clock = F_CPU / ADC_PRESCALER (2-128): 16 -> 1 MHz, one triggered
+// conversion every 13.5 us. That is above the 200 kHz the 10-bit result is
+// specified for, but only the 8 left-adjusted bits are read
+#define ADC_PRESCALER 16
+
+// Shortest sample interval in CPU cycles. The trigger (Timer0 compare flag)
+// must be cleared by the ISR before the next compare match, so the interval
+// covers the conversion (13.5 ADC clocks = 216 cycles) plus ISR latency
+#define ADC_MIN_INTERVAL 320
+
+// Most samples folded into one plot column; slower timebases sample slower
+// rather than spend more ISR time per column
+#define ADC_MAX_PER_COLUMN 64
+
+// Record length in columns (min / max pairs, 2 bytes each, power of two)
+// and how many of them come before the trigger
+#define ADC_COLUMNS     128
+#define ADC_PRETRIGGER  16
+
+// Auto trigger: without a trigger for this many columns the record is taken
+// anyway, so a flat or out-of-range input still shows (0 = wait forever)
+#define ADC_AUTO_COLUMNS 256
+
+// Trigger hysteresis in 8-bit counts: a rising trigger arms only once the
+// input has been this far below the level (above it for falling), so noise
+// riding on the level does not retrigger
+#define ADC_TRIGGER_HYST 8
+
+#endif /* ADC_CFG_H_ */
@@ -0,0 +1,72 @@
+#include "../../Service/std_types.h"
+
+#ifndef ADC_INTERFACE_H_
+#define ADC_INTERFACE_H_
+
+/* ADC (timer-triggered analog acquisition) Interface
+   Timer0 compare matches start conversions (auto trigger), the ADC
+   interrupt reads the left-adjusted 8-bit result. Samples are folded into
+   plot columns as they arrive: peak detect keeps the lowest and highest
+   sample of each column, so a spike shorter than a column still shows;
+   decimation keeps the first one. Columns go into a ring that always holds
+   the last ADC_COLUMNS of them. Once the trigger (level and edge, checked
+   on every sample) has fired and the columns after it are in, the record
+   holds ADC_PRETRIGGER columns before the trigger column and the rest after
+   it, and acquisition stops until the record is taken (ADC_voidArm). */
+
+// Trigger edge
+#define ADC_EDGE_RISING   0
+#define ADC_EDGE_FALLING  1
+#define ADC_EDGE_NONE     2     // Free run: every record is taken at once
+
+// Column folding
+#define ADC_FOLD_PEAK      0    // Lowest and highest sample of the column
+#define ADC_FOLD_DECIMATE  1    // First sample of the column only
+
+// One plot column of the record (8-bit samples)
+typedef struct
+{
+    u8 min;
+    u8 max;
+} ADC_Column_t;
+
+// Acquisition counters
+typedef struct
+{
+    u32 samples;     // Conversions read
+    u16 records;     // Records completed
+    u16 forced;      // Of those, taken by the auto trigger
+} ADC_Stats_t;
+
+/* Function Prototypes for ADC Operations */
+
+// ADC on the configured channel with auto trigger from Timer0, Timer0 stopped
+void ADC_voidInit(void);
+
+// Sample so that one column covers Copy_u32ColumnCycles CPU cycles, then
+// start the first record. Returns the column time actually used: the timer
+// rounds it, and it is never shorter than one ADC_MIN_INTERVAL
+u32 ADC_u32Start(u32 Copy_u32ColumnCycles, u8 Copy_u8Fold);
+
+// Stop sampling (the record in progress is abandoned)
+void ADC_voidStop(void);
+
+// Trigger level (8-bit counts) and edge; applies from the next record
+void ADC_voidSetTrigger(u8 Copy_u8Level, u8 Copy_u8Edge);
+
+// 1 once the record is complete and sampling has stopped
+u8 ADC_u8RecordReady(void);
+
+// Column Copy_u8Index of a complete record, 0 = oldest (leftmost)
+void ADC_voidGetColumn(u8 Copy_u8Index, ADC_Column_t *Copy_pColumn);
+
+// 1 if the complete record was triggered, 0 if the auto trigger took it
+u8 ADC_u8Triggered(void);
+
+// Drop the complete record and acquire the next one
+void ADC_voidArm(void);
+
+// Snapshot of the counters (taken with interrupts masked)
+void ADC_voidGetStats(ADC_Stats_t *Copy_pStats);
+
+#endif /* ADC_INTERFACE_H_ */
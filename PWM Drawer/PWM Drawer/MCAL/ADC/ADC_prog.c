@@ -0,0 +1,311 @@
+#include <avr/interrupt.h>
+#include "../../Service/std_types.h"
+#include "../../Service/bit_math.h"
+#include "../reg_def.h"
+#include "../DIO/DIO_interface.h"
+#include "ADC_interface.h"
+#include "ADC_cfg.h"
+
+#if ADC_ENABLE
+
+#define ADC_COLUMN_MASK (ADC_COLUMNS - 1)
+
+#if (ADC_COLUMNS & ADC_COLUMN_MASK) != 0 || ADC_COLUMNS > 128
+#error "ADC_COLUMNS must be a power of two no larger than 128"
+#endif
+#if ADC_PRETRIGGER > ADC_COLUMNS - 2
+#error "ADC_PRETRIGGER must leave room for the trigger column and one after it"
+#endif
+
+// ADPS2:0 for ADC_PRESCALER
+#if ADC_PRESCALER == 2
+#define ADC_ADPS 1
+#elif ADC_PRESCALER == 4
+#define ADC_ADPS 2
+#elif ADC_PRESCALER == 8
+#define ADC_ADPS 3
+#elif ADC_PRESCALER == 16
+#define ADC_ADPS 4
+#elif ADC_PRESCALER == 32
+#define ADC_ADPS 5
+#elif ADC_PRESCALER == 64
+#define ADC_ADPS 6
+#elif ADC_PRESCALER == 128
+#define ADC_ADPS 7
+#else
+#error "ADC_PRESCALER must be a power of two from 2 to 128"
+#endif
+
+// Auto trigger source ADTS2:0 = 3: Timer0 compare match
+#define ADC_ADTS_TIMER0_COMP 3
+
+// Enabled, auto triggered, interrupting; writing ADIF = 1 clears a stale flag
+#define ADC_ADCSRA_RUN ((1 << ADC_ADCSRA_ADEN) | (1 << ADC_ADCSRA_ADATE) | (1 << ADC_ADCSRA_ADIE) | \
+                        (1 << ADC_ADCSRA_ADIF) | (ADC_ADPS << ADC_ADCSRA_ADPS0))
+
+// Timer0 in CTC mode, clock off
+#define ADC_T0_STOPPED (1 << TIMER0_TCCR0_WGM01)
+
+// Acquisition state
+#define ADC_IDLE     0     // Not sampling
+#define ADC_FILLING  1     // Collecting the pre-trigger columns
+#define ADC_ARMED    2     // Watching for the trigger
+#define ADC_POST     3     // Collecting the columns after the trigger
+#define ADC_DONE     4     // Record complete, sampling stopped
+
+/* Record ring: the ISR writes it while sampling, the main loop reads it only
+   once the state is ADC_DONE, when the ISR no longer runs */
+static ADC_Column_t ring[ADC_COLUMNS];
+static u8 head = 0;                      // Next column to write = oldest column
+
+static volatile u8 state = ADC_IDLE;
+static volatile u8 triggered = 0;
+static volatile ADC_Stats_t stats;
+
+/* Set by ADC_u32Start / ADC_voidSetTrigger, latched by ADC_voidArm */
+static u8 timer_clock = 0;               // Timer0 CS02:0, 0 = never started
+static u8 per_column = 1;
+static u8 fold = ADC_FOLD_PEAK;
+static u8 next_level = 128;
+static u8 next_edge = ADC_EDGE_RISING;
+
+/* ISR-side state for the record in progress */
+static u8  trig_level, arm_level, edge;
+static u8  primed = 0;                   // Input has been on the arming side of the level
+static u8  hit = 0;                      // Trigger seen in the open column
+static u8  fold_count = 0;               // Samples in the open column
+static u8  col_min, col_max;
+static u8  filled = 0;                   // Pre-trigger columns collected
+static u8  remaining = 0;                // Columns still to come after the trigger
+static u16 waited = 0;                   // Columns spent armed (auto trigger)
+
+/* Conversion complete. It was started by OCF0 going high: the flag is
+   cleared first, or the next compare match could not start another one */
+ISR(ADC_vect)
+{
+    u8 sample = ADC_ADCH_REG;
+
+    TIMER0_TIFR_REG = (1 << TIMER0_TIFR_OCF0);
+    stats.samples++;
+
+    if (fold_count == 0)
+    {
+        col_min = col_max = sample;
+    }
+    else if (fold == ADC_FOLD_PEAK)
+    {
+        if (sample < col_min) col_min = sample;
+        if (sample > col_max) col_max = sample;
+    }
+
+    if (state == ADC_ARMED && !hit)
+    {
+        if (edge == ADC_EDGE_NONE)
+            hit = 1;
+        else if (!primed)
+            primed = (edge == ADC_EDGE_RISING) ? (sample <= arm_level) : (sample >= arm_level);
+        else if ((edge == ADC_EDGE_RISING) ? (sample >= trig_level) : (sample <= trig_level))
+            hit = 1;
+    }
+
+    if (++fold_count < per_column)
+        return;
+    fold_count = 0;
+
+    ring[head].min = col_min;
+    ring[head].max = col_max;
+    head = (head + 1) & ADC_COLUMN_MASK;
+
+    switch (state)
+    {
+    case ADC_FILLING:
+        if (++filled >= ADC_PRETRIGGER)
+            state = ADC_ARMED;
+        break;
+
+    case ADC_ARMED:
+        // The column just closed is the trigger column
+        if (hit || (ADC_AUTO_COLUMNS != 0 && ++waited >= ADC_AUTO_COLUMNS))
+        {
+            triggered = hit;
+            remaining = ADC_COLUMNS - ADC_PRETRIGGER - 1;
+            state = ADC_POST;
+        }
+        break;
+
+    case ADC_POST:
+        if (--remaining == 0)
+        {
+            TIMER0_TCCR0_REG = ADC_T0_STOPPED;
+            state = ADC_DONE;
+            stats.records++;
+            if (!triggered) stats.forced++;
+        }
+        break;
+    }
+}
+
+/* Input pin without pull-up, AVCC / AREF reference, left-adjusted result,
+   conversions started by Timer0 compare matches (Timer0 left stopped) */
+void ADC_voidInit(void)
+{
+    u8 sreg = SREG_REG;
+    cli();
+
+    DIO_voidSetPinDirection(DIO_PORTA, ADC_CHANNEL, DIO_PIN_INPUT);
+    ADC_ADMUX_REG = (ADC_REFERENCE << ADC_ADMUX_REFS0) | (1 << ADC_ADMUX_ADLAR) | ADC_CHANNEL;
+    ADC_SFIOR_REG = (ADC_SFIOR_REG & ~(7 << ADC_SFIOR_ADTS0)) | (ADC_ADTS_TIMER0_COMP << ADC_SFIOR_ADTS0);
+    TIMER0_TCCR0_REG = ADC_T0_STOPPED;
+    TIMER0_TIFR_REG = (1 << TIMER0_TIFR_OCF0);
+    ADC_ADCSRA_REG = ADC_ADCSRA_RUN;
+    state = ADC_IDLE;
+
+    SREG_REG = sreg;
+}
+
+/* Timer0 prescaler (returned) and clock select bits for a sample interval */
+static u16 ADC_u16Prescaler(u32 Copy_u32Interval, u8 *Copy_pu8Clock)
+{
+    // Finest prescaler that reaches the interval in 8 bits
+    if (Copy_u32Interval <= 8UL * 256)
+    {
+        *Copy_pu8Clock = (1 << TIMER0_TCCR0_CS01);
+        return 8;
+    }
+    if (Copy_u32Interval <= 64UL * 256)
+    {
+        *Copy_pu8Clock = (1 << TIMER0_TCCR0_CS01) | (1 << TIMER0_TCCR0_CS00);
+        return 64;
+    }
+    if (Copy_u32Interval <= 256UL * 256)
+    {
+        *Copy_pu8Clock = (1 << TIMER0_TCCR0_CS02);
+        return 256;
+    }
+    *Copy_pu8Clock = (1 << TIMER0_TCCR0_CS02) | (1 << TIMER0_TCCR0_CS00);
+    return 1024;
+}
+
+/* Samples per column and Timer0 period: of the sample counts the minimum
+   interval allows, the one whose column time comes closest (most samples
+   on a tie, for peak detect) */
+u32 ADC_u32Start(u32 Copy_u32ColumnCycles, u8 Copy_u8Fold)
+{
+    u32 most = Copy_u32ColumnCycles / ADC_MIN_INTERVAL;
+    u32 best_column = 0, best_err = 0xFFFFFFFFUL;
+    u8  best_per = 1, best_ocr = 0, best_clock = 0;
+
+    if (most < 1) most = 1;
+    if (most > ADC_MAX_PER_COLUMN) most = ADC_MAX_PER_COLUMN;
+
+    for (u8 per = (u8)most; per >= 1 && best_err != 0; per--)
+    {
+        u32 interval = Copy_u32ColumnCycles / per;
+        u8 clock;
+        u16 presc;
+
+        if (interval < ADC_MIN_INTERVAL) interval = ADC_MIN_INTERVAL;
+        if (interval > 1024UL * 256) interval = 1024UL * 256;
+        presc = ADC_u16Prescaler(interval, &clock);
+
+        u32 ticks = (interval + presc / 2) / presc;
+        if (ticks < 1) ticks = 1;
+        if (ticks > 256) ticks = 256;
+        u32 column = per * presc * ticks;
+        u32 err = (column > Copy_u32ColumnCycles) ? column - Copy_u32ColumnCycles
+                                                  : Copy_u32ColumnCycles - column;
+        if (err < best_err)
+        {
+            best_err = err;
+            best_column = column;
+            best_per = per;
+            best_ocr = (u8)(ticks - 1);
+            best_clock = clock;
+        }
+    }
+
+    u8 sreg = SREG_REG;
+    cli();
+    TIMER0_TCCR0_REG = ADC_T0_STOPPED;
+    TIMER0_OCR0_REG = best_ocr;
+    timer_clock = best_clock;
+    per_column = best_per;
+    fold = Copy_u8Fold;
+    SREG_REG = sreg;
+
+    ADC_voidArm();
+    return best_column;
+}
+
+void ADC_voidStop(void)
+{
+    u8 sreg = SREG_REG;
+    cli();
+    TIMER0_TCCR0_REG = ADC_T0_STOPPED;
+    state = ADC_IDLE;
+    SREG_REG = sreg;
+}
+
+void ADC_voidSetTrigger(u8 Copy_u8Level, u8 Copy_u8Edge)
+{
+    next_level = Copy_u8Level;
+    next_edge = Copy_u8Edge;
+}
+
+u8 ADC_u8RecordReady(void)
+{
+    return state == ADC_DONE;
+}
+
+void ADC_voidGetColumn(u8 Copy_u8Index, ADC_Column_t *Copy_pColumn)
+{
+    *Copy_pColumn = ring[(head + Copy_u8Index) & ADC_COLUMN_MASK];
+}
+
+u8 ADC_u8Triggered(void)
+{
+    return triggered;
+}
+
+void ADC_voidArm(void)
+{
+    u8 sreg = SREG_REG;
+    cli();
+
+    TIMER0_TCCR0_REG = ADC_T0_STOPPED;
+
+    edge = next_edge;
+    trig_level = next_level;
+    if (edge == ADC_EDGE_RISING)
+        arm_level = (trig_level > ADC_TRIGGER_HYST) ? trig_level - ADC_TRIGGER_HYST : 0;
+    else
+        arm_level = (trig_level < 255 - ADC_TRIGGER_HYST) ? trig_level + ADC_TRIGGER_HYST : 255;
+    primed = hit = 0;
+    fold_count = filled = 0;
+    waited = 0;
+    head = 0;
+    state = (ADC_PRETRIGGER > 0) ? ADC_FILLING : ADC_ARMED;
+
+    // Start from a clean trigger: counter at 0, no stale compare or ADC flag
+    TIMER0_TCNT0_REG = 0;
+    TIMER0_TIFR_REG = (1 << TIMER0_TIFR_OCF0);
+    ADC_ADCSRA_REG = ADC_ADCSRA_RUN;
+    if (timer_clock != 0)
+        TIMER0_TCCR0_REG = ADC_T0_STOPPED | timer_clock;
+    else
+        state = ADC_IDLE;
+
+    SREG_REG = sreg;
+}
+
+void ADC_voidGetStats(ADC_Stats_t *Copy_pStats)
+{
+    u8 sreg = SREG_REG;
+    cli();
+    Copy_pStats->samples = stats.samples;
+    Copy_pStats->records = stats.records;
+    Copy_pStats->forced = stats.forced;
+    SREG_REG = sreg;
+}
+
+#endif /* ADC_ENABLE */
@@ -0,0 +1,77 @@
+#include "../../Service/std_types.h"
+#include "../../Service/bit_math.h"
+#include "../reg_def.h"
+
+#ifndef DIO_FAST_H_
+#define DIO_FAST_H_
+
+/* DIO fast path - header only
+   For hot callers (GLCD bus cycles) whose port and pin are compile-time
+   constants, e.g. from GLCD_cfg.h. Once inlined the address arithmetic folds
+   away and each call becomes a single sbi / cbi / out (masked writes are one
+   in / andi / ori / out). There is no range checking: pass DIO_PORTx /
+   DIO_PIN_x constants. Everything else keeps using DIO_interface.h.
+
+   Read-modify-write helpers are not atomic against ISRs that write the same
+   port; sbi/cbi on a constant pin are. */
+
+#define DIO_FAST_INLINE static inline __attribute__((always_inline))
+
+// Register addresses by port number (A = 0 .. D = 3, each port 3 bytes lower)
+#define DIO_FAST_PIN_ADDR(port)  (0x39 - 3 * (port))
+#define DIO_FAST_DDR_ADDR(port)  (0x3A - 3 * (port))
+#define DIO_FAST_PORT_ADDR(port) (0x3B - 3 * (port))
+
+// Drive one output pin high
+DIO_FAST_INLINE void DIO_voidFastSetPin(u8 Copy_u8PortID, u8 Copy_u8PinID)
+{
+    SET_BIT(REG8(DIO_FAST_PORT_ADDR(Copy_u8PortID)), Copy_u8PinID);
+}
+
+// Drive one output pin low
+DIO_FAST_INLINE void DIO_voidFastClrPin(u8 Copy_u8PortID, u8 Copy_u8PinID)
+{
+    CLR_BIT(REG8(DIO_FAST_PORT_ADDR(Copy_u8PortID)), Copy_u8PinID);
+}
+
+// Drive one output pin to Copy_u8Val (a constant value collapses to sbi or cbi)
+DIO_FAST_INLINE void DIO_voidFastSetPinValue(u8 Copy_u8PortID, u8 Copy_u8PinID, u8 Copy_u8Val)
+{
+    if (Copy_u8Val)
+        DIO_voidFastSetPin(Copy_u8PortID, Copy_u8PinID);
+    else
+        DIO_voidFastClrPin(Copy_u8PortID, Copy_u8PinID);
+}
+
+// Write a whole port in one store
+DIO_FAST_INLINE void DIO_voidFastSetPortValue(u8 Copy_u8PortID, u8 Copy_u8Val)
+{
+    REG8(DIO_FAST_PORT_ADDR(Copy_u8PortID)) = Copy_u8Val;
+}
+
+// Change only the pins in Copy_u8Mask, all in one store
+DIO_FAST_INLINE void DIO_voidFastSetPortMasked(u8 Copy_u8PortID, u8 Copy_u8Mask, u8 Copy_u8Val)
+{
+    u8 port = REG8(DIO_FAST_PORT_ADDR(Copy_u8PortID));
+    REG8(DIO_FAST_PORT_ADDR(Copy_u8PortID)) = (port & ~Copy_u8Mask) | (Copy_u8Val & Copy_u8Mask);
+}
+
+// Set a whole port's direction (DIO_PORT_OUTPUT / DIO_PORT_INPUT or a bit mask)
+DIO_FAST_INLINE void DIO_voidFastSetPortDirection(u8 Copy_u8PortID, u8 Copy_u8Dir)
+{
+    REG8(DIO_FAST_DDR_ADDR(Copy_u8PortID)) = Copy_u8Dir;
+}
+
+// Read one input pin (0 or 1)
+DIO_FAST_INLINE u8 DIO_u8FastGetPinValue(u8 Copy_u8PortID, u8 Copy_u8PinID)
+{
+    return GET_BIT(REG8(DIO_FAST_PIN_ADDR(Copy_u8PortID)), Copy_u8PinID);
+}
+
+// Read a whole port's input pins
+DIO_FAST_INLINE u8 DIO_u8FastGetPortValue(u8 Copy_u8PortID)
+{
+    return REG8(DIO_FAST_PIN_ADDR(Copy_u8PortID));
+}
+
+#endif /* DIO_FAST_H_ */
@@ -0,0 +1,29 @@
+#ifndef EXTI_CFG_H_
+#define EXTI_CFG_H_
+
+/* EXTI (external interrupt edge timestamping) Configuration */
+
+/* 1: extra input channels on INT0 (PD2), INT1 (PD3) and INT2 (PB2),
+   timestamped against Timer1 alongside ICP1. Off by default: the display
+   switches to the per-channel layout when it is on */
+#ifndef EXTI_ENABLE
+#define EXTI_ENABLE 0
+#endif
+
+// Channels in use (1 = on). INT2 shares PB2 with GLCD EN on the default
+// board, so it stays off unless the GLCD control lines were moved
+#ifndef EXTI_INT0_ENABLE
+#define EXTI_INT0_ENABLE 1
+#endif
+#ifndef EXTI_INT1_ENABLE
+#define EXTI_INT1_ENABLE 1
+#endif
+#ifndef EXTI_INT2_ENABLE
+#define EXTI_INT2_ENABLE 0
+#endif
+
+// Edge records buffered per channel (power of two, max 128); 5 bytes each.
+// Must cover the edges arriving while the main loop draws a frame
+#define EXTI_RING_SIZE 16
+
+#endif /* EXTI_CFG_H_ */
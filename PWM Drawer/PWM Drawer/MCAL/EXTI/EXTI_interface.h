@@ -0,0 +1,47 @@
+#include "../../Service/std_types.h"
+#include "../ICU/ICU_interface.h"
+
+#ifndef EXTI_INTERFACE_H_
+#define EXTI_INTERFACE_H_
+
+/* EXTI (external interrupt edge timestamping) Interface
+   INT0, INT1 and INT2 interrupt on both edges of their pin; each ISR stamps
+   the edge with ICU_u32Now() (the Timer1 time base ICP1 captures use) and
+   queues it in a per-channel ring, in the same ICU_Edge_t records. Unlike
+   ICP1 the timestamp is taken in software, so it carries the interrupt
+   latency: whatever ISR was running when the edge came delays it. */
+
+// Channel numbers
+#define EXTI_INT0     0   // PD2
+#define EXTI_INT1     1   // PD3
+#define EXTI_INT2     2   // PB2
+#define EXTI_CHANNELS 3
+
+// Per-channel health counters
+typedef struct
+{
+    u32 captured;    // Edges stored in the ring
+    u16 overruns;    // Edges dropped because the ring was full
+    u16 missed;      // Same level seen twice in a row: an edge came and went unseen
+    u16 backward;    // Dropped: stamp behind the channel's last one (Timer1 wraps
+                     // not counted yet, TIMER1_OVF starved by the edge ISRs)
+    u8  max_fill;    // Highest ring occupancy seen
+} EXTI_Stats_t;
+
+/* Function Prototypes for EXTI Operations */
+
+// Configure the enabled channels as inputs and enable their interrupts
+// (Timer1 must be running: call after ICU_voidInit)
+void EXTI_voidInit(void);
+
+// Edges waiting on one channel / on all of them
+u8 EXTI_u8Available(u8 Copy_u8Channel);
+u8 EXTI_u8Pending(void);
+
+// Move up to Copy_u8Max edges of a channel into Copy_pEdges (oldest first), return how many
+u8 EXTI_u8ReadEdges(u8 Copy_u8Channel, ICU_Edge_t *Copy_pEdges, u8 Copy_u8Max);
+
+// Snapshot of a channel's health counters (taken with interrupts masked)
+void EXTI_voidGetStats(u8 Copy_u8Channel, EXTI_Stats_t *Copy_pStats);
+
+#endif /* EXTI_INTERFACE_H_ */
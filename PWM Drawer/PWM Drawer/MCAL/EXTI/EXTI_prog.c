@@ -0,0 +1,220 @@
+#include <avr/interrupt.h>
+#include "../../Service/std_types.h"
+#include "../../Service/bit_math.h"
+#include "../reg_def.h"
+#include "../DIO/DIO_interface.h"
+#include "../ICU/ICU_interface.h"
+#include "EXTI_interface.h"
+#include "EXTI_cfg.h"
+
+#if EXTI_ENABLE
+
+#define EXTI_RING_MASK (EXTI_RING_SIZE - 1)
+
+#if (EXTI_RING_SIZE & EXTI_RING_MASK) != 0 || EXTI_RING_SIZE > 128
+#error "EXTI_RING_SIZE must be a power of two no larger than 128"
+#endif
+
+// No level stored yet on a channel
+#define EXTI_NO_LEVEL 0xFF
+
+// A stamp this far ahead of the last one is really behind it
+#define EXTI_BACKWARD 0x80000000UL
+
+/* Rings, one per channel: the ISR only writes ring_head[], the main loop only
+   writes ring_tail[] (single bytes, as in the ICU ring) */
+static volatile ICU_Edge_t ring[EXTI_CHANNELS][EXTI_RING_SIZE];
+static volatile u8 ring_head[EXTI_CHANNELS];
+static volatile u8 ring_tail[EXTI_CHANNELS];
+
+/* Written by the ISRs only */
+static volatile EXTI_Stats_t stats[EXTI_CHANNELS];
+
+/* ISR-side state: pin level, Timer1 clock and timestamp of the last stored
+   edge, and the gap flag carried into the next record */
+static u8 last_level[EXTI_CHANNELS] = { EXTI_NO_LEVEL, EXTI_NO_LEVEL, EXTI_NO_LEVEL };
+static u8 last_clock[EXTI_CHANNELS];
+static u32 last_stamp[EXTI_CHANNELS];
+static u8 pending_gap[EXTI_CHANNELS];
+
+/* Stamp and queue one edge. Inlined into each vector so the timestamp is the
+   first thing the ISR does after its prologue */
+static inline void EXTI_voidStore(u8 Copy_u8Channel, u8 Copy_u8Level)
+{
+    u8 flags;
+    u32 stamp = ICU_u32Now(&flags);
+    u8 clock = (flags & ICU_FLAG_CLOCK_MASK) >> ICU_FLAG_CLOCK_SHIFT;
+    u8 head = ring_head[Copy_u8Channel];
+    u8 next = (head + 1) & EXTI_RING_MASK;
+
+    // Both edges interrupt, so the level has to alternate; the same level
+    // twice means the opposite edge came and went before the ISR read the pin
+    if (Copy_u8Level == last_level[Copy_u8Channel])
+    {
+        stats[Copy_u8Channel].missed++;
+        pending_gap[Copy_u8Channel] = ICU_FLAG_GAP;
+    }
+    last_level[Copy_u8Channel] = Copy_u8Level;
+
+    // Timestamps taken with different prescalers are not comparable
+    if (clock != last_clock[Copy_u8Channel])
+    {
+        last_clock[Copy_u8Channel] = clock;
+        last_stamp[Copy_u8Channel] = stamp;
+        pending_gap[Copy_u8Channel] = ICU_FLAG_GAP;
+    }
+
+    // Timer1 stopped or counting T1 (FCNT): no time base to stamp against
+    if (clock < ICU_CLOCK_DIV1 || clock > ICU_CLOCK_DIV1024)
+    {
+        pending_gap[Copy_u8Channel] = ICU_FLAG_GAP;
+        return;
+    }
+
+    // Once TIMER1_OVF has waited behind the edge ISRs for more than half a
+    // wrap, ICU_u32Now() misses a wrap and stamps land 65536 ticks back; drop
+    // them until the count catches up, the period across them is not real
+    if (stamp - last_stamp[Copy_u8Channel] >= EXTI_BACKWARD)
+    {
+        stats[Copy_u8Channel].backward++;
+        pending_gap[Copy_u8Channel] = ICU_FLAG_GAP;
+        return;
+    }
+
+    if (next == ring_tail[Copy_u8Channel])
+    {
+        stats[Copy_u8Channel].overruns++;
+        pending_gap[Copy_u8Channel] = ICU_FLAG_GAP;
+        return;
+    }
+
+    ring[Copy_u8Channel][head].timestamp = stamp;
+    last_stamp[Copy_u8Channel] = stamp;
+    ring[Copy_u8Channel][head].flags = flags | (Copy_u8Level ? ICU_FLAG_RISING : 0) |
+                                       pending_gap[Copy_u8Channel];
+    pending_gap[Copy_u8Channel] = 0;
+    ring_head[Copy_u8Channel] = next;
+
+    stats[Copy_u8Channel].captured++;
+    u8 fill = (next - ring_tail[Copy_u8Channel]) & EXTI_RING_MASK;
+    if (fill > stats[Copy_u8Channel].max_fill) stats[Copy_u8Channel].max_fill = fill;
+}
+
+#if EXTI_INT0_ENABLE
+/* INT0 senses any logical change; the pin tells which one it was */
+ISR(INT0_vect)
+{
+    EXTI_voidStore(EXTI_INT0, GET_BIT(DIO_PIND_REG, DIO_PIN_2));
+}
+#endif
+
+#if EXTI_INT1_ENABLE
+ISR(INT1_vect)
+{
+    EXTI_voidStore(EXTI_INT1, GET_BIT(DIO_PIND_REG, DIO_PIN_3));
+}
+#endif
+
+#if EXTI_INT2_ENABLE
+/* INT2 only senses one edge: after each one, arm it for the opposite edge.
+   Changing ISC2 can raise INTF2, so the flag is cleared afterwards; an edge
+   that came while switching is caught by reading the pin again */
+ISR(INT2_vect)
+{
+    u8 level = GET_BIT(DIO_PINB_REG, DIO_PIN_2);
+
+    for (;;)
+    {
+        EXTI_voidStore(EXTI_INT2, level);
+
+        if (level)
+            CLR_BIT(EXTI_MCUCSR_REG, EXTI_MCUCSR_ISC2);
+        else
+            SET_BIT(EXTI_MCUCSR_REG, EXTI_MCUCSR_ISC2);
+        EXTI_GIFR_REG = (1 << EXTI_GIFR_INTF2);
+
+        u8 now = GET_BIT(DIO_PINB_REG, DIO_PIN_2);
+        if (now == level)
+            break;
+        level = now;
+    }
+}
+#endif
+
+/* Inputs without pull-ups, both edges sensed, stale flags cleared, then enabled */
+void EXTI_voidInit(void)
+{
+    u8 sreg = SREG_REG;
+    cli();
+
+#if EXTI_INT0_ENABLE
+    DIO_voidSetPinDirection(DIO_PORTD, DIO_PIN_2, DIO_PIN_INPUT);
+    EXTI_MCUCR_REG = (EXTI_MCUCR_REG & ~(3 << EXTI_MCUCR_ISC00)) | (1 << EXTI_MCUCR_ISC00);
+    EXTI_GIFR_REG = (1 << EXTI_GIFR_INTF0);
+    SET_BIT(EXTI_GICR_REG, EXTI_GICR_INT0);
+#endif
+#if EXTI_INT1_ENABLE
+    DIO_voidSetPinDirection(DIO_PORTD, DIO_PIN_3, DIO_PIN_INPUT);
+    EXTI_MCUCR_REG = (EXTI_MCUCR_REG & ~(3 << EXTI_MCUCR_ISC10)) | (1 << EXTI_MCUCR_ISC10);
+    EXTI_GIFR_REG = (1 << EXTI_GIFR_INTF1);
+    SET_BIT(EXTI_GICR_REG, EXTI_GICR_INT1);
+#endif
+#if EXTI_INT2_ENABLE
+    DIO_voidSetPinDirection(DIO_PORTB, DIO_PIN_2, DIO_PIN_INPUT);
+    // First edge: whichever the pin is not at now
+    if (GET_BIT(DIO_PINB_REG, DIO_PIN_2))
+        CLR_BIT(EXTI_MCUCSR_REG, EXTI_MCUCSR_ISC2);
+    else
+        SET_BIT(EXTI_MCUCSR_REG, EXTI_MCUCSR_ISC2);
+    last_level[EXTI_INT2] = GET_BIT(DIO_PINB_REG, DIO_PIN_2);
+    EXTI_GIFR_REG = (1 << EXTI_GIFR_INTF2);
+    SET_BIT(EXTI_GICR_REG, EXTI_GICR_INT2);
+#endif
+
+    SREG_REG = sreg;
+}
+
+u8 EXTI_u8Available(u8 Copy_u8Channel)
+{
+    return (ring_head[Copy_u8Channel] - ring_tail[Copy_u8Channel]) & EXTI_RING_MASK;
+}
+
+u8 EXTI_u8Pending(void)
+{
+    u8 total = 0;
+    for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+        total += EXTI_u8Available(ch);
+    return total;
+}
+
+/* Drain up to Copy_u8Max edges of one channel, oldest first */
+u8 EXTI_u8ReadEdges(u8 Copy_u8Channel, ICU_Edge_t *Copy_pEdges, u8 Copy_u8Max)
+{
+    u8 tail = ring_tail[Copy_u8Channel];
+    u8 head = ring_head[Copy_u8Channel];
+    u8 count = 0;
+
+    while (tail != head && count < Copy_u8Max)
+    {
+        Copy_pEdges[count].timestamp = ring[Copy_u8Channel][tail].timestamp;
+        Copy_pEdges[count].flags = ring[Copy_u8Channel][tail].flags;
+        count++;
+        tail = (tail + 1) & EXTI_RING_MASK;
+    }
+    ring_tail[Copy_u8Channel] = tail;
+    return count;
+}
+
+void EXTI_voidGetStats(u8 Copy_u8Channel, EXTI_Stats_t *Copy_pStats)
+{
+    u8 sreg = SREG_REG;
+    cli();
+    Copy_pStats->captured = stats[Copy_u8Channel].captured;
+    Copy_pStats->overruns = stats[Copy_u8Channel].overruns;
+    Copy_pStats->missed = stats[Copy_u8Channel].missed;
+    Copy_pStats->backward = stats[Copy_u8Channel].backward;
+    Copy_pStats->max_fill = stats[Copy_u8Channel].max_fill;
+    SREG_REG = sreg;
+}
+
+#endif /* EXTI_ENABLE */
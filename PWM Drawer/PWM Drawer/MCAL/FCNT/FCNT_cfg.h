@@ -0,0 +1,26 @@
+#ifndef FCNT_CFG_H_
+#define FCNT_CFG_H_
+
+/* FCNT (gated frequency counter) Configuration */
+
+/* 1: counting mode available. The signal must also be wired to T1 (PB1),
+   which the default board uses for GLCD RW, so this stays off unless the
+   GLCD control lines were moved (main.c checks the pin assignment) */
+#ifndef FCNT_ENABLE
+#define FCNT_ENABLE 0
+#endif
+
+// Gate window in milliseconds, a divisor of 1000 up to 250 (resolution = 1000 / FCNT_GATE_MS Hz)
+#define FCNT_GATE_MS 100
+
+// Timer0 gate tick: CTC, clock / 64, OCR0 + 1 = 250 counts = 1 ms at 16 MHz
+#define FCNT_TICK_PRESCALER 64UL
+#define FCNT_TICK_HZ        1000UL
+
+// Switch from input capture to counting above FCNT_ENTER_HZ and back
+// below FCNT_LEAVE_HZ (hysteresis keeps the mode from toggling). Entry must
+// stay under the capture ISR limit (two interrupts per period, ~100 cycles each)
+#define FCNT_ENTER_HZ 40000UL
+#define FCNT_LEAVE_HZ 20000UL
+
+#endif /* FCNT_CFG_H_ */
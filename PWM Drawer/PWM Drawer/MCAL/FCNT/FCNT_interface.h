@@ -0,0 +1,28 @@
+#include "../../Service/std_types.h"
+
+#ifndef FCNT_INTERFACE_H_
+#define FCNT_INTERFACE_H_
+
+/* FCNT (gated frequency counter) Interface
+   Timer1 counts rising edges on T1 (PB1) from its external clock input while
+   Timer0 paces a fixed gate window. The gate ISR runs once per millisecond
+   whatever the signal rate, so CPU load stays flat for fast inputs where one
+   capture interrupt per edge would saturate the CPU.
+   Timer1 is shared with the ICU: suspend the capture engine before starting
+   the counter and resume it after stopping. */
+
+/* Function Prototypes for FCNT Operations */
+
+// Configure the gate timer (Timer0) and the T1 input; counting is not started
+void FCNT_voidInit(void);
+
+// Take over Timer1 as an edge counter and open the first gate window
+void FCNT_voidStart(void);
+
+// Stop the gate and the counter; Timer1 is left stopped for its next owner
+void FCNT_voidStop(void);
+
+// Frequency of the last complete gate window; returns 1 once per new window
+u8 FCNT_u8GetFrequency(u32 *Copy_pu32Hz);
+
+#endif /* FCNT_INTERFACE_H_ */
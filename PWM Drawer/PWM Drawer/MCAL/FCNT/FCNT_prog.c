@@ -0,0 +1,97 @@
+#include <avr/interrupt.h>
+#include "../../Service/std_types.h"
+#include "../../Service/bit_math.h"
+#include "../reg_def.h"
+#include "../DIO/DIO_interface.h"
+#include "FCNT_interface.h"
+#include "FCNT_cfg.h"
+
+// Timer1 clock select: external clock on T1, rising edge
+#define FCNT_T1_EXT_RISING 0x07
+// Timer0 clock select for FCNT_TICK_PRESCALER (clock / 64)
+#define FCNT_T0_CLOCK      ((1 << TIMER0_TCCR0_CS01) | (1 << TIMER0_TCCR0_CS00))
+
+#define FCNT_OCR0 ((F_CPU / FCNT_TICK_PRESCALER / FCNT_TICK_HZ) - 1)
+
+#if FCNT_OCR0 > 255
+#error "FCNT gate tick does not fit Timer0 at this F_CPU"
+#endif
+
+/* Gate state, touched only by the ISR while counting */
+static u16 last_tcnt = 0;     // TCNT1 at the previous tick
+static u32 window_acc = 0;    // Edges counted in the open window
+static u8  window_ms = 0;     // Ticks elapsed in the open window
+
+/* Result of the last closed window, published to the main loop */
+static volatile u32 window_count = 0;
+static volatile u8  window_ready = 0;
+
+/* Gate tick: TCNT1 is sampled every millisecond, well before its 16 bits can
+   wrap (T1 tops out near F_CPU / 2.5), so no overflow interrupt is needed.
+   The sample always lands at the same point of this ISR, so the latency cancels
+   between consecutive windows and each one is exactly FCNT_GATE_MS long */
+ISR(TIMER0_COMP_vect)
+{
+    u16 now = TIMER1_TCNT1_REG;
+
+    window_acc += (u16)(now - last_tcnt);
+    last_tcnt = now;
+
+    if (++window_ms == FCNT_GATE_MS)
+    {
+        window_count = window_acc;
+        window_ready = 1;
+        window_acc = 0;
+        window_ms = 0;
+    }
+}
+
+/* Timer0 in CTC mode with a 1 ms period, stopped until FCNT_voidStart */
+void FCNT_voidInit(void)
+{
+    TIMER0_TCCR0_REG = (1 << TIMER0_TCCR0_WGM01);
+    TIMER0_OCR0_REG = FCNT_OCR0;
+
+    // T1 (PB1) is the counter input
+    DIO_voidSetPinDirection(DIO_PORTB, DIO_PIN_1, DIO_PIN_INPUT);
+}
+
+void FCNT_voidStart(void)
+{
+    u8 sreg = SREG_REG;
+    cli();
+    TIMER1_TCCR1B_REG = FCNT_T1_EXT_RISING;
+    last_tcnt = TIMER1_TCNT1_REG;
+    window_acc = 0;
+    window_ms = 0;
+    window_ready = 0;
+
+    TIMER0_TCNT0_REG = 0;
+    TIMER0_TIFR_REG = (1 << TIMER0_TIFR_OCF0);
+    SET_BIT(TIMER0_TIMSK_REG, TIMER0_TIMSK_OCIE0);
+    TIMER0_TCCR0_REG = (1 << TIMER0_TCCR0_WGM01) | FCNT_T0_CLOCK;
+    SREG_REG = sreg;
+}
+
+void FCNT_voidStop(void)
+{
+    u8 sreg = SREG_REG;
+    cli();
+    TIMER0_TCCR0_REG = (1 << TIMER0_TCCR0_WGM01);
+    CLR_BIT(TIMER0_TIMSK_REG, TIMER0_TIMSK_OCIE0);
+    TIMER1_TCCR1B_REG = 0;
+    window_ready = 0;
+    SREG_REG = sreg;
+}
+
+u8 FCNT_u8GetFrequency(u32 *Copy_pu32Hz)
+{
+    u8 ready;
+    u8 sreg = SREG_REG;
+    cli();
+    ready = window_ready;
+    *Copy_pu32Hz = window_count * (1000UL / FCNT_GATE_MS);
+    window_ready = 0;
+    SREG_REG = sreg;
+    return ready;
+}
@@ -0,0 +1,51 @@
+#ifndef ICU_CFG_H_
+#define ICU_CFG_H_
+
+/* ICU (Timer1 Input Capture Unit) Configuration */
+
+// Edge records buffered between the capture ISR and the main loop (power of two, max 128)
+// Must cover all edges arriving while the main loop redraws the GLCD: the
+// simulator fills 6 at 1 kHz and 14 at 2 kHz; faster inputs overrun during
+// a redraw and lose the periods around it. 5 bytes each (budget in main.c)
+#define ICU_RING_SIZE 16
+
+// Timer1 clock select at start-up: ICU_CLOCK_DIV1 .. ICU_CLOCK_DIV1024
+#define ICU_CLOCK_SELECT ICU_CLOCK_DIV8
+
+// Automatic prescaler range switching from the measured period (1 = on)
+#define ICU_AUTO_RANGE 1
+
+// Auto range window in timer ticks per period: the finest prescaler whose
+// period stays below ICU_RANGE_ENTER ticks is chosen; the current one is
+// kept until the period reaches ICU_RANGE_LEAVE ticks (hysteresis)
+#define ICU_RANGE_ENTER 0xC000UL
+#define ICU_RANGE_LEAVE 0xF000UL
+
+// Input capture noise canceler (1 = filter ICP1 over 4 samples, adds 4 cycles delay)
+#define ICU_NOISE_CANCELER 0
+
+// Triggered acquisition (1 = on): the capture ISR tests every edge against a
+// trigger condition and keeps a pre-trigger record of the edges around it,
+// which lengthens the capture ISR (the inlined test saves more registers)
+#ifndef ICU_TRIGGER_ENABLE
+#define ICU_TRIGGER_ENABLE 0
+#endif
+
+// Edges in the record (power of two, max 128) and how many of them follow the
+// trigger edge; the rest lead up to it
+#define ICU_ACQ_SIZE 32
+#define ICU_ACQ_POST 16
+
+// Trigger at start-up: ICU_TRIG_EDGE .. ICU_TRIG_PERIOD_OUT, optionally
+// | ICU_TRIG_NEGATIVE; limits in CPU cycles (see ICU_voidSetTrigger)
+#ifndef ICU_TRIG_TYPE
+#define ICU_TRIG_TYPE ICU_TRIG_EDGE
+#endif
+#ifndef ICU_TRIG_MIN_CYCLES
+#define ICU_TRIG_MIN_CYCLES 0UL
+#endif
+#ifndef ICU_TRIG_MAX_CYCLES
+#define ICU_TRIG_MAX_CYCLES 0xFFFFFFFFUL
+#endif
+
+#endif /* ICU_CFG_H_ */
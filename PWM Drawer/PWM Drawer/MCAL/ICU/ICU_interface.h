@@ -0,0 +1,100 @@
+#include "../../Service/std_types.h"
+
+#ifndef ICU_INTERFACE_H_
+#define ICU_INTERFACE_H_
+
+/* ICU (Timer1 Input Capture Unit) Interface
+   The capture ISR timestamps every edge on ICP1 (PD6) into a lock-free
+   single-producer / single-consumer ring; the main loop drains it in batches.
+   Timestamps are 32 bits: ICR1 extended by the Timer1 overflow count.
+   With ICU_TRIGGER_ENABLE the same ISR also runs a trigger: every edge goes
+   into a separate pre-trigger record until one meets the trigger condition,
+   then ICU_ACQ_POST more are kept and the record is frozen for the main loop.
+   It does not depend on the ring, so a busy main loop never hides an event */
+
+// Timer1 clock select values (TCCR1B CS12:0)
+#define ICU_CLOCK_DIV1    1   // 62.5 ns tick at 16 MHz
+#define ICU_CLOCK_DIV8    2   // 0.5 us
+#define ICU_CLOCK_DIV64   3   // 4 us
+#define ICU_CLOCK_DIV256  4   // 16 us
+#define ICU_CLOCK_DIV1024 5   // 64 us
+
+// ICU_Edge_t flags
+#define ICU_FLAG_RISING      0x01  // Rising edge (falling when clear)
+#define ICU_FLAG_GAP         0x02  // Edges were dropped or the clock changed right before this one
+#define ICU_FLAG_CLOCK_MASK  0x1C  // Timer1 clock select the timestamp was taken with
+#define ICU_FLAG_CLOCK_SHIFT 2
+
+// Trigger conditions (ICU_voidSetTrigger); a pulse runs from its starting edge
+// (rising, or falling with ICU_TRIG_NEGATIVE) to the opposite one
+#define ICU_TRIG_EDGE       0     // Any starting edge
+#define ICU_TRIG_WIDTH_GT   1     // Pulse longer than the maximum (fires at its end)
+#define ICU_TRIG_WIDTH_LT   2     // Pulse shorter than the minimum, e.g. a runt (fires at its end)
+#define ICU_TRIG_PERIOD_OUT 3     // Start-to-start period outside [minimum, maximum]
+#define ICU_TRIG_TYPE_MASK  0x03
+#define ICU_TRIG_NEGATIVE   0x80  // Low pulses / falling edges instead
+
+// One captured edge
+typedef struct
+{
+    u32 timestamp;   // Overflow count : ICR1 at the edge (Timer1 ticks)
+    u8  flags;       // ICU_FLAG_*
+} ICU_Edge_t;
+
+// Capture path health counters
+typedef struct
+{
+    u32 captured;    // Edges stored in the ring
+    u16 overruns;    // Edges dropped because the ring was full
+    u8  max_fill;    // Highest ring occupancy seen
+    u8  range_switches; // Prescaler changes made by auto ranging
+    u16 triggers;    // Records frozen by the trigger (ICU_TRIGGER_ENABLE)
+} ICU_Stats_t;
+
+/* Function Prototypes for ICU Operations */
+
+// Start Timer1 and the capture/overflow interrupts (enables global interrupts)
+void ICU_voidInit(void);
+
+// Number of edges waiting in the ring
+u8 ICU_u8Available(void);
+
+// Move up to Copy_u8Max edges into Copy_pEdges (oldest first), return how many
+u8 ICU_u8ReadEdges(ICU_Edge_t *Copy_pEdges, u8 Copy_u8Max);
+
+// Timer1 extended to 32 bits right now, for other edge sources (EXTI) to stamp
+// against the same clock; the clock select goes into *Copy_pu8Flags as in
+// ICU_Edge_t. Call with interrupts masked (from an ISR, or inside cli())
+u32 ICU_u32Now(u8 *Copy_pu8Flags);
+
+// Convert a tick count taken with the clock in Copy_u8Flags to CPU cycles
+u32 ICU_u32TicksToCycles(u32 Copy_u32Ticks, u8 Copy_u8Flags);
+
+// Change the Timer1 clock; the next edge is flagged ICU_FLAG_GAP
+void ICU_voidSetClock(u8 Copy_u8Clock);
+
+// Feed a measured period (CPU cycles); switches the prescaler when it left the range
+void ICU_voidAutoRange(u32 Copy_u32PeriodCycles);
+
+// Release Timer1 to another user (FCNT): capture interrupts off, clock untouched
+void ICU_voidSuspend(void);
+
+// Take Timer1 back: restore the capture clock and edge select; the next edge is flagged ICU_FLAG_GAP
+void ICU_voidResume(void);
+
+// Trigger condition, limits in CPU cycles (compared in timer ticks, so to the
+// resolution of the current clock); re-arms the record
+void ICU_voidSetTrigger(u8 Copy_u8Type, u32 Copy_u32MinCycles, u32 Copy_u32MaxCycles);
+
+// Drop the record and start a new one; the trigger needs ICU_ACQ_SIZE -
+// ICU_ACQ_POST edges recorded before it can fire, so context always leads up to it
+void ICU_voidArm(void);
+
+// Copy the frozen record (oldest first) and the index of the trigger edge in
+// it; 0 while the trigger has not fired or its post-trigger edges are still due
+u8 ICU_u8ReadCapture(ICU_Edge_t *Copy_pEdges, u8 *Copy_pu8Trigger);
+
+// Snapshot of the health counters (taken with interrupts masked)
+void ICU_voidGetStats(ICU_Stats_t *Copy_pStats);
+
+#endif /* ICU_INTERFACE_H_ */
@@ -0,0 +1,377 @@
+#include <avr/interrupt.h>
+#include "../../Service/std_types.h"
+#include "../../Service/bit_math.h"
+#include "../reg_def.h"
+#include "ICU_interface.h"
+#include "ICU_cfg.h"
+
+#define ICU_RING_MASK (ICU_RING_SIZE - 1)
+
+#if (ICU_RING_SIZE & ICU_RING_MASK) != 0 || ICU_RING_SIZE > 128
+#error "ICU_RING_SIZE must be a power of two no larger than 128"
+#endif
+
+// log2 of the prescaler for each clock select value
+static const u8 clock_shift[6] = { 0, 0, 3, 6, 8, 10 };
+
+/* Ring storage: the ISR only writes ring_head, the main loop only writes
+   ring_tail; both are single bytes so each side reads the other's index atomically */
+static volatile ICU_Edge_t ring[ICU_RING_SIZE];
+static volatile u8 ring_head = 0;
+static volatile u8 ring_tail = 0;
+
+/* Upper 16 bits of the extended timestamp */
+static volatile u16 ovf_count = 0;
+
+/* Written by the ISR only (plus range_switches with interrupts masked) */
+static volatile ICU_Stats_t stats;
+
+/* Capture clock select, kept so ICU_voidResume can restore it */
+static u8 clock_sel = ICU_CLOCK_SELECT;
+
+/* Set when an edge was dropped or the clock changed, carried into the next stored record */
+static volatile u8 pending_gap = 0;
+
+#if ICU_TRIGGER_ENABLE
+
+#define ICU_ACQ_MASK (ICU_ACQ_SIZE - 1)
+
+#if (ICU_ACQ_SIZE & ICU_ACQ_MASK) != 0 || ICU_ACQ_SIZE > 128 || ICU_ACQ_POST >= ICU_ACQ_SIZE
+#error "ICU_ACQ_SIZE must be a power of two no larger than 128, above ICU_ACQ_POST"
+#endif
+
+// Record state
+#define ICU_ACQ_ARMED 0     // Recording, trigger live
+#define ICU_ACQ_POST_TRIG 1 // Triggered, recording the post-trigger edges
+#define ICU_ACQ_DONE  2     // Frozen until ICU_voidArm
+
+/* Pre-trigger record: a ring the ISR overwrites until the trigger fires.
+   Once acq_state is ICU_ACQ_DONE only the main loop touches it */
+static volatile ICU_Edge_t acq[ICU_ACQ_SIZE];
+static volatile u8 acq_head = 0;
+static volatile u8 acq_fill = 0;
+static volatile u8 acq_state = ICU_ACQ_ARMED;
+static volatile u8 acq_post_left = 0;
+static volatile u8 acq_trigger = 0;     // Ring slot of the trigger edge
+static volatile u8 acq_restart = 0;     // Clock changed: the recorded edges no longer compare
+
+/* Trigger condition, limits converted to ticks of the current clock */
+static u8  trig_type = ICU_TRIG_TYPE;
+static u32 trig_min_cycles = ICU_TRIG_MIN_CYCLES;
+static u32 trig_max_cycles = ICU_TRIG_MAX_CYCLES;
+static volatile u32 trig_min = 0;
+static volatile u32 trig_max = 0xFFFFFFFFUL;
+static volatile u32 trig_start = 0;     // Last starting edge of a pulse
+static volatile u8  trig_have_start = 0;
+
+/* Record one edge and test it; runs inside the capture ISR, so only
+   compares and one subtraction, no loops */
+static inline void ICU_voidAcquire(u32 Copy_u32Stamp, u8 Copy_u8Flags)
+{
+    u8 head = acq_head;
+    u8 start;
+    u8 hit = 0;
+    u32 width;
+
+    if (acq_state == ICU_ACQ_DONE)
+        return;
+    if (acq_restart)
+    {
+        acq_restart = 0;
+        acq_fill = 0;
+        trig_have_start = 0;
+        acq_state = ICU_ACQ_ARMED;
+    }
+
+    acq[head].timestamp = Copy_u32Stamp;
+    acq[head].flags = Copy_u8Flags;
+    acq_head = (head + 1) & ICU_ACQ_MASK;
+    if (acq_fill < ICU_ACQ_SIZE) acq_fill++;
+
+    if (acq_state == ICU_ACQ_POST_TRIG)
+    {
+        if (--acq_post_left == 0)
+            acq_state = ICU_ACQ_DONE;
+        return;
+    }
+
+    // Starting edge of a pulse: rising, falling for negative pulses
+    start = ((Copy_u8Flags & ICU_FLAG_RISING) != 0) == ((trig_type & ICU_TRIG_NEGATIVE) == 0);
+    width = Copy_u32Stamp - trig_start;
+
+    switch (trig_type & ICU_TRIG_TYPE_MASK)
+    {
+    case ICU_TRIG_EDGE:
+        hit = start;
+        break;
+    case ICU_TRIG_WIDTH_GT:
+        hit = !start && trig_have_start && width > trig_max;
+        break;
+    case ICU_TRIG_WIDTH_LT:
+        hit = !start && trig_have_start && width < trig_min;
+        break;
+    default:    // ICU_TRIG_PERIOD_OUT
+        hit = start && trig_have_start && (width < trig_min || width > trig_max);
+        break;
+    }
+    if (start)
+    {
+        trig_start = Copy_u32Stamp;
+        trig_have_start = 1;
+    }
+
+    // Hold off until the pre-trigger part of the record is full
+    if (!hit || acq_fill < ICU_ACQ_SIZE - ICU_ACQ_POST)
+        return;
+    acq_trigger = head;
+    stats.triggers++;
+    acq_post_left = ICU_ACQ_POST;
+    acq_state = (ICU_ACQ_POST == 0) ? ICU_ACQ_DONE : ICU_ACQ_POST_TRIG;
+}
+
+/* Cycle limits -> ticks of the clock now selected (call with interrupts masked) */
+static void ICU_voidTriggerTicks(void)
+{
+    u8 shift = clock_shift[clock_sel];
+    trig_min = trig_min_cycles >> shift;
+    trig_max = trig_max_cycles >> shift;
+}
+
+#endif
+
+/* Overflow ISR: extend Timer1 to 32 bits */
+ISR(TIMER1_OVF_vect)
+{
+    ovf_count++;
+}
+
+/* Capture ISR: store the edge, then flip the edge select for the next one */
+ISR(TIMER1_CAPT_vect)
+{
+    u16 stamp = TIMER1_ICR1_REG;
+    u16 ovf = ovf_count;
+    u8 tccr1b = TIMER1_TCCR1B_REG;
+    u8 flags = (GET_BIT(tccr1b, TIMER1_TCCR1B_ICES1) ? ICU_FLAG_RISING : 0) |
+               ((tccr1b & 0x07) << ICU_FLAG_CLOCK_SHIFT);
+    u8 head = ring_head;
+    u8 next = (head + 1) & ICU_RING_MASK;
+
+    // Overflow/capture race: this vector outranks TIMER1_OVF, so a wrap may be
+    // pending and not yet counted. A small ICR1 means the capture came after it.
+    if (GET_BIT(TIMER1_TIFR_REG, TIMER1_TIFR_TOV1) && stamp < 0x8000)
+        ovf++;
+
+    // Alternate edges: rising -> falling -> rising ...
+    // (the datasheet requires ICF1 to be cleared after changing the edge)
+    TOG_BIT(TIMER1_TCCR1B_REG, TIMER1_TCCR1B_ICES1);
+    TIMER1_TIFR_REG = (1 << TIMER1_TIFR_ICF1);
+
+#if ICU_TRIGGER_ENABLE
+    // Before the ring: the record sees every edge, even ones the ring drops
+    ICU_voidAcquire(((u32)ovf << 16) | stamp, flags);
+#endif
+
+    if (next == ring_tail)
+    {
+        // Ring full: drop, count and tell the consumer where the gap is
+        stats.overruns++;
+        pending_gap = ICU_FLAG_GAP;
+        return;
+    }
+
+    ring[head].timestamp = ((u32)ovf << 16) | stamp;
+    ring[head].flags = flags | pending_gap;
+    pending_gap = 0;
+    ring_head = next;   // Publish after the record is complete
+
+    stats.captured++;
+    u8 fill = (next - ring_tail) & ICU_RING_MASK;
+    if (fill > stats.max_fill) stats.max_fill = fill;
+}
+
+/* Start Timer1 in normal mode and enable the capture and overflow interrupts */
+void ICU_voidInit(void)
+{
+    TIMER1_TCCR1A_REG = 0;
+    TIMER1_TCCR1B_REG = (1 << TIMER1_TCCR1B_ICES1) | (ICU_NOISE_CANCELER << TIMER1_TCCR1B_ICNC1) |
+                        ICU_CLOCK_SELECT;   // Start with a rising edge
+#if ICU_TRIGGER_ENABLE
+    ICU_voidTriggerTicks();
+#endif
+    // ICP1 edges set ICF1 with the timer stopped too, sensed falling until now:
+    // drop that stale capture so the first record is a real rising edge
+    TIMER1_TIFR_REG = (1 << TIMER1_TIFR_ICF1) | (1 << TIMER1_TIFR_TOV1);
+    SET_BIT(TIMER1_TIMSK_REG, TIMER1_TIMSK_TICIE1);
+    SET_BIT(TIMER1_TIMSK_REG, TIMER1_TIMSK_TOIE1);
+    sei();
+}
+
+/* Number of edges waiting */
+u8 ICU_u8Available(void)
+{
+    return (ring_head - ring_tail) & ICU_RING_MASK;
+}
+
+/* Drain up to Copy_u8Max edges, oldest first */
+u8 ICU_u8ReadEdges(ICU_Edge_t *Copy_pEdges, u8 Copy_u8Max)
+{
+    u8 tail = ring_tail;
+    u8 head = ring_head;   // Snapshot: edges arriving now wait for the next batch
+    u8 count = 0;
+
+    while (tail != head && count < Copy_u8Max)
+    {
+        Copy_pEdges[count].timestamp = ring[tail].timestamp;
+        Copy_pEdges[count].flags = ring[tail].flags;
+        count++;
+        tail = (tail + 1) & ICU_RING_MASK;
+    }
+    ring_tail = tail;   // Release the slots only after they were copied
+    return count;
+}
+
+/* Free-running timestamp: TCNT1 extended by the overflow count, with the same
+   pending-overflow correction as the capture ISR (the caller holds off
+   TIMER1_OVF, so a wrap since the last overflow ISR may not be counted yet) */
+u32 ICU_u32Now(u8 *Copy_pu8Flags)
+{
+    u16 stamp = TIMER1_TCNT1_REG;
+    u16 ovf = ovf_count;
+
+    if (GET_BIT(TIMER1_TIFR_REG, TIMER1_TIFR_TOV1) && stamp < 0x8000)
+        ovf++;
+
+    *Copy_pu8Flags = (TIMER1_TCCR1B_REG & 0x07) << ICU_FLAG_CLOCK_SHIFT;
+    return ((u32)ovf << 16) | stamp;
+}
+
+/* Ticks -> CPU cycles for the clock recorded in an edge's flags */
+u32 ICU_u32TicksToCycles(u32 Copy_u32Ticks, u8 Copy_u8Flags)
+{
+    u8 clock = (Copy_u8Flags & ICU_FLAG_CLOCK_MASK) >> ICU_FLAG_CLOCK_SHIFT;
+    return Copy_u32Ticks << clock_shift[clock];
+}
+
+/* Change the prescaler; timestamps on either side of the change are not comparable */
+void ICU_voidSetClock(u8 Copy_u8Clock)
+{
+    u8 sreg = SREG_REG;
+    cli();
+    TIMER1_TCCR1B_REG = (TIMER1_TCCR1B_REG & ~0x07) | Copy_u8Clock;
+    clock_sel = Copy_u8Clock;
+    pending_gap = ICU_FLAG_GAP;
+    stats.range_switches++;
+#if ICU_TRIGGER_ENABLE
+    ICU_voidTriggerTicks();
+    acq_restart = 1;
+#endif
+    SREG_REG = sreg;
+}
+
+/* Pick the finest prescaler that keeps the period inside 16 bits of ticks,
+   so resolution is as high as possible and overflows stay rare */
+void ICU_voidAutoRange(u32 Copy_u32PeriodCycles)
+{
+#if ICU_AUTO_RANGE
+    u8 current = clock_sel;
+    u8 target = ICU_CLOCK_DIV1024;
+
+    for (u8 clock = ICU_CLOCK_DIV1; clock <= ICU_CLOCK_DIV1024; clock++)
+    {
+        u32 limit = (clock == current) ? ICU_RANGE_LEAVE : ICU_RANGE_ENTER;
+        if ((Copy_u32PeriodCycles >> clock_shift[clock]) < limit)
+        {
+            target = clock;
+            break;
+        }
+    }
+
+    if (target != current)
+        ICU_voidSetClock(target);
+#else
+    (void)Copy_u32PeriodCycles;
+#endif
+}
+
+/* Hand Timer1 over: no more captures until ICU_voidResume */
+void ICU_voidSuspend(void)
+{
+    CLR_BIT(TIMER1_TIMSK_REG, TIMER1_TIMSK_TICIE1);
+}
+
+/* Restart capturing from a rising edge; timestamps taken before the
+   suspension are not comparable with the new ones */
+void ICU_voidResume(void)
+{
+    u8 sreg = SREG_REG;
+    cli();
+    TIMER1_TCCR1B_REG = (1 << TIMER1_TCCR1B_ICES1) | (ICU_NOISE_CANCELER << TIMER1_TCCR1B_ICNC1) |
+                        clock_sel;
+    // Drop the capture and the wrap the counter mode left pending
+    TIMER1_TIFR_REG = (1 << TIMER1_TIFR_ICF1) | (1 << TIMER1_TIFR_TOV1);
+    pending_gap = ICU_FLAG_GAP;
+#if ICU_TRIGGER_ENABLE
+    acq_restart = 1;
+#endif
+    SET_BIT(TIMER1_TIMSK_REG, TIMER1_TIMSK_TICIE1);
+    SREG_REG = sreg;
+}
+
+/* Copy the counters without tearing the multi-byte fields */
+void ICU_voidGetStats(ICU_Stats_t *Copy_pStats)
+{
+    u8 sreg = SREG_REG;
+    cli();
+    Copy_pStats->captured = stats.captured;
+    Copy_pStats->overruns = stats.overruns;
+    Copy_pStats->max_fill = stats.max_fill;
+    Copy_pStats->range_switches = stats.range_switches;
+    Copy_pStats->triggers = stats.triggers;
+    SREG_REG = sreg;
+}
+
+#if ICU_TRIGGER_ENABLE
+/* New condition: edges recorded under the old one may not lead up to it */
+void ICU_voidSetTrigger(u8 Copy_u8Type, u32 Copy_u32MinCycles, u32 Copy_u32MaxCycles)
+{
+    u8 sreg = SREG_REG;
+    cli();
+    trig_type = Copy_u8Type;
+    trig_min_cycles = Copy_u32MinCycles;
+    trig_max_cycles = Copy_u32MaxCycles;
+    ICU_voidTriggerTicks();
+    SREG_REG = sreg;
+    ICU_voidArm();
+}
+
+void ICU_voidArm(void)
+{
+    u8 sreg = SREG_REG;
+    cli();
+    acq_fill = 0;
+    trig_have_start = 0;
+    acq_restart = 0;
+    acq_state = ICU_ACQ_ARMED;
+    SREG_REG = sreg;
+}
+
+/* The ISR no longer writes a frozen record, so it is copied without masking interrupts */
+u8 ICU_u8ReadCapture(ICU_Edge_t *Copy_pEdges, u8 *Copy_pu8Trigger)
+{
+    u8 fill, index;
+
+    if (acq_state != ICU_ACQ_DONE)
+        return 0;
+
+    fill = acq_fill;
+    index = (acq_head - fill) & ICU_ACQ_MASK;      // Oldest edge
+    *Copy_pu8Trigger = (acq_trigger - index) & ICU_ACQ_MASK;
+    for (u8 i = 0; i < fill; i++)
+    {
+        Copy_pEdges[i].timestamp = acq[index].timestamp;
+        Copy_pEdges[i].flags = acq[index].flags;
+        index = (index + 1) & ICU_ACQ_MASK;
+    }
+    return fill;
+}
+#endif
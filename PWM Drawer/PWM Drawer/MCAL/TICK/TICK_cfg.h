@@ -0,0 +1,16 @@
+#ifndef TICK_CFG_H_
+#define TICK_CFG_H_
+
+/* TICK (system tick) Configuration */
+
+// Timer2 tick: CTC, clock / 64, OCR2 + 1 = 250 counts = 1 ms at 16 MHz
+#define TICK_PRESCALER 64UL
+#define TICK_HZ        1000UL
+
+// Display frame rate (a divisor of TICK_HZ): measurements are aggregated
+// continuously, the screen is refreshed this many times per second
+#ifndef TICK_FRAME_HZ
+#define TICK_FRAME_HZ 25
+#endif
+
+#endif /* TICK_CFG_H_ */
@@ -0,0 +1,30 @@
+#include "../../Service/std_types.h"
+
+#ifndef TICK_INTERFACE_H_
+#define TICK_INTERFACE_H_
+
+/* TICK (system tick) Interface
+   Timer2 interrupts every millisecond, keeps a millisecond count and marks
+   a display frame as due every TICK_HZ / TICK_FRAME_HZ ticks. The tick also
+   wakes the main loop from idle sleep, so a due frame is never late by more
+   than one tick.
+   One task can be hooked to the tick (e.g. the deferred GLCD writes). It
+   runs inside the tick interrupt with interrupts enabled again, so a long
+   task never holds off the capture ISR; ticks arriving meanwhile are still
+   counted but do not start it a second time. */
+
+/* Function Prototypes for TICK Operations */
+
+// Start Timer2 in CTC mode with its compare interrupt enabled
+void TICK_voidInit(void);
+
+// Milliseconds since TICK_voidInit (wraps after 49 days)
+u32 TICK_u32Millis(void);
+
+// Run Copy_pfTask on every tick (0 = none)
+void TICK_voidSetTask(void (*Copy_pfTask)(void));
+
+// 1 once per frame period; frames missed while busy collapse into one
+u8 TICK_u8FrameDue(void);
+
+#endif /* TICK_INTERFACE_H_ */
@@ -0,0 +1,80 @@
+#include <avr/interrupt.h>
+#include "../../Service/std_types.h"
+#include "../../Service/bit_math.h"
+#include "../reg_def.h"
+#include "TICK_interface.h"
+#include "TICK_cfg.h"
+
+// Timer2 clock select for TICK_PRESCALER (clock / 64: CS22 alone on Timer2)
+#define TICK_T2_CLOCK  (1 << TIMER2_TCCR2_CS22)
+
+#define TICK_OCR2         ((F_CPU / TICK_PRESCALER / TICK_HZ) - 1)
+#define TICK_FRAME_TICKS  (TICK_HZ / TICK_FRAME_HZ)
+
+#if TICK_OCR2 > 255
+#error "System tick does not fit Timer2 at this F_CPU"
+#endif
+#if TICK_FRAME_HZ < 1 || TICK_FRAME_TICKS > 255 || TICK_HZ % TICK_FRAME_HZ != 0
+#error "TICK_FRAME_HZ must divide TICK_HZ into at most 255 ticks"
+#endif
+
+static volatile u32 millis = 0;
+static volatile u8  frame_due = 0;
+static u8 frame_ticks = 0;      // Ticks into the current frame (ISR only)
+static void (*volatile tick_task)(void) = 0;
+static volatile u8 task_running = 0;
+
+ISR(TIMER2_COMP_vect)
+{
+    millis++;
+    if (++frame_ticks == TICK_FRAME_TICKS)
+    {
+        frame_ticks = 0;
+        frame_due = 1;
+    }
+
+    // Nested: the task may run longer than other interrupts can wait
+    if (tick_task != 0 && !task_running)
+    {
+        task_running = 1;
+        sei();
+        tick_task();
+        cli();
+        task_running = 0;
+    }
+}
+
+void TICK_voidInit(void)
+{
+    TIMER2_TCCR2_REG = (1 << TIMER2_TCCR2_WGM21);
+    TIMER2_OCR2_REG = TICK_OCR2;
+    TIMER2_TCNT2_REG = 0;
+    TIMER2_TIFR_REG = (1 << TIMER2_TIFR_OCF2);
+    SET_BIT(TIMER2_TIMSK_REG, TIMER2_TIMSK_OCIE2);
+    TIMER2_TCCR2_REG = (1 << TIMER2_TCCR2_WGM21) | TICK_T2_CLOCK;
+}
+
+u32 TICK_u32Millis(void)
+{
+    u32 ms;
+    u8 sreg = SREG_REG;
+
+    // Four byte reads: keep the ISR from changing the count in between
+    cli();
+    ms = millis;
+    SREG_REG = sreg;
+    return ms;
+}
+
+void TICK_voidSetTask(void (*Copy_pfTask)(void))
+{
+    tick_task = Copy_pfTask;
+}
+
+u8 TICK_u8FrameDue(void)
+{
+    if (!frame_due)
+        return 0;
+    frame_due = 0;
+    return 1;
+}
@@ -0,0 +1,19 @@
+#ifndef UART_CFG_H_
+#define UART_CFG_H_
+
+/* UART (interrupt-driven USART transmitter) Configuration */
+
+// Line rate, 8N1. 250000 divides 16 MHz exactly (UBRR = 3); the build fails
+// if the nearest UBRR is more than 2 % off
+#ifndef UART_BAUD
+#define UART_BAUD 250000UL
+#endif
+
+// Bytes buffered between the writers and the transmit ISR (power of two,
+// max 256). A write that does not fit is refused whole, never waited on.
+// TLM queues a period frame (57 bytes) while keeping room for a stats frame
+// (54), so 128 holds one of each; a bigger ring comes out of the 2 KB of
+// SRAM (see the budget in main.c)
+#define UART_TX_SIZE 128
+
+#endif /* UART_CFG_H_ */
@@ -0,0 +1,33 @@
+#include "../../Service/std_types.h"
+
+#ifndef UART_INTERFACE_H_
+#define UART_INTERFACE_H_
+
+/* UART (interrupt-driven USART transmitter) Interface
+   Transmit only, on TXD (PD1). Writers copy whole messages into a ring; the
+   data register empty ISR feeds it to the USART one byte per interrupt, so
+   a write costs a copy and never waits for the line. */
+
+// Transmitter health counters
+typedef struct
+{
+    u32 sent;        // Bytes handed to the USART
+    u16 refused;     // Writes dropped because the ring had no room for them
+    u8  max_fill;    // Highest ring occupancy seen
+} UART_Stats_t;
+
+/* Function Prototypes for UART Operations */
+
+// 8N1 at UART_BAUD, transmitter on, receiver off
+void UART_voidInit(void);
+
+// Free bytes in the transmit ring
+u8 UART_u8Free(void);
+
+// Queue Copy_u8Len bytes as one piece: 1 if queued, 0 (nothing queued) if they do not fit
+u8 UART_u8Write(const u8 *Copy_pu8Data, u8 Copy_u8Len);
+
+// Snapshot of the health counters (taken with interrupts masked)
+void UART_voidGetStats(UART_Stats_t *Copy_pStats);
+
+#endif /* UART_INTERFACE_H_ */
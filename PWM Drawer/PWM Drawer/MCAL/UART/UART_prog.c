@@ -0,0 +1,101 @@
+#include <avr/interrupt.h>
+#include "../../Service/std_types.h"
+#include "../../Service/bit_math.h"
+#include "../reg_def.h"
+#include "UART_interface.h"
+#include "UART_cfg.h"
+#include "../../APP/TLM/TLM_cfg.h"
+
+// Telemetry is the only user: without it neither the ring nor the ISR is linked
+#if TLM_ENABLE
+
+#define UART_TX_MASK (UART_TX_SIZE - 1)
+
+// u8 indices: at 256 they wrap on their own, the mask is then a no-op
+#if (UART_TX_SIZE & UART_TX_MASK) != 0 || UART_TX_SIZE > 256
+#error "UART_TX_SIZE must be a power of two no larger than 256"
+#endif
+
+// Normal speed: 16 samples per bit, rounded to the nearest divisor
+#define UART_UBRR       ((F_CPU + 8UL * UART_BAUD) / (16UL * UART_BAUD) - 1)
+#define UART_BAUD_REAL  (F_CPU / (16UL * (UART_UBRR + 1)))
+
+#if UART_UBRR > 4095
+#error "UART_BAUD is too low for this F_CPU"
+#endif
+#if UART_BAUD_REAL * 100 > UART_BAUD * 102 || UART_BAUD_REAL * 100 < UART_BAUD * 98
+#error "UART_BAUD is more than 2 % off at this F_CPU"
+#endif
+
+/* Ring: writers (main loop) only move tx_head, the ISR only moves tx_tail */
+static volatile u8 tx_ring[UART_TX_SIZE];
+static volatile u8 tx_head = 0;
+static volatile u8 tx_tail = 0;
+
+static volatile UART_Stats_t stats;
+
+/* Data register empty: send the next byte, or stop interrupting once the
+   ring is drained (the next write turns the interrupt back on) */
+ISR(USART_UDRE_vect)
+{
+    u8 tail = tx_tail;
+
+    if (tail == tx_head)
+    {
+        CLR_BIT(UART_UCSRB_REG, UART_UCSRB_UDRIE);
+        return;
+    }
+    UART_UDR_REG = tx_ring[tail];
+    tx_tail = (tail + 1) & UART_TX_MASK;
+    stats.sent++;
+}
+
+void UART_voidInit(void)
+{
+    UART_UBRRH_REG = (u8)(UART_UBRR >> 8);
+    UART_UBRRL_REG = (u8)UART_UBRR;
+    UART_UCSRA_REG = 0;
+    UART_UCSRC_REG = (1 << UART_UCSRC_URSEL) | (1 << UART_UCSRC_UCSZ1) | (1 << UART_UCSRC_UCSZ0);
+    UART_UCSRB_REG = (1 << UART_UCSRB_TXEN);
+}
+
+u8 UART_u8Free(void)
+{
+    return (UART_TX_SIZE - 1) - ((tx_head - tx_tail) & UART_TX_MASK);
+}
+
+/* All or nothing, so a message is never cut short in the middle of the stream */
+u8 UART_u8Write(const u8 *Copy_pu8Data, u8 Copy_u8Len)
+{
+    u8 head = tx_head;
+
+    if (Copy_u8Len > UART_u8Free())
+    {
+        stats.refused++;
+        return 0;
+    }
+    for (u8 i = 0; i < Copy_u8Len; i++)
+    {
+        tx_ring[head] = Copy_pu8Data[i];
+        head = (head + 1) & UART_TX_MASK;
+    }
+    tx_head = head;     // Publish after the bytes are in place
+
+    u8 fill = (head - tx_tail) & UART_TX_MASK;
+    if (fill > stats.max_fill) stats.max_fill = fill;
+
+    SET_BIT(UART_UCSRB_REG, UART_UCSRB_UDRIE);
+    return 1;
+}
+
+void UART_voidGetStats(UART_Stats_t *Copy_pStats)
+{
+    u8 sreg = SREG_REG;
+    cli();
+    Copy_pStats->sent = stats.sent;
+    Copy_pStats->refused = stats.refused;
+    Copy_pStats->max_fill = stats.max_fill;
+    SREG_REG = sreg;
+}
+
+#endif /* TLM_ENABLE */
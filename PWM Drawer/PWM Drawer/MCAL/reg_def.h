@@ -1,36 +1,48 @@
 #ifndef REG_DEF_H_
 #define REG_DEF_H_
 
+/*------------------------------ REGISTER ACCESS ----------------------------*/
+#ifdef SIM_HOST
+// Host simulation: every access goes through the simulator so its peripheral
+// models (GLCD controllers, timers, input signal) see the bus as it changes
+volatile u8 *SIM_pu8Access(u8 Copy_u8Addr);
+#define REG8(addr)  (*SIM_pu8Access(addr))
+#define REG16(addr) (*(volatile u16*)SIM_pu8Access(addr))
+#else
+#define REG8(addr)  (*(volatile u8*)(addr))
+#define REG16(addr) (*(volatile u16*)(addr))
+#endif
+
 /*------------------------------ DIO REGISTERS ------------------------------*/
 // Port A registers
-#define DIO_PINA_REG   (*(volatile u8*)(0x39))  // Port A Input Pins
-#define DIO_DDRA_REG   (*(volatile u8*)(0x3A))  // Port A Data Direction Register
-#define DIO_PORTA_REG  (*(volatile u8*)(0x3B))  // Port A Data Register
+#define DIO_PINA_REG   REG8(0x39)  // Port A Input Pins
+#define DIO_DDRA_REG   REG8(0x3A)  // Port A Data Direction Register
+#define DIO_PORTA_REG  REG8(0x3B)  // Port A Data Register
 
 // Port B registers
-#define DIO_PINB_REG   (*(volatile u8*)(0x36))  // Port B Input Pins
-#define DIO_DDRB_REG   (*(volatile u8*)(0x37))  // Port B Data Direction Register
-#define DIO_PORTB_REG  (*(volatile u8*)(0x38))  // Port B Data Register
+#define DIO_PINB_REG   REG8(0x36)  // Port B Input Pins
+#define DIO_DDRB_REG   REG8(0x37)  // Port B Data Direction Register
+#define DIO_PORTB_REG  REG8(0x38)  // Port B Data Register
 
 // Port C registers
-#define DIO_PINC_REG   (*(volatile u8*)(0x33))  // Port C Input Pins
-#define DIO_DDRC_REG   (*(volatile u8*)(0x34))  // Port C Data Direction Register
-#define DIO_PORTC_REG  (*(volatile u8*)(0x35))  // Port C Data Register
+#define DIO_PINC_REG   REG8(0x33)  // Port C Input Pins
+#define DIO_DDRC_REG   REG8(0x34)  // Port C Data Direction Register
+#define DIO_PORTC_REG  REG8(0x35)  // Port C Data Register
 
 // Port D registers
-#define DIO_PIND_REG   (*(volatile u8*)(0x30))  // Port D Input Pins
-#define DIO_DDRD_REG   (*(volatile u8*)(0x31))  // Port D Data Direction Register
-#define DIO_PORTD_REG  (*(volatile u8*)(0x32))  // Port D Data Register
+#define DIO_PIND_REG   REG8(0x30)  // Port D Input Pins
+#define DIO_DDRD_REG   REG8(0x31)  // Port D Data Direction Register
+#define DIO_PORTD_REG  REG8(0x32)  // Port D Data Register
 
 /*------------------------------ GLOBAL INTERRUPT ---------------------------*/
-#define SREG_REG (*(volatile u8*)(0x5F))  // Status Register
+#define SREG_REG REG8(0x5F)  // Status Register
 
 /*------------------------------ EXTERNAL INTERRUPTS ------------------------*/
 // External interrupt control registers
-#define EXTI_MCUCR_REG   (*(volatile u8*)(0x55))  // MCU Control Register
-#define EXTI_MCUCSR_REG  (*(volatile u8*)(0x54))  // MCU Control and Status Register
-#define EXTI_GICR_REG    (*(volatile u8*)(0x5B))  // General Interrupt Control Register
-#define EXTI_GIFR_REG    (*(volatile u8*)(0x5A))  // General Interrupt Flag Register
+#define EXTI_MCUCR_REG   REG8(0x55)  // MCU Control Register
+#define EXTI_MCUCSR_REG  REG8(0x54)  // MCU Control and Status Register
+#define EXTI_GICR_REG    REG8(0x5B)  // General Interrupt Control Register
+#define EXTI_GIFR_REG    REG8(0x5A)  // General Interrupt Flag Register
 
 // External interrupt bit definitions
 #define EXTI_MCUCR_ISC00 0  // Interrupt Sense Control 0 Bit 0
@@ -47,11 +59,12 @@
 
 /*------------------------------ ADC REGISTERS ------------------------------*/
 // ADC registers
-#define ADC_ADMUX_REG   (*(volatile u8*)(0x27))  // ADC Multiplexer Selection Register
-#define ADC_ADCSRA_REG  (*(volatile u8*)(0x26))  // ADC Control and Status Register A
-#define ADC_ADCH_REG    (*(volatile u8*)(0x25))  // ADC Data Register High
-#define ADC_ADCL_REG    (*(volatile u8*)(0x24))  // ADC Data Register Low
-#define ADC_ADC_REG     (*(volatile u16*)(0x24)) // ADC Data Register (16-bit access)
+#define ADC_ADMUX_REG   REG8(0x27)  // ADC Multiplexer Selection Register
+#define ADC_ADCSRA_REG  REG8(0x26)  // ADC Control and Status Register A
+#define ADC_ADCH_REG    REG8(0x25)  // ADC Data Register High
+#define ADC_ADCL_REG    REG8(0x24)  // ADC Data Register Low
+#define ADC_ADC_REG     REG16(0x24) // ADC Data Register (16-bit access)
+#define ADC_SFIOR_REG   REG8(0x50)  // Special Function IO Register (auto trigger source)
 
 // ADC bit definitions
 #define ADC_ADMUX_REFS1 7  // Reference Selection Bit 1
@@ -59,13 +72,97 @@
 #define ADC_ADMUX_ADLAR 5  // ADC Left Adjust Result
 #define ADC_ADCSRA_ADEN 7  // ADC Enable
 #define ADC_ADCSRA_ADSC 6  // ADC Start Conversion
+#define ADC_ADCSRA_ADATE 5 // ADC Auto Trigger Enable
+#define ADC_ADCSRA_ADIF 4  // ADC Interrupt Flag
+#define ADC_ADCSRA_ADIE 3  // ADC Interrupt Enable
+#define ADC_ADCSRA_ADPS0 0 // ADC Prescaler Select Bits 2:0
+#define ADC_SFIOR_ADTS0 5  // ADC Auto Trigger Source Bits 2:0
 
 /*------------------------------ TIMER0 REGISTERS ---------------------------*/
 // Timer0 registers
-#define TIMER0_TCCR0_REG (*(volatile u8*)(0x53))  // Timer0 Control Register
-#define TIMER0_TCNT0_REG (*(volatile u8*)(0x52))  // Timer0 Counter Register
-#define TIMER0_TIMSK_REG (*(volatile u8*)(0x59))  // Timer0 Interrupt Mask Register
-#define TIMER0_TIFR_REG  (*(volatile u8*)(0x58))  // Timer0 Interrupt Flag Register
-#define TIMER0_OCR0_REG  (*(volatile u8*)(0x5C))  // Timer0 Output Compare Register
+#define TIMER0_TCCR0_REG REG8(0x53)  // Timer0 Control Register
+#define TIMER0_TCNT0_REG REG8(0x52)  // Timer0 Counter Register
+#define TIMER0_TIMSK_REG REG8(0x59)  // Timer0 Interrupt Mask Register
+#define TIMER0_TIFR_REG  REG8(0x58)  // Timer0 Interrupt Flag Register
+#define TIMER0_OCR0_REG  REG8(0x5C)  // Timer0 Output Compare Register
+
+// Timer0 bit definitions
+#define TIMER0_TCCR0_WGM00 6  // Waveform Generation Mode Bit 0
+#define TIMER0_TCCR0_WGM01 3  // Waveform Generation Mode Bit 1 (CTC when WGM00 = 0)
+#define TIMER0_TCCR0_CS02  2  // Clock Select Bit 2
+#define TIMER0_TCCR0_CS01  1  // Clock Select Bit 1
+#define TIMER0_TCCR0_CS00  0  // Clock Select Bit 0
+#define TIMER0_TIMSK_OCIE0 1  // Output Compare Match Interrupt Enable
+#define TIMER0_TIMSK_TOIE0 0  // Overflow Interrupt Enable
+#define TIMER0_TIFR_OCF0   1  // Output Compare Match Flag
+#define TIMER0_TIFR_TOV0   0  // Overflow Flag
+
+/*------------------------------ TIMER1 REGISTERS ---------------------------*/
+// Timer1 registers
+#define TIMER1_TCCR1A_REG REG8(0x4F)   // Timer1 Control Register A
+#define TIMER1_TCCR1B_REG REG8(0x4E)   // Timer1 Control Register B
+#define TIMER1_TCNT1_REG  REG16(0x4C)  // Timer1 Counter Register (16-bit access)
+#define TIMER1_OCR1A_REG  REG16(0x4A)  // Timer1 Output Compare Register A
+#define TIMER1_OCR1B_REG  REG16(0x48)  // Timer1 Output Compare Register B
+#define TIMER1_ICR1_REG   REG16(0x46)  // Timer1 Input Capture Register
+#define TIMER1_TIMSK_REG  REG8(0x59)   // Timer Interrupt Mask Register (shared)
+#define TIMER1_TIFR_REG   REG8(0x58)   // Timer Interrupt Flag Register (shared)
+
+// Timer1 bit definitions
+#define TIMER1_TCCR1B_ICNC1 7  // Input Capture Noise Canceler
+#define TIMER1_TCCR1B_ICES1 6  // Input Capture Edge Select (1 = rising)
+#define TIMER1_TCCR1B_CS12  2  // Clock Select Bit 2
+#define TIMER1_TCCR1B_CS11  1  // Clock Select Bit 1
+#define TIMER1_TCCR1B_CS10  0  // Clock Select Bit 0
+#define TIMER1_TIMSK_TICIE1 5  // Input Capture Interrupt Enable
+#define TIMER1_TIMSK_OCIE1A 4  // Output Compare A Match Interrupt Enable
+#define TIMER1_TIMSK_OCIE1B 3  // Output Compare B Match Interrupt Enable
+#define TIMER1_TIMSK_TOIE1  2  // Overflow Interrupt Enable
+#define TIMER1_TIFR_ICF1    5  // Input Capture Flag
+#define TIMER1_TIFR_OCF1A   4  // Output Compare A Match Flag
+#define TIMER1_TIFR_OCF1B   3  // Output Compare B Match Flag
+#define TIMER1_TIFR_TOV1    2  // Overflow Flag
+
+/*------------------------------ TIMER2 REGISTERS ---------------------------*/
+// Timer2 registers
+#define TIMER2_TCCR2_REG REG8(0x45)  // Timer2 Control Register
+#define TIMER2_TCNT2_REG REG8(0x44)  // Timer2 Counter Register
+#define TIMER2_OCR2_REG  REG8(0x43)  // Timer2 Output Compare Register
+#define TIMER2_TIMSK_REG REG8(0x59)  // Timer Interrupt Mask Register (shared)
+#define TIMER2_TIFR_REG  REG8(0x58)  // Timer Interrupt Flag Register (shared)
+
+// Timer2 bit definitions
+#define TIMER2_TCCR2_WGM20 6  // Waveform Generation Mode Bit 0
+#define TIMER2_TCCR2_WGM21 3  // Waveform Generation Mode Bit 1 (CTC when WGM20 = 0)
+#define TIMER2_TCCR2_CS22  2  // Clock Select Bit 2
+#define TIMER2_TCCR2_CS21  1  // Clock Select Bit 1
+#define TIMER2_TCCR2_CS20  0  // Clock Select Bit 0
+#define TIMER2_TIMSK_OCIE2 7  // Output Compare Match Interrupt Enable
+#define TIMER2_TIMSK_TOIE2 6  // Overflow Interrupt Enable
+#define TIMER2_TIFR_OCF2   7  // Output Compare Match Flag
+#define TIMER2_TIFR_TOV2   6  // Overflow Flag
+
+/*------------------------------ USART REGISTERS ----------------------------*/
+// USART registers (UBRRH and UCSRC share an address, URSEL selects UCSRC)
+#define UART_UDR_REG    REG8(0x2C)  // USART I/O Data Register
+#define UART_UCSRA_REG  REG8(0x2B)  // USART Control and Status Register A
+#define UART_UCSRB_REG  REG8(0x2A)  // USART Control and Status Register B
+#define UART_UBRRL_REG  REG8(0x29)  // USART Baud Rate Register Low
+#define UART_UCSRC_REG  REG8(0x40)  // USART Control and Status Register C
+#define UART_UBRRH_REG  REG8(0x40)  // USART Baud Rate Register High
+
+// USART bit definitions
+#define UART_UCSRA_RXC   7  // Receive Complete
+#define UART_UCSRA_TXC   6  // Transmit Complete
+#define UART_UCSRA_UDRE  5  // Data Register Empty
+#define UART_UCSRA_U2X   1  // Double Transmission Speed
+#define UART_UCSRB_RXCIE 7  // RX Complete Interrupt Enable
+#define UART_UCSRB_TXCIE 6  // TX Complete Interrupt Enable
+#define UART_UCSRB_UDRIE 5  // Data Register Empty Interrupt Enable
+#define UART_UCSRB_RXEN  4  // Receiver Enable
+#define UART_UCSRB_TXEN  3  // Transmitter Enable
+#define UART_UCSRC_URSEL 7  // Register Select (1 = UCSRC)
+#define UART_UCSRC_UCSZ1 2  // Character Size Bit 1
+#define UART_UCSRC_UCSZ0 1  // Character Size Bit 0
 
 #endif /* REG_DEF_H_ */
\ No newline at end of file
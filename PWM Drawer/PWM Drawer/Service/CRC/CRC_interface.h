@@ -0,0 +1,16 @@
+#include "../std_types.h"
+
+#ifndef CRC_INTERFACE_H_
+#define CRC_INTERFACE_H_
+
+/* CRC (frame check) Interface
+   CRC-16/CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF, no reflection,
+   no final XOR ("123456789" -> 0x29B1). Byte-wise shifts and XORs without a
+   table, so nothing is added to SRAM; shared with the host-side decoder. */
+
+#define CRC_INIT 0xFFFF
+
+// Continue Copy_u16Crc over Copy_u8Len bytes
+u16 CRC_u16Update(u16 Copy_u16Crc, const u8 *Copy_pu8Data, u8 Copy_u8Len);
+
+#endif /* CRC_INTERFACE_H_ */
@@ -0,0 +1,21 @@
+/*
+   CRC-16/CCITT-FALSE, one byte per step
+*/
+
+#include "../std_types.h"
+#include "CRC_interface.h"
+
+/* The eight shift / conditional-XOR steps of the bitwise form folded into
+   fixed XORs of shifted copies (the polynomial's taps are bits 12, 5 and 0) */
+u16 CRC_u16Update(u16 Copy_u16Crc, const u8 *Copy_pu8Data, u8 Copy_u8Len)
+{
+    for (u8 i = 0; i < Copy_u8Len; i++)
+    {
+        Copy_u16Crc = (u16)((Copy_u16Crc >> 8) | (Copy_u16Crc << 8));
+        Copy_u16Crc ^= Copy_pu8Data[i];
+        Copy_u16Crc ^= (u8)(Copy_u16Crc & 0xFF) >> 4;
+        Copy_u16Crc ^= (u16)(Copy_u16Crc << 12);
+        Copy_u16Crc ^= (u16)((Copy_u16Crc & 0xFF) << 5);
+    }
+    return Copy_u16Crc;
+}
@@ -0,0 +1,36 @@
+#include "../std_types.h"
+
+#ifndef FMT_INTERFACE_H_
+#define FMT_INTERFACE_H_
+
+/* FMT (fixed-point text formatting) Interface
+   Small replacements for the sprintf() conversions the display needs. Digits
+   are produced by subtracting powers of ten, so no 32-bit division runs per
+   digit and nothing of the printf machinery is linked in.
+   Every function writes a NUL terminated string at Copy_pcBuf and returns the
+   number of characters written (terminator not counted), so calls chain:
+       p += FMT_u8String(p, "FREQ="); p += FMT_u8Fixed(p, hz, 3); ...
+   Units are SI symbols, with us for microseconds. */
+
+// Buffer sizes (terminator included) that fit any input
+#define FMT_FIXED_MAX  12   // FMT_u8Unsigned(), FMT_u8Fixed(): 10 digits and the point
+#define FMT_ENG_MAX    16   // FMT_u8Frequency(), FMT_u8Time(): number and unit
+
+// Copy a string (strcpy that returns the length)
+u8 FMT_u8String(char *Copy_pcBuf, const char *Copy_pcStr);
+
+// Unsigned decimal, same as "%lu"
+u8 FMT_u8Unsigned(char *Copy_pcBuf, u32 Copy_u32Val);
+
+// Fixed point: Copy_u32Val holds the value times 10^Copy_u8Decimals (0-9).
+// FMT_u8Fixed(buf, v, 3) prints the same as "%lu.%03u" with v / 1000, v % 1000
+u8 FMT_u8Fixed(char *Copy_pcBuf, u32 Copy_u32Val, u8 Copy_u8Decimals);
+
+// Engineering notation with three decimals: Copy_u32Val holds the quantity
+// times 10^Copy_u8Frac (0-9), the prefix is chosen so the integer part stays
+// below 1000 (the top prefix takes whatever is left). Digits past the third
+// decimal are truncated, like the integer divisions they replace.
+u8 FMT_u8Frequency(char *Copy_pcBuf, u32 Copy_u32Val, u8 Copy_u8Frac);   // Hz, kHz, MHz
+u8 FMT_u8Time(char *Copy_pcBuf, u32 Copy_u32Val, u8 Copy_u8Frac);        // us, ms, s
+
+#endif /* FMT_INTERFACE_H_ */
@@ -0,0 +1,90 @@
+#include <avr/pgmspace.h>
+#include "../std_types.h"
+#include "FMT_interface.h"
+
+// Powers of ten up to the largest that fits 32 bits, in flash (40 bytes of SRAM otherwise)
+static const u32 pow10[10] PROGMEM = {
+    1UL, 10UL, 100UL, 1000UL, 10000UL,
+    100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL
+};
+
+/* Copy a string, return its length */
+u8 FMT_u8String(char *Copy_pcBuf, const char *Copy_pcStr)
+{
+    u8 len = 0;
+    while ((Copy_pcBuf[len] = Copy_pcStr[len]) != '\0')
+        len++;
+    return len;
+}
+
+/* Unsigned decimal ("%lu") */
+u8 FMT_u8Unsigned(char *Copy_pcBuf, u32 Copy_u32Val)
+{
+    return FMT_u8Fixed(Copy_pcBuf, Copy_u32Val, 0);
+}
+
+/* Fixed point: Copy_u8Decimals digits after the point, at least one before it.
+   Each digit costs at most nine 32-bit subtractions instead of a division. */
+u8 FMT_u8Fixed(char *Copy_pcBuf, u32 Copy_u32Val, u8 Copy_u8Decimals)
+{
+    u8 len = 0;
+
+    for (s8 exp = 9; exp >= 0; exp--)
+    {
+        char digit = '0';
+        u32 step = pgm_read_dword(&pow10[exp]);
+        while (Copy_u32Val >= step)
+        {
+            Copy_u32Val -= step;
+            digit++;
+        }
+
+        // Leading zeros are dropped down to the units digit
+        if (len == 0 && digit == '0' && exp > Copy_u8Decimals)
+            continue;
+
+        if (Copy_u8Decimals != 0 && exp == Copy_u8Decimals - 1)
+            Copy_pcBuf[len++] = '.';
+        Copy_pcBuf[len++] = digit;
+    }
+
+    Copy_pcBuf[len] = '\0';
+    return len;
+}
+
+/* Engineering notation over three prefixes of one unit (1, 10^3, 10^6),
+   printed with three decimals of the chosen prefix */
+static u8 FMT_u8Engineering(char *Copy_pcBuf, u32 Copy_u32Val, u8 Copy_u8Frac,
+                            const char *const Copy_apcUnit[3])
+{
+    u32 whole = Copy_u32Val / pgm_read_dword(&pow10[Copy_u8Frac]);
+    u8 prefix = 0;
+
+    if (whole >= 1000000UL)
+        prefix = 2;
+    else if (whole >= 1000UL)
+        prefix = 1;
+
+    // Value in thousandths of the chosen prefix: 10^(3 * prefix - 3) base units
+    s8 shift = (s8)(Copy_u8Frac + 3 * prefix) - 3;
+    u32 scaled;
+    if (shift >= 0)
+        scaled = Copy_u32Val / pgm_read_dword(&pow10[shift]);
+    else
+        scaled = Copy_u32Val * pgm_read_dword(&pow10[-shift]);   // Only below 1000 base units, cannot overflow
+
+    u8 len = FMT_u8Fixed(Copy_pcBuf, scaled, 3);
+    return len + FMT_u8String(Copy_pcBuf + len, Copy_apcUnit[prefix]);
+}
+
+u8 FMT_u8Frequency(char *Copy_pcBuf, u32 Copy_u32Val, u8 Copy_u8Frac)
+{
+    static const char *const units[3] = { "Hz", "kHz", "MHz" };
+    return FMT_u8Engineering(Copy_pcBuf, Copy_u32Val, Copy_u8Frac, units);
+}
+
+u8 FMT_u8Time(char *Copy_pcBuf, u32 Copy_u32Val, u8 Copy_u8Frac)
+{
+    static const char *const units[3] = { "us", "ms", "s" };
+    return FMT_u8Engineering(Copy_pcBuf, Copy_u32Val, Copy_u8Frac, units);
+}
@@ -1,18 +1,20 @@
 #ifndef STD_TYPES_H_
 #define STD_TYPES_H_
 
+#include <stdint.h>
+
 /* Standard data type definitions for embedded systems */
-// Unsigned integer types
-typedef  unsigned char u8;
-typedef unsigned short u16;
-typedef  unsigned int u32;
-typedef unsigned long long u64;
+// Unsigned integer types (fixed width: int is only 16 bits on AVR)
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
 
 // Signed integer types
-typedef  signed char s8;
-typedef signed short s16;
-typedef  signed int s32;
-typedef signed long long s64;
+typedef int8_t  s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef int64_t s64;
 
 // Floating point types
 typedef float f32;
@@ -1,228 +1,660 @@
 /*
  * PWM Analyzer with GLCD waveform display
- * CPU = 16 MHz, Timer1 prescaler = 8
+ * CPU = 16 MHz, Timer1 prescaler auto-ranged (1..1024), 32-bit capture timestamps
  * Measures PWM frequency, duty cycle, and period
+ * Fast signals switch to gated edge counting on T1 (FCNT_ENABLE)
  * Displays waveform graphically and parameters textually
+ * Edges are paired continuously; the screen is refreshed at TICK_FRAME_HZ (Timer2 tick)
+ * INT0-INT2 add timestamped input channels on the same time base (EXTI_ENABLE)
+ * Auto / normal / single-shot records around a trigger edge or pulse (ICU_TRIGGER_ENABLE)
+ * GLCD writes can be queued and sent from the tick in bounded slices (GLCD_ASYNC_ENABLE)
+ * Fonts are read from flash; the frequency can be shown in 10x16 digits (FONT_BIG_FREQ_ENABLE)
  */
-#define F_CPU 16000000UL
+#ifndef F_CPU
+#define F_CPU 16000000UL  // Normally set project-wide (drivers need it too)
+#endif
 #include <util/delay.h>
 #include <avr/io.h>
 #include <avr/interrupt.h>
-#include <stdio.h>
+#include <avr/sleep.h>
 #include <string.h>
 
 #include "Service/std_types.h"
 #include "Service/bit_math.h"
+#include "Service/FMT/FMT_interface.h"
 #include "MCAL/DIO/DIO_interface.h"
+#include "MCAL/ICU/ICU_interface.h"
+#include "MCAL/ICU/ICU_cfg.h"
+#include "MCAL/FCNT/FCNT_interface.h"
+#include "MCAL/FCNT/FCNT_cfg.h"
+#include "MCAL/TICK/TICK_interface.h"
+#include "MCAL/TICK/TICK_cfg.h"
+#include "MCAL/EXTI/EXTI_interface.h"
+#include "MCAL/EXTI/EXTI_cfg.h"
+#include "MCAL/ADC/ADC_cfg.h"
 #include "HAL/GLCD/GLCD_int.h"
+#include "HAL/GLCD/GLCD_cfg.h"
+#include "HAL/FONT/FONT_int.h"
+#include "HAL/FONT/FONT_cfg.h"
+#include "APP/WAVE/WAVE_int.h"
+#include "APP/WAVE/WAVE_cfg.h"
+#include "APP/ATRC/ATRC_int.h"
+#include "APP/ATRC/ATRC_cfg.h"
+#include "APP/STRIP/STRIP_int.h"
+#include "APP/STRIP/STRIP_cfg.h"
+#include "APP/STAT/STAT_int.h"
+#include "APP/STAT/STAT_cfg.h"
+#include "APP/MCH/MCH_int.h"
+#include "APP/TLM/TLM_int.h"
+#include "APP/TLM/TLM_cfg.h"
+#include "APP/HIST/HIST_cfg.h"
+#include "MCAL/UART/UART_cfg.h"
+
+#if FCNT_ENABLE && GLCD_CTRL_PORT == DIO_PORTB && \
+    (GLCD_RS_PIN == DIO_PIN_1 || GLCD_RW_PIN == DIO_PIN_1 || GLCD_EN_PIN == DIO_PIN_1 || \
+     GLCD_CS1_PIN == DIO_PIN_1 || GLCD_CS2_PIN == DIO_PIN_1 || GLCD_RST_PIN == DIO_PIN_1)
+#error "FCNT counts on T1 (PB1): move the GLCD control line off PB1 in GLCD_cfg.h"
+#endif
+
+#if EXTI_ENABLE && EXTI_INT2_ENABLE && GLCD_CTRL_PORT == DIO_PORTB && \
+    (GLCD_RS_PIN == DIO_PIN_2 || GLCD_RW_PIN == DIO_PIN_2 || GLCD_EN_PIN == DIO_PIN_2 || \
+     GLCD_CS1_PIN == DIO_PIN_2 || GLCD_CS2_PIN == DIO_PIN_2 || GLCD_RST_PIN == DIO_PIN_2)
+#error "INT2 senses PB2: move the GLCD control line off PB2 in GLCD_cfg.h"
+#endif
+
+#if ADC_ENABLE && GLCD_DATA_PORT == DIO_PORTA
+#error "The ADC inputs are PA0-PA7: move the GLCD data bus off PORTA in GLCD_cfg.h"
+#endif
+#if ADC_ENABLE && FCNT_ENABLE
+#error "ADC sampling and the FCNT gate both need Timer0: enable only one"
+#endif
+#if ADC_ENABLE && STRIP_ENABLE
+#error "The analog trace and the strip chart share the screen: enable only one"
+#endif
+
+// Captured edges are plotted unless another view owns the plot area
+#define WAVE_PLOT_ENABLE (!STRIP_ENABLE && !ADC_ENABLE)
+
+#if ICU_TRIGGER_ENABLE && (!WAVE_PLOT_ENABLE || EXTI_ENABLE)
+#error "Triggered records are shown on the edge plot, with its status on the DIV line: disable STRIP, ADC and EXTI"
+#endif
+
+#if FONT_BIG_FREQ_ENABLE && (STAT_PAGE_ENABLE || EXTI_ENABLE || STRIP_ENABLE)
+#error "The large frequency readout takes two status lines: disable STAT_PAGE, EXTI and STRIP"
+#endif
+
+/* SRAM budget: the ATmega32 has 2 KB and the image is linked without
+   --gc-sections, so every buffer compiled in takes its place. The sums use
+   AVR sizes (5-byte edge records, 2-byte pointers); RAM_STATICS covers the
+   scalars, counters and string literals every build has, and RAM_STACK the
+   deepest main-loop call chain (text line -> font -> bus) plus one
+   interrupt frame. Estimated from the host objects, no avr-size here */
+#define RAM_SIZE     2048
+#define RAM_STACK    160
+#define RAM_STATICS  357
+#define RAM_BUFFERS ( \
+    (GLCD_FRAMEBUFFER_ENABLE ? GLCD_PAGES * GLCD_WIDTH + 32 : 0) + /* Plus dirty spans */ \
+    GLCD_TEXT_LINES * 24 +                                /* Shown text and font */ \
+    (GLCD_ASYNC_ENABLE ? GLCD_QUEUE_SIZE * 5 + 256 + 8 : 0) + /* Queue, byte ring */ \
+    ICU_RING_SIZE * 5 + \
+    (ICU_TRIGGER_ENABLE ? ICU_ACQ_SIZE * 5 + 24 : 0) + \
+    HIST_SIZE * 2 + \
+    (EXTI_ENABLE ? EXTI_CHANNELS * (EXTI_RING_SIZE * 5 + 64) : 0) + /* With MCH */ \
+    (ADC_ENABLE ? ADC_COLUMNS * 2 + 32 : 0) + \
+    (FCNT_ENABLE ? 12 : 0) + \
+    (STRIP_ENABLE ? 34 : 0) + \
+    (TLM_ENABLE ? UART_TX_SIZE + 13 + (TLM_PERIODS_ENABLE ? 2 + TLM_PERIOD_BATCH * 8 : 0) : 0))
+
+// Host builds of feature combinations that do not fit set RAM_BUDGET_CHECK=0
+#ifndef RAM_BUDGET_CHECK
+#define RAM_BUDGET_CHECK 1
+#endif
+#if RAM_BUDGET_CHECK && RAM_BUFFERS + RAM_STATICS + RAM_STACK > RAM_SIZE
+#error "The configured buffers leave less than RAM_STACK bytes of SRAM for the stack: shrink a ring or disable a feature"
+#endif
 
 /* ---------------------- Global Variables ---------------------- */
-volatile uint16_t last_rise = 0;
-volatile uint16_t high_start = 0;
-volatile uint16_t pulse_high_ticks = 0;
-volatile uint16_t period_ticks = 0;
-volatile uint8_t new_measurement = 0;
-volatile uint8_t waiting_for_fall = 0;
+// Edge pairing state, carried across batches drained from the capture ring
+static uint32_t last_rise = 0;
+static uint32_t last_fall = 0;
+static uint8_t have_rise = 0;
+static uint8_t have_fall = 0;
+
+// Totals (CPU cycles) over every complete period since the last display update
+static uint32_t period_sum = 0;
+static uint32_t high_sum = 0;
+static uint16_t period_count = 0;
+
+// Statistics of the last full STAT_WINDOW of periods
+static STAT_Result_t stats;
+static uint8_t have_stats = 0;
+
+#if FCNT_ENABLE
+// 1 while Timer1 counts edges on T1 instead of capturing them
+static uint8_t count_mode = 0;
+#endif
+
+#if EXTI_ENABLE
+// Frames without a complete period before a channel row shows "-"
+#define CHANNEL_TIMEOUT_FRAMES (2 * TICK_FRAME_HZ)
+
+static const uint8_t channel_enabled[EXTI_CHANNELS] = { EXTI_INT0_ENABLE, EXTI_INT1_ENABLE, EXTI_INT2_ENABLE };
+static MCH_Result_t channel[EXTI_CHANNELS];
+static uint8_t channel_idle[EXTI_CHANNELS];
+#endif
 
 /* ---------------------- Function Prototypes ---------------------- */
-void Timer1_InputCapture_Init(void);
-void Draw_Waveform(float duty, float freq);
-void Clear_TextArea(void);
+void Process_Edges(void);
+#if EXTI_ENABLE
+void Update_Channel(uint8_t ch);
+#endif
+#if STAT_PAGE_ENABLE
+void Display_TimeLine(uint8_t line, const char *label, uint32_t cycles);
+#endif
+#if FONT_BIG_FREQ_ENABLE
+void Display_BigFreq(uint32_t freq_val, uint8_t freq_frac);
+
+// Column of the label and unit right of the large digits ("999.999" ends at 84)
+#define BIG_FREQ_LABEL_COL 104
+#endif
+
+/* ---------------------- Fixed-Point Helpers ---------------------- */
+// All measurement math is integer. Working units and their precision:
+//   period / high time  CPU cycles (62.5 ns), averaged over every captured period
+//   duty                0.1 % steps (permille), rounded to nearest
+//   frequency           mHz from the capture engine, whole Hz from the counter
+//   period for display  ns up to 4.29 s, whole us beyond
+#define CYCLES_PER_US (F_CPU / 1000000UL)
+
+/* num * 1000 / den rounded to nearest, for num <= den. Both are shifted right
+   until num * 1000 fits 32 bits; that only happens for high times above 2^22
+   cycles, where the dropped bits are far below one 0.1 % step. */
+static uint16_t Ratio_Permille(uint32_t num, uint32_t den)
+{
+    while (num > 0xFFFFFFFFUL / 1000)
+    {
+        num >>= 1;
+        den >>= 1;
+    }
+    if (den == 0) return 0;
+
+    uint32_t q = num * 1000UL / den;
+    uint32_t r = num * 1000UL % den;
+    if (r >= den - r) q++;      // Round half up without forming 2 * r
+    return (q > 1000) ? 1000 : (uint16_t)q;
+}
 
-/* ---------------------- Interrupt Service Routine ---------------------- */
-ISR(TIMER1_CAPT_vect)
+/* F_CPU / cycles in mHz, truncated. Three decimal digits by long division, so
+   sub-Hz inputs keep their fraction; 0 when the result would not fit 32 bits */
+static uint32_t Cycles_To_MilliHz(uint32_t cycles)
 {
-    static uint16_t rise, fall;
+    uint32_t whole = F_CPU / cycles;
+    uint32_t rem = F_CPU % cycles;
 
-    if (TCCR1B & (1 << ICES1))   // Rising edge detected
-    {
-        rise = ICR1;
-        period_ticks = rise - last_rise;   // time between rising edges
-        last_rise = rise;
+    if (whole > 0xFFFFFFFFUL / 1000) return 0;
 
-        // Switch to detect falling edge for high pulse width
-        TCCR1B &= ~(1 << ICES1);
-        waiting_for_fall = 1;
+    // rem * 10 must fit: periods above 26 s lose their four lowest bits
+    if (cycles > 0xFFFFFFFFUL / 10)
+    {
+        rem >>= 4;
+        cycles >>= 4;
     }
-    else if (waiting_for_fall)   // Falling edge detected
+    for (uint8_t i = 0; i < 3; i++)
     {
-        fall = ICR1;
-        pulse_high_ticks = fall - last_rise;
-        waiting_for_fall = 0;
-        TCCR1B |= (1 << ICES1);   // Back to rising edge
-        new_measurement = 1;
+        rem *= 10;
+        whole = whole * 10 + rem / cycles;
+        rem %= cycles;
     }
+    return whole;
 }
 
-/* ---------------------- Timer1 Input Capture Init ---------------------- */
-void Timer1_InputCapture_Init(void)
+/* Period in cycles as ns (3 decimals of us) while that fits 32 bits, else us */
+static uint32_t Cycles_To_Time(uint32_t cycles, uint8_t *frac)
 {
-    TCCR1A = 0;
-    TCCR1B = (1 << ICES1) | (1 << CS11); // capture rising edge, prescaler=8
-    TIMSK |= (1 << TICIE1);
-    sei();
+    if (cycles / CYCLES_PER_US < 0xFFFFFFFFUL / 1000)
+    {
+        *frac = 3;
+        return cycles / CYCLES_PER_US * 1000UL + (cycles % CYCLES_PER_US) * 1000UL / CYCLES_PER_US;
+    }
+    *frac = 0;
+    return cycles / CYCLES_PER_US;
+}
+
+/* ---------------------- Drain Capture Ring ---------------------- */
+void Process_Edges(void)
+{
+    ICU_Edge_t batch[16];
+    uint8_t n;
+
+    while ((n = ICU_u8ReadEdges(batch, 16)) > 0)
+    {
+        for (uint8_t i = 0; i < n; i++)
+        {
+            uint32_t ts = batch[i].timestamp;
+
+#if WAVE_PLOT_ENABLE
+            WAVE_voidAddEdge(&batch[i]);
+#endif
+
+            // Edges were dropped or the prescaler changed: restart pairing
+            if (batch[i].flags & ICU_FLAG_GAP)
+            {
+                have_rise = have_fall = 0;
+                STAT_voidBreak();
+            }
+
+            if (batch[i].flags & ICU_FLAG_RISING)
+            {
+                // Rising edge closes the period that started at last_rise
+                if (have_rise && have_fall)
+                {
+                    uint32_t period = ICU_u32TicksToCycles(ts - last_rise, batch[i].flags);
+                    uint32_t high = ICU_u32TicksToCycles(last_fall - last_rise, batch[i].flags);
+
+                    period_sum += period;
+                    high_sum += high;
+                    period_count++;
+                    STAT_voidAddPeriod(period, high);
+#if TLM_ENABLE
+                    TLM_voidAddPeriod(period, high);
+#endif
+                }
+                last_rise = ts;
+                have_rise = 1;
+                have_fall = 0;
+            }
+            else if (have_rise)
+            {
+                last_fall = ts;
+                have_fall = 1;
+            }
+        }
+    }
 }
 
 /* ---------------------- Main Function ---------------------- */
 int main(void)
 {
     char buf[32];
-    uint8_t duty_cycle = 0;
+    uint16_t duty_permille = 0;      // Kept while the counter runs (it cannot see duty)
 
     GLCD_voidInit();
-    Timer1_InputCapture_Init();
 
     GLCD_voidGotoXY(0, 0);
     GLCD_voidDisplayString((uint8_t *)"PWM ANALYZER");
+#if GLCD_ASYNC_ENABLE
+    GLCD_voidSync();                 // The tick that drains the queue is not running yet
+#endif
     _delay_ms(1000);
     GLCD_voidClear();
+#if FONT_BIG_FREQ_ENABLE
+    GLCD_voidDisplayText(&FONT_5x7, 0, BIG_FREQ_LABEL_COL, "FREQ");
+#endif
+
+#if STRIP_ENABLE
+    STRIP_voidInit();
+#elif ADC_ENABLE
+    ATRC_voidInit();
+#else
+    WAVE_voidInit();
+#endif
+
+    // Capture starts after the splash so a fast input cannot flood it meanwhile
+#if TLM_ENABLE
+    TLM_voidInit();
+#endif
+    ICU_voidInit();
+    TICK_voidInit();
+#if EXTI_ENABLE
+    // Timestamps come from Timer1, so after the ICU has started it
+    MCH_voidInit();
+    EXTI_voidInit();
+#endif
+
+#if FCNT_ENABLE
+    FCNT_voidInit();
+
+    // First look with the counter: its load does not depend on the signal rate,
+    // so even an input fast enough to saturate the capture ISR gets classified
+    ICU_voidSuspend();
+    FCNT_voidStart();
+    count_mode = 1;
+#endif
+
+    set_sleep_mode(SLEEP_MODE_IDLE);
 
     while (1)
     {
-        if (new_measurement)
+        // Idle until the capture ISR queues an edge or a tick fires (sei + sleep is atomic)
+        cli();
+#if EXTI_ENABLE
+        if (ICU_u8Available() == 0 && EXTI_u8Pending() == 0)
+#else
+        if (ICU_u8Available() == 0)
+#endif
         {
-            new_measurement = 0;
-
-            /* ----- Compute Frequency & Duty Cycle ----- */
-            uint32_t freq_hz = 0;
-            if (period_ticks > 0)
-                freq_hz = (2000000UL / period_ticks); // 16MHz/8 = 2MHz tick rate
+            sleep_enable();
+            sei();
+            sleep_cpu();
+            sleep_disable();
+        }
+        sei();
+
+        Process_Edges();
+#if EXTI_ENABLE
+        MCH_voidProcess();
+#endif
+
+        // Edges are paired and summed on every wake-up; results, mode changes
+        // and the screen only once per display frame
+        if (!TICK_u8FrameDue())
+            continue;
+
+#if GLCD_ASYNC_ENABLE
+        // The last frame is still going out: skip this one rather than wait,
+        // edges keep being paired meanwhile
+        if (!GLCD_u8FrameDone())
+        {
+            GLCD_voidFlush();
+            continue;
+        }
+#endif
+
+#if ADC_ENABLE
+        ATRC_voidRefresh();
+#elif !STRIP_ENABLE
+        WAVE_voidRefresh();
+#endif
+
+        uint8_t update = 0;
+        uint32_t freq_hz = 0;
+        // Display values as FMT takes them: quantity * 10^frac (Hz, us)
+        uint32_t freq_val = 0, time_val = 0;
+        uint8_t freq_frac = 0, time_frac = 0;
+#if TLM_ENABLE
+        uint32_t tlm_period = 0;         // Averaged period for the telemetry record, 0 while counting
+#endif
+
+#if FCNT_ENABLE
+        if (count_mode)
+        {
+            // Edges queued before the capture engine was suspended belong to no period
+            period_sum = high_sum = 0;
+            period_count = 0;
 
-            if (period_ticks > 0)
+            // Direct count: one result per gate window, duty keeps its last captured value
+            if (FCNT_u8GetFrequency(&freq_hz))
             {
-                duty_cycle = (uint8_t)((pulse_high_ticks * 100UL) / period_ticks);
-                if (duty_cycle > 100) duty_cycle = 100;
+                if (freq_hz < FCNT_LEAVE_HZ)
+                {
+                    FCNT_voidStop();
+                    ICU_voidResume();
+                    count_mode = 0;
+                }
+                else
+                {
+                    freq_val = freq_hz;
+                    freq_frac = 0;
+                    time_val = (1000000000UL + freq_hz / 2) / freq_hz;     // ns, rounded
+                    time_frac = 3;
+                    update = 1;
+                }
             }
+        }
+#endif
 
-            /* ----- Compute Period ----- */
-            uint32_t period_us = (uint32_t)(period_ticks * 0.5); // 0.5 s per tick
-            uint32_t period_ms_int = period_us / 1000;
-            uint16_t period_ms_dec = period_us % 1000;
-
-            /* ----- Display Results (clear only text area) ----- */
-            Clear_TextArea();
-
-            uint32_t freq_khz_int = freq_hz / 1000;
-            uint16_t freq_khz_dec = freq_hz % 1000;
-
-            GLCD_voidGotoXY(0, 0);
-            sprintf(buf, "FREQ=%lu.%03uKHZ", freq_khz_int, freq_khz_dec);
-            GLCD_voidDisplayString((uint8_t *)buf);
+        if (period_count > 0)
+        {
+            // Average over every period captured since the last frame
+            uint32_t period_cycles = period_sum / period_count;
+            uint32_t pulse_high_cycles = high_sum / period_count;
+            period_sum = high_sum = 0;
+            period_count = 0;
+
+            // Keep the next measurements inside the 16-bit window of the finest prescaler
+            ICU_voidAutoRange(period_cycles);
+#if ADC_ENABLE && ATRC_TIMEBASE_US == 0
+            ATRC_voidAutoTimebase(period_cycles);
+#elif WAVE_TIMEBASE_US == 0 && WAVE_PLOT_ENABLE
+            WAVE_voidAutoTimebase(period_cycles);
+#endif
+
+            /* ----- Compute Frequency, Duty Cycle & Period ----- */
+            if (period_cycles > 0)
+            {
+                freq_hz = F_CPU / period_cycles;
+                freq_val = Cycles_To_MilliHz(period_cycles);
+                freq_frac = 3;
+                if (freq_val == 0)
+                {
+                    freq_val = freq_hz;
+                    freq_frac = 0;
+                }
+
+                duty_permille = Ratio_Permille(pulse_high_cycles, period_cycles);
+                time_val = Cycles_To_Time(period_cycles, &time_frac);
+#if TLM_ENABLE
+                tlm_period = period_cycles;
+#endif
+                update = 1;
+            }
 
-            GLCD_voidGotoXY(1, 80);
-            sprintf(buf, "DUTY=%u%%", duty_cycle);
-            GLCD_voidDisplayString((uint8_t *)buf);
+#if FCNT_ENABLE
+            // Fast enough for the counter: stop paying one interrupt per edge
+            // (a saturated capture ISR also lands here, its edges come too close together)
+            if (freq_hz > FCNT_ENTER_HZ)
+            {
+#if WAVE_PLOT_ENABLE
+                // No edges to plot from here on
+                WAVE_voidClear();
+#endif
+                STAT_voidReset();
+                have_stats = 0;
+                ICU_voidSuspend();
+                FCNT_voidStart();
+                count_mode = 1;
+            }
+#endif
+        }
 
-            GLCD_voidGotoXY(2, 0);
-            sprintf(buf, "TIME=%lu.%03uMS", period_ms_int, period_ms_dec);
-            GLCD_voidDisplayString((uint8_t *)buf);
+        if (STAT_u8GetResult(&stats))
+        {
+            have_stats = 1;
+#if TLM_ENABLE
+            TLM_voidSendStats(&stats);
+#endif
+        }
 
-            //GLCD_voidGotoXY(3, 0);
-            //sprintf(buf, "TICKS=%lu", (uint32_t)period_ticks);
-            //GLCD_voidDisplayString((uint8_t *)buf);
+#if EXTI_ENABLE && !STRIP_ENABLE
+        // INT channel rows: every frame, so a stopped input times out
+        for (uint8_t ch = 0; ch < EXTI_CHANNELS; ch++)
+            Update_Channel(ch);
+#endif
 
-            /* Draw waveform */
-            Draw_Waveform(duty_cycle, freq_hz);
+        if (update)
+        {
+            char *p;
+
+#if TLM_ENABLE
+            TLM_voidSendMeasurement(freq_val, freq_frac, duty_permille, tlm_period,
+                                    (tlm_period == 0) ? TLM_MEAS_COUNTING : 0);
+#endif
+
+#if STRIP_ENABLE
+            // One header line above the duty / frequency history
+            p = buf + FMT_u8String(buf, "F=");
+            p += FMT_u8Frequency(p, freq_val, freq_frac);
+            p += FMT_u8String(p, " D=");
+            p += FMT_u8Fixed(p, duty_permille, 1);
+            FMT_u8String(p, "%");
+            STRIP_voidSetHeader(buf);
+            STRIP_voidAddSample(duty_permille, freq_hz);
+            STRIP_voidRefresh();
+            (void)time_val;
+            (void)time_frac;
+#elif EXTI_ENABLE
+            // Stacked channel rows: ICP1 on top, INT0-INT2 below (Update_Channel)
+            p = buf + FMT_u8String(buf, "C ");
+            p += FMT_u8Frequency(p, freq_val, freq_frac);
+            p += FMT_u8String(p, " ");
+            p += FMT_u8Fixed(p, duty_permille, 1);
+            FMT_u8String(p, "%");
+            GLCD_voidDisplayLine(0, buf);
+            (void)time_val;
+            (void)time_frac;
+#else
+            /* ----- Display Results (only glyphs that changed are sent) ----- */
+
+            // Engineering units, three decimals: 0.500Hz, 1.000kHz, 22.222us ...
+#if FONT_BIG_FREQ_ENABLE
+            Display_BigFreq(freq_val, freq_frac);
+#else
+            p = buf + FMT_u8String(buf, "FREQ=");
+            FMT_u8Frequency(p, freq_val, freq_frac);
+            GLCD_voidDisplayLine(0, buf);
+#endif
+
+#if STAT_PAGE_ENABLE
+            if (have_stats)
+            {
+                // Mean period and period jitter over the last full window;
+                // '~' marks values from clamped deviations (approximate)
+                Display_TimeLine(1, stats.clamped ? "AVG~" : "AVG=", stats.period.mean);
+                Display_TimeLine(2, "JPP=", stats.jitter_pp);
+                Display_TimeLine(3, stats.clamped ? "RMS~" : "RMS=", stats.jitter_rms);
+            }
+            else
+#endif
+            {
+#if FONT_BIG_FREQ_ENABLE
+                // Page 1 belongs to the large digits
+                p = buf + FMT_u8String(buf, "D=");
+                p += FMT_u8Fixed(p, duty_permille, 1);
+                p += FMT_u8String(p, "% T=");
+                FMT_u8Time(p, time_val, time_frac);
+                GLCD_voidDisplayLine(2, buf);
+#else
+                p = buf + FMT_u8String(buf, "DUTY=");
+                p += FMT_u8Fixed(p, duty_permille, 1);
+                FMT_u8String(p, "%");
+                GLCD_voidDisplayLine(1, buf);
+
+                p = buf + FMT_u8String(buf, "TIME=");
+                FMT_u8Time(p, time_val, time_frac);
+                GLCD_voidDisplayLine(2, buf);
+#endif
+
+                // Plot timebase (no trace while the counter runs)
+                p = buf + FMT_u8String(buf, "DIV=");
+#if ADC_ENABLE
+                FMT_u8Time(p, ATRC_u32GetTimebase(), 0);
+#else
+                p += FMT_u8Time(p, WAVE_u32GetTimebase(), 0);
+#endif
+#if ICU_TRIGGER_ENABLE
+                {
+                    // Acquisition state after the timebase
+                    static const char *const acq_name[] = { "", " WAIT", " TRIG", " STOP" };
+                    FMT_u8String(p, acq_name[WAVE_u8AcqStatus()]);
+                }
+#endif
+#if FCNT_ENABLE
+                if (count_mode)
+                    buf[0] = '\0';
+#endif
+                GLCD_voidDisplayLine(3, buf);
+            }
+#endif
         }
     }
 }
 
-/* ---------------------- Draw Waveform ---------------------- */
-void Draw_Waveform(float duty, float freq)
+#if STAT_PAGE_ENABLE
+/* ---------------------- Statistics Line ---------------------- */
+// label + a duration given in CPU cycles, on text line `line`
+void Display_TimeLine(uint8_t line, const char *label, uint32_t cycles)
 {
-	static uint8_t buffer[128] = {0}; // waveform level per column
-	static uint8_t t = 0;             // time index for PWM shape
-
-	const uint8_t y_top = 40;
-	const uint8_t y_bottom = 63;
-	//const uint8_t height = y_bottom - y_top + 1;
-	const uint8_t period_px = 50;
-
-	// Calculate on-time pixels for PWM
-	uint8_t high_px = (uint8_t)(period_px * (duty / 100.0));
-
-	// Generate next PWM point (1 pixel wide)
-	uint8_t bit_val = (t < high_px) ? 1 : 0;
-	t = (t + 1) % period_px;
-
-	// Scroll buffer left and add new bit
-	for (uint8_t i = 0; i < 127; i++) buffer[i] = buffer[i + 1];
-	buffer[127] = bit_val;
-
-	// Clear waveform area (pages 57)
-	for (uint8_t page = 5; page < 8; page++) {
-		GLCD_voidGotoXY(page, 0);
-		for (uint8_t col = 0; col < 64; col++) GLCD_voidWriteData(0x00, 1);
-		GLCD_voidGotoXY(page, 64);
-		for (uint8_t col = 0; col < 64; col++) GLCD_voidWriteData(0x00, 2);
-	}
-
-	// Draw waveform (continuous thick line with vertical connections)
-	for (uint8_t x = 0; x < 128; x++) {
-		uint8_t y_current = buffer[x] ? y_top : y_bottom;  // current waveform level
-		uint8_t y_prev = (x > 0) ? (buffer[x-1] ? y_top : y_bottom) : y_current; // previous level
-
-		// Draw horizontal line (2 pixels thick)
-		for (int dy = 0; dy < 2; dy++) {
-			uint8_t yy = y_current + dy;
-			if (yy > y_bottom) break;
-
-			uint8_t page = yy / 8;
-			uint8_t bit = yy % 8;
-			uint8_t chip = (x < 64) ? 1 : 2;
-			uint8_t local_col = (x < 64) ? x : (x - 64);
-
-			GLCD_voidCommand(0xB8 | page, chip);
-			GLCD_voidCommand(0x40 | local_col, chip);
-			GLCD_voidWriteData(1 << bit, chip);
-		}
-
-// Draw vertical connecting line when level changes - CONTINUOUS VERSION
-if (x > 0 && y_current != y_prev) {
-	// Draw vertical line with 2-3 pixel width
-	for (int dx = 0; dx < 2; dx++) {
-		uint8_t xx = x - dx;
-		
-		// Draw from y_top to y_bottom
-		for (uint8_t y_vert = y_top; y_vert <= y_bottom; y_vert++) {
-			uint8_t page = y_vert / 8;
-			uint8_t bit = y_vert % 8;
-			uint8_t chip = (xx < 64) ? 1 : 2;
-			uint8_t local_col = (xx < 64) ? xx : (xx - 64);
-			
-			// Set position
-			GLCD_voidCommand(0xB8 | page, chip);
-			GLCD_voidCommand(0x40 | local_col, chip);
-			
-			// Read current byte value
-			uint8_t current_byte = GLCD_u8ReadData(chip);
-			
-			// Set the bit for this pixel
-			current_byte |= (1 << bit);
-			
-			// Write back the modified byte
-			GLCD_voidCommand(0xB8 | page, chip);
-			GLCD_voidCommand(0x40 | local_col, chip);
-			GLCD_voidWriteData(current_byte, chip);
-		}
-	}
+    char buf[8 + FMT_ENG_MAX];
+    uint8_t frac;
+    uint32_t val = Cycles_To_Time(cycles, &frac);
+
+    FMT_u8Time(buf + FMT_u8String(buf, label), val, frac);
+    GLCD_voidDisplayLine(line, buf);
 }
-	}
+#endif
 
-	_delay_ms(10); // control waveform speed
+#if FONT_BIG_FREQ_ENABLE
+/* ---------------------- Large Frequency Readout ---------------------- */
+// The number in FONT_10x16 on pages 0-1 (only changed digits are redrawn),
+// the unit in 5x7 beside its lower half, under the "FREQ" label
+void Display_BigFreq(uint32_t freq_val, uint8_t freq_frac)
+{
+    static char unit_shown[4];
+    char buf[FMT_ENG_MAX];
+    char *unit;
+
+    FMT_u8Frequency(buf, freq_val, freq_frac);
+    // Digits and the point sort below the letters
+    for (unit = buf; *unit != '\0' && *unit < 'A'; unit++)
+        ;
+
+    if (strcmp(unit, unit_shown) != 0)
+    {
+        char cell[4] = "   ";
+
+        // Blank-padded, so "Hz" clears the last letter of "kHz"
+        memcpy(cell, unit, strlen(unit));
+        GLCD_voidDisplayText(&FONT_5x7, 1, BIG_FREQ_LABEL_COL, cell);
+        strcpy(unit_shown, unit);
+    }
+
+    *unit = '\0';
+    GLCD_voidDisplayLineFont(&FONT_10x16, 0, buf);
 }
+#endif
 
-/* ---------------------- Clear Only Text Area ---------------------- */
-void Clear_TextArea(void)
+#if EXTI_ENABLE
+/* ---------------------- Channel Rows ---------------------- */
+// "<n> <frequency> <duty>%" for INT channel n since the last frame, on the
+// text line below ICP1's; "-" once it stopped, "OFF" when not built in
+void Update_Channel(uint8_t ch)
 {
-    for (uint8_t page = 0; page < 4; page++)
+    char buf[8 + FMT_ENG_MAX];
+    char *p = buf;
+    uint8_t line = 1 + ch;
+
+    *p++ = '0' + ch;
+    *p++ = ' ';
+    if (!channel_enabled[ch])
     {
-        for (uint8_t chip = 1; chip <= 2; chip++)
-        {
-            GLCD_voidCommand(0xB8 | page, chip);
-            GLCD_voidCommand(0x40, chip);
-            for (uint8_t col = 0; col < 64; col++)
-                GLCD_voidWriteData(0x00, chip);
-        }
+        FMT_u8String(p, "OFF");
+        GLCD_voidDisplayLine(line, buf);
+        return;
+    }
+
+    if (MCH_u8GetResult(ch, &channel[ch]))
+        channel_idle[ch] = 0;
+    else if (channel_idle[ch] < CHANNEL_TIMEOUT_FRAMES)
+        channel_idle[ch]++;
+
+    if (channel[ch].count == 0 || channel[ch].period == 0 || channel_idle[ch] >= CHANNEL_TIMEOUT_FRAMES)
+    {
+        FMT_u8String(p, "-");
+        GLCD_voidDisplayLine(line, buf);
+        return;
+    }
+
+    uint32_t freq_val = Cycles_To_MilliHz(channel[ch].period);
+    uint8_t freq_frac = 3;
+    if (freq_val == 0)
+    {
+        freq_val = F_CPU / channel[ch].period;
+        freq_frac = 0;
     }
+    p += FMT_u8Frequency(p, freq_val, freq_frac);
+    p += FMT_u8String(p, " ");
+    p += FMT_u8Fixed(p, Ratio_Permille(channel[ch].high, channel[ch].period), 1);
+    FMT_u8String(p, "%");
+    GLCD_voidDisplayLine(line, buf);
 }
+#endif
@@ -0,0 +1,56 @@
+#ifndef KS0108_INT_H_
+#define KS0108_INT_H_
+
+#include "Service/std_types.h"
+
+/* Software model of the two KS0108 controllers behind the 128x64 GLCD,
+   wired to the ports and pins in HAL/GLCD/GLCD_cfg.h
+   - Bus cycles are decoded on the E strobe: CS/RS/RW sampled on the rising
+     edge, write data latched on the falling edge
+   - Each chip keeps its own page/column counters, display RAM, display
+     on/off and start line; the column counter auto-increments after every
+     data read or write
+   - Bus timing is checked against the datasheet minimums (E pulse widths and
+     cycle time, address and data setup). A cycle started while the chip is
+     still busy is ignored like the real controller does, and counted. Read
+     data only appears on the bus tDDR after E rises */
+
+// Bus cycles decoded by the model, summed over both chips
+typedef struct
+{
+    u32 commands;       // RS = 0, RW = 0
+    u32 data_writes;    // RS = 1, RW = 0
+    u32 data_reads;     // RS = 1, RW = 1
+    u32 status_reads;   // RS = 0, RW = 1
+
+    // Timing violations
+    u32 viol_cycle;     // E rising edges closer than tCYC
+    u32 viol_pweh;      // E high shorter than PWEH
+    u32 viol_pwel;      // E low shorter than PWEL
+    u32 viol_setup;     // RS/RW/CS changed less than tAS before E rose
+    u32 viol_data;      // Write data changed less than tDSW before E fell
+    u32 viol_busy;      // Write or data read while the chip was busy (dropped)
+    u32 viol_bus;       // Read cycle with the MCU still driving the data port
+} KS0108_Stats_t;
+
+// Hook the model into the simulator
+void KS0108_voidInit(void);
+
+// Internal operation time after each instruction (default 16 cycles = 1 us);
+// the datasheet gives no figure, modules differ
+void KS0108_voidSetBusyCycles(u32 Copy_u32Cycles);
+
+// Visible pixel (after display on/off and start line), 1 = dark
+u8 KS0108_u8GetPixel(u8 Copy_u8X, u8 Copy_u8Y);
+
+void KS0108_voidGetStats(KS0108_Stats_t *Copy_pStats);
+
+// Sum of all timing violation counters
+u32 KS0108_u32Violations(const KS0108_Stats_t *Copy_pStats);
+void KS0108_voidResetStats(void);
+
+// Dump the visible frame; return 0 on success
+u8 KS0108_u8WritePbm(const char *Copy_pcPath);
+u8 KS0108_u8WritePng(const char *Copy_pcPath);
+
+#endif /* KS0108_INT_H_ */
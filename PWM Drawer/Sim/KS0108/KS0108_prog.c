@@ -0,0 +1,347 @@
+/*
+   KS0108 controller model (two chips, CS1 = left half, CS2 = right half)
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "SIM_int.h"
+#include "KS0108_int.h"
+#include "MCAL/DIO/DIO_interface.h"
+#include "HAL/GLCD/GLCD_cfg.h"
+
+#define KS0108_PAGES     8
+#define KS0108_COLS      64
+#define KS0108_WIDTH     128
+#define KS0108_HEIGHT    64
+
+// Register addresses of the ports the GLCD is wired to
+#define KS0108_PORT_REG(port) (SIM_PORTA - 3 * (port))
+#define KS0108_DDR_REG(port)  (KS0108_PORT_REG(port) - 1)
+
+// Default internal operation time after each instruction (busy flag set)
+#define KS0108_BUSY_CYCLES  16
+
+// Datasheet bus timing minimums in cycles at 16 MHz (ns rounded up)
+#define KS0108_T_CYC    16      // 1000 ns E cycle
+#define KS0108_T_PWEH   8       // 450 ns E high
+#define KS0108_T_PWEL   8       // 450 ns E low
+#define KS0108_T_AS     3       // 140 ns address setup
+#define KS0108_T_DSW    4       // 200 ns data setup
+#define KS0108_T_DDR    6       // 320 ns read data delay
+
+typedef struct
+{
+    u8  ram[KS0108_PAGES][KS0108_COLS];
+    u8  page;           // X address (0-7)
+    u8  col;            // Y address (0-63), auto-increments
+    u8  start_line;     // Display RAM line shown on the top row
+    u8  on;
+    u8  out_latch;      // Output register (data reads return the previous fetch)
+    u64 busy_until;
+} KS0108_Chip_t;
+
+static KS0108_Chip_t chips[2];
+static KS0108_Stats_t stats;
+static u32 busy_cycles = KS0108_BUSY_CYCLES;
+
+static u8  prev_en = 0;
+static u8  cyc_rs, cyc_rw, cyc_cs;   // Sampled on the E rising edge (bit0 = CS1, bit1 = CS2)
+static u8  cyc_drop;                 // Cycle started while busy: ignored
+static u8  cyc_driving;              // Read data is on the bus
+
+// When the lines last changed, for the timing checks
+static u8  prev_addr = 0, prev_data = 0;
+static u64 addr_changed = 0, data_changed = 0;
+static u64 en_rose = 0, en_fell = 0;
+static u8  en_seen = 0;              // No E edge yet, nothing to measure against
+
+static void KS0108_voidReset(void)
+{
+    for (u8 i = 0; i < 2; i++)
+    {
+        chips[i].on = 0;
+        chips[i].start_line = 0;
+    }
+}
+
+/* Status byte: BUSY(7) ON/OFF(5, 1 = off) RESET(4) */
+static u8 KS0108_u8Status(KS0108_Chip_t *chip, u64 now)
+{
+    return ((now < chip->busy_until) ? 0x80 : 0) | (chip->on ? 0 : 0x20);
+}
+
+/* Execute a write cycle on one chip */
+static void KS0108_voidWrite(KS0108_Chip_t *chip, u8 rs, u8 data, u64 now)
+{
+    if (rs)
+    {
+        chip->ram[chip->page][chip->col] = data;
+        chip->col = (chip->col + 1) & (KS0108_COLS - 1);
+    }
+    else if ((data & 0xFE) == 0x3E)
+    {
+        chip->on = data & 1;
+    }
+    else if ((data & 0xC0) == 0x40)
+    {
+        chip->col = data & 0x3F;
+    }
+    else if ((data & 0xF8) == 0xB8)
+    {
+        chip->page = data & 0x07;
+    }
+    else if ((data & 0xC0) == 0xC0)
+    {
+        chip->start_line = data & 0x3F;
+    }
+    chip->busy_until = now + busy_cycles;
+}
+
+/* Decode the control lines on every simulator sync */
+static void KS0108_voidSync(u64 Copy_u64Now)
+{
+    u8 ctrl = SIM_au8Io[KS0108_PORT_REG(GLCD_CTRL_PORT)];
+    u8 en = (ctrl >> GLCD_EN_PIN) & 1;
+    u8 addr = ctrl & ((1 << GLCD_RS_PIN) | (1 << GLCD_RW_PIN) |
+                      (1 << GLCD_CS1_PIN) | (1 << GLCD_CS2_PIN));
+    u8 data = SIM_au8Io[KS0108_PORT_REG(GLCD_DATA_PORT)];
+
+    if (addr != prev_addr)
+    {
+        prev_addr = addr;
+        addr_changed = Copy_u64Now;
+    }
+    if (data != prev_data)
+    {
+        prev_data = data;
+        data_changed = Copy_u64Now;
+    }
+
+    if (!((ctrl >> GLCD_RST_PIN) & 1))
+    {
+        KS0108_voidReset();
+        prev_en = en;
+        return;
+    }
+
+    if (en && !prev_en)
+    {
+        // Rising edge: latch the cycle type and selected chips
+        cyc_rs = (ctrl >> GLCD_RS_PIN) & 1;
+        cyc_rw = (ctrl >> GLCD_RW_PIN) & 1;
+        cyc_cs = ((ctrl >> GLCD_CS1_PIN) & 1) | (((ctrl >> GLCD_CS2_PIN) & 1) << 1);
+        cyc_drop = 0;
+        cyc_driving = 0;
+
+        if (en_seen && Copy_u64Now - en_rose < KS0108_T_CYC) stats.viol_cycle++;
+        if (en_seen && Copy_u64Now - en_fell < KS0108_T_PWEL) stats.viol_pwel++;
+        if (cyc_cs && Copy_u64Now - addr_changed < KS0108_T_AS) stats.viol_setup++;
+        en_rose = Copy_u64Now;
+        en_seen = 1;
+
+        // Only status reads are answered while an instruction is executing
+        if (cyc_cs && !(cyc_rw && !cyc_rs))
+        {
+            for (u8 i = 0; i < 2; i++)
+            {
+                if ((cyc_cs & (1 << i)) && Copy_u64Now < chips[i].busy_until)
+                    cyc_drop = 1;
+            }
+            if (cyc_drop) stats.viol_busy++;
+        }
+    }
+    else if (!en && prev_en)
+    {
+        en_fell = Copy_u64Now;
+        if (Copy_u64Now - en_rose < KS0108_T_PWEH) stats.viol_pweh++;
+
+        if (cyc_cs && !cyc_drop && !cyc_rw)
+        {
+            if (Copy_u64Now - data_changed < KS0108_T_DSW) stats.viol_data++;
+            for (u8 i = 0; i < 2; i++)
+            {
+                if (cyc_cs & (1 << i))
+                    KS0108_voidWrite(&chips[i], cyc_rs, data, Copy_u64Now);
+            }
+            if (cyc_rs) stats.data_writes++;
+            else stats.commands++;
+        }
+        else if (cyc_cs && !cyc_drop)
+        {
+            SIM_voidReleasePins(GLCD_DATA_PORT, 0xFF);
+            if (cyc_rs)
+            {
+                // Data read: fetch the next byte into the output latch, advance the column
+                for (u8 i = 0; i < 2; i++)
+                {
+                    if (cyc_cs & (1 << i))
+                    {
+                        chips[i].out_latch = chips[i].ram[chips[i].page][chips[i].col];
+                        chips[i].col = (chips[i].col + 1) & (KS0108_COLS - 1);
+                    }
+                }
+                stats.data_reads++;
+            }
+            else
+            {
+                stats.status_reads++;
+            }
+        }
+    }
+    else if (en && cyc_rw && cyc_cs && !cyc_drop && !cyc_driving &&
+             Copy_u64Now - en_rose >= KS0108_T_DDR)
+    {
+        // Read cycle: the selected chip drives the data bus tDDR after E rose
+        KS0108_Chip_t *chip = (cyc_cs & 1) ? &chips[0] : &chips[1];
+        u8 val = cyc_rs ? chip->out_latch : KS0108_u8Status(chip, Copy_u64Now);
+
+        if (SIM_au8Io[KS0108_DDR_REG(GLCD_DATA_PORT)] != 0) stats.viol_bus++;
+        SIM_voidDrivePins(GLCD_DATA_PORT, 0xFF, val);
+        cyc_driving = 1;
+    }
+    prev_en = en;
+}
+
+void KS0108_voidInit(void)
+{
+    memset(chips, 0, sizeof(chips));
+    memset(&stats, 0, sizeof(stats));
+    SIM_voidAttach(KS0108_voidSync);
+}
+
+void KS0108_voidSetBusyCycles(u32 Copy_u32Cycles)
+{
+    busy_cycles = Copy_u32Cycles;
+}
+
+u8 KS0108_u8GetPixel(u8 Copy_u8X, u8 Copy_u8Y)
+{
+    KS0108_Chip_t *chip = &chips[Copy_u8X / KS0108_COLS];
+    u8 line = (Copy_u8Y + chip->start_line) & (KS0108_HEIGHT - 1);
+
+    if (!chip->on) return 0;
+    return (chip->ram[line / 8][Copy_u8X % KS0108_COLS] >> (line % 8)) & 1;
+}
+
+void KS0108_voidGetStats(KS0108_Stats_t *Copy_pStats)
+{
+    *Copy_pStats = stats;
+}
+
+u32 KS0108_u32Violations(const KS0108_Stats_t *Copy_pStats)
+{
+    return Copy_pStats->viol_cycle + Copy_pStats->viol_pweh + Copy_pStats->viol_pwel +
+           Copy_pStats->viol_setup + Copy_pStats->viol_data + Copy_pStats->viol_busy +
+           Copy_pStats->viol_bus;
+}
+
+void KS0108_voidResetStats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+/* Binary PBM (P4): 1 = black, rows packed MSB first */
+u8 KS0108_u8WritePbm(const char *Copy_pcPath)
+{
+    FILE *f = fopen(Copy_pcPath, "wb");
+    if (f == NULL) return 1;
+
+    fprintf(f, "P4\n%d %d\n", KS0108_WIDTH, KS0108_HEIGHT);
+    for (u8 y = 0; y < KS0108_HEIGHT; y++)
+    {
+        for (u8 xb = 0; xb < KS0108_WIDTH / 8; xb++)
+        {
+            u8 byte = 0;
+            for (u8 b = 0; b < 8; b++)
+                byte |= KS0108_u8GetPixel(xb * 8 + b, y) << (7 - b);
+            fputc(byte, f);
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+/* PNG helpers: CRC-32 for chunks, Adler-32 for the zlib stream */
+static u32 KS0108_u32Crc(u32 crc, const u8 *buf, u32 len)
+{
+    crc = ~crc;
+    for (u32 i = 0; i < len; i++)
+    {
+        crc ^= buf[i];
+        for (u8 k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+static void KS0108_voidPut32(u8 *dst, u32 val)
+{
+    dst[0] = (u8)(val >> 24);
+    dst[1] = (u8)(val >> 16);
+    dst[2] = (u8)(val >> 8);
+    dst[3] = (u8)val;
+}
+
+static void KS0108_voidChunk(FILE *f, const char *type, const u8 *data, u32 len)
+{
+    u8 hdr[8];
+    KS0108_voidPut32(hdr, len);
+    memcpy(hdr + 4, type, 4);
+    fwrite(hdr, 1, 8, f);
+    if (len != 0) fwrite(data, 1, len, f);
+
+    u32 crc = KS0108_u32Crc(0, hdr + 4, 4);
+    crc = KS0108_u32Crc(crc, data, len);
+    KS0108_voidPut32(hdr, crc);
+    fwrite(hdr, 1, 4, f);
+}
+
+/* 8-bit greyscale PNG, uncompressed (stored) deflate block: no zlib needed */
+u8 KS0108_u8WritePng(const char *Copy_pcPath)
+{
+    static const u8 sig[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    enum { ROW = KS0108_WIDTH + 1, RAW = ROW * KS0108_HEIGHT };
+    static u8 raw[RAW];
+    static u8 idat[2 + 5 + RAW + 4];
+    u8 ihdr[13];
+
+    FILE *f = fopen(Copy_pcPath, "wb");
+    if (f == NULL) return 1;
+
+    for (u8 y = 0; y < KS0108_HEIGHT; y++)
+    {
+        raw[y * ROW] = 0;   // Filter: none
+        for (u8 x = 0; x < KS0108_WIDTH; x++)
+            raw[y * ROW + 1 + x] = KS0108_u8GetPixel(x, y) ? 0x00 : 0xFF;
+    }
+
+    KS0108_voidPut32(ihdr, KS0108_WIDTH);
+    KS0108_voidPut32(ihdr + 4, KS0108_HEIGHT);
+    ihdr[8] = 8;    // Bit depth
+    ihdr[9] = 0;    // Greyscale
+    ihdr[10] = ihdr[11] = ihdr[12] = 0;
+
+    // zlib header, one final stored block, Adler-32
+    u32 a = 1, b = 0;
+    idat[0] = 0x78;
+    idat[1] = 0x01;
+    idat[2] = 0x01;
+    idat[3] = (u8)RAW;
+    idat[4] = (u8)(RAW >> 8);
+    idat[5] = (u8)~RAW;
+    idat[6] = (u8)(~RAW >> 8);
+    memcpy(idat + 7, raw, RAW);
+    for (u32 i = 0; i < RAW; i++)
+    {
+        a = (a + raw[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    KS0108_voidPut32(idat + 7 + RAW, (b << 16) | a);
+
+    fwrite(sig, 1, 8, f);
+    KS0108_voidChunk(f, "IHDR", ihdr, sizeof(ihdr));
+    KS0108_voidChunk(f, "IDAT", idat, sizeof(idat));
+    KS0108_voidChunk(f, "IEND", NULL, 0);
+    fclose(f);
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+   ADC: conversions started by ADSC, free running (ADTS = 0) or by Timer0
+   compare matches (ADTS = 3), 13 ADC clocks each (25 for the first after
+   enabling, 13.5 when auto triggered), the input sampled 1.5 ADC clocks in.
+   Results right or left adjusted per ADLAR, ADIF at the end.
+   On the chip a compare match only starts a conversion if OCF0 was cleared
+   since the last one; the register file cannot always see that clear (see
+   SIM_voidW1CUpdate), so here every match while the ADC is idle starts one.
+*/
+
+#include <math.h>
+#include "SIM_int.h"
+
+#define SIM_FP_SHIFT 16     // Waveform period in 1/65536 cycle units
+
+#define SIM_ADSC     0x40
+#define SIM_ADATE    0x20
+#define SIM_ADIF_BIT 4
+#define SIM_ADEN     0x80
+#define SIM_ADLAR    0x20
+
+// ADPS2:0 -> ADC clock divider
+static const u8 adc_div[8] = { 2, 2, 4, 8, 16, 32, 64, 128 };
+
+static u8  shape = SIM_ANALOG_DC;
+static u64 period_fp = 0;
+static u16 level_lo = 0, level_hi = 0;
+
+static u8  converting = 0;
+static u8  started = 0;             // A conversion ran since ADEN was set
+static u64 conv_end = 0;
+static u16 conv_result = 0;
+
+/* Input voltage on ADC0 in 10-bit counts */
+static u16 SIM_u16AnalogAt(u64 Copy_u64Cycle)
+{
+    double span = (double)level_hi - level_lo;
+    double x;
+
+    if (shape == SIM_ANALOG_DC || period_fp == 0)
+        return level_lo;
+    x = (double)(((Copy_u64Cycle << SIM_FP_SHIFT) % period_fp)) / (double)period_fp;
+
+    switch (shape)
+    {
+    case SIM_ANALOG_SINE:
+        return (u16)(level_lo + span * (0.5 + 0.5 * sin(2.0 * M_PI * x)) + 0.5);
+    case SIM_ANALOG_TRIANGLE:
+        return (u16)(level_lo + span * ((x < 0.5) ? 2.0 * x : 2.0 - 2.0 * x) + 0.5);
+    case SIM_ANALOG_SQUARE:
+        return (x < 0.5) ? level_hi : level_lo;
+    default:
+        return (u16)(level_lo + span * x + 0.5);
+    }
+}
+
+static void SIM_voidAdcStart(u64 Copy_u64At, u8 Copy_u8Auto)
+{
+    u32 clk = adc_div[SIM_au8Io[SIM_ADCSRA] & 0x07];
+    u8 mux = SIM_au8Io[SIM_ADMUX] & 0x1F;
+
+    conv_result = (mux == 0) ? SIM_u16AnalogAt(Copy_u64At + clk * 3 / 2) : 0;
+    if (!started)
+        conv_end = Copy_u64At + 25 * clk;
+    else
+        conv_end = Copy_u64At + 13 * clk + (Copy_u8Auto ? clk / 2 : 0);
+    started = 1;
+    converting = 1;
+    SIM_au8Io[SIM_ADCSRA] |= SIM_ADSC;
+}
+
+/* Finish the running conversion if it is done by Copy_u64Now */
+static void SIM_voidAdcComplete(u64 Copy_u64Now)
+{
+    if (!converting || Copy_u64Now < conv_end)
+        return;
+
+    converting = 0;
+    if (SIM_au8Io[SIM_ADMUX] & SIM_ADLAR)
+    {
+        SIM_au8Io[SIM_ADCH] = (u8)(conv_result >> 2);
+        SIM_au8Io[SIM_ADCL] = (u8)(conv_result << 6);
+    }
+    else
+    {
+        SIM_au8Io[SIM_ADCH] = (u8)(conv_result >> 8);
+        SIM_au8Io[SIM_ADCL] = (u8)conv_result;
+    }
+    SIM_au8Io[SIM_ADCSRA] &= ~SIM_ADSC;
+    SIM_voidSetFlag(SIM_ADCSRA, SIM_ADIF_BIT);
+
+    // Free running: the next conversion follows at once
+    if ((SIM_au8Io[SIM_ADCSRA] & SIM_ADATE) && (SIM_au8Io[SIM_SFIOR] >> 5) == 0)
+        SIM_voidAdcStart(conv_end, 1);
+}
+
+static void SIM_voidAdcSync(u64 Copy_u64Now)
+{
+    if (!(SIM_au8Io[SIM_ADCSRA] & SIM_ADEN))
+    {
+        converting = 0;
+        started = 0;
+        SIM_au8Io[SIM_ADCSRA] &= ~SIM_ADSC;
+        return;
+    }
+
+    SIM_voidAdcComplete(Copy_u64Now);
+
+    // ADSC written by the firmware
+    if (!converting && (SIM_au8Io[SIM_ADCSRA] & SIM_ADSC))
+        SIM_voidAdcStart(Copy_u64Now, 0);
+}
+
+static void SIM_voidAdcTimer0Match(u64 Copy_u64Cycle)
+{
+    u8 sra = SIM_au8Io[SIM_ADCSRA];
+
+    if (!(sra & SIM_ADEN) || !(sra & SIM_ADATE) || (SIM_au8Io[SIM_SFIOR] >> 5) != 3)
+        return;
+    SIM_voidAdcComplete(Copy_u64Cycle);
+    if (!converting)
+        SIM_voidAdcStart(Copy_u64Cycle, 1);
+}
+
+void SIM_voidAdcInit(void)
+{
+    SIM_voidAttach(SIM_voidAdcSync);
+    SIM_voidOnTimer0Match(SIM_voidAdcTimer0Match);
+}
+
+void SIM_voidSetAnalog(u8 Copy_u8Shape, u32 Copy_u32FreqMilliHz, u16 Copy_u16Low, u16 Copy_u16High)
+{
+    shape = Copy_u8Shape;
+    level_lo = (Copy_u16Low > 1023) ? 1023 : Copy_u16Low;
+    level_hi = (Copy_u16High > 1023) ? 1023 : Copy_u16High;
+    period_fp = (Copy_u32FreqMilliHz == 0) ? 0 :
+                ((u64)SIM_F_CPU * 1000ULL << SIM_FP_SHIFT) / Copy_u32FreqMilliHz;
+}
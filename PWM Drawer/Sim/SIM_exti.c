@@ -0,0 +1,121 @@
+/*
+   External interrupt inputs: a PWM source on each of INT0 (PD2), INT1 (PD3)
+   and INT2 (PB2), raising INTF0-2 per the sense control bits
+*/
+
+#include <stddef.h>
+#include "SIM_int.h"
+
+#define SIM_FP_SHIFT  16    // Edge times in 1/65536 cycle units, as in SIM_timers.c
+#define SIM_NO_EDGE   ((u64)-1)
+
+typedef struct
+{
+    u8  port, bit;          // Pin the source drives
+    u8  intf;               // Flag bit in GIFR
+    u64 period, high;       // 0 period = constant level
+    u64 next_rise, next_fall;
+    u8  level;
+} SIM_ExtiSrc_t;
+
+static SIM_ExtiSrc_t src[SIM_EXTI_CHANNELS] = {
+    { SIM_PORT_D, 2, 6, 0, 0, SIM_NO_EDGE, SIM_NO_EDGE, 0 },
+    { SIM_PORT_D, 3, 7, 0, 0, SIM_NO_EDGE, SIM_NO_EDGE, 0 },
+    { SIM_PORT_B, 2, 5, 0, 0, SIM_NO_EDGE, SIM_NO_EDGE, 0 },
+};
+
+static SIM_EdgeFn_t edge_hook = NULL;
+
+/* Sense control of a channel: 0 low level, 1 any change, 2 falling, 3 rising */
+static u8 SIM_u8ExtiSense(u8 Copy_u8Channel)
+{
+    if (Copy_u8Channel == 2)
+        return (SIM_au8Io[SIM_MCUCSR] & 0x40) ? 3 : 2;
+    return (SIM_au8Io[SIM_MCUCR] >> (2 * Copy_u8Channel)) & 0x03;
+}
+
+static void SIM_voidExtiEdge(u8 Copy_u8Channel, u8 Copy_u8Level, u64 Copy_u64Cycle)
+{
+    SIM_ExtiSrc_t *s = &src[Copy_u8Channel];
+    u8 sense = SIM_u8ExtiSense(Copy_u8Channel);
+
+    s->level = Copy_u8Level;
+    SIM_voidDrivePins(s->port, 1 << s->bit, Copy_u8Level << s->bit);
+
+    // The flag is raised whether or not the interrupt is enabled in GICR
+    // (low level sensing raises no flag and is not modelled)
+    if (sense == 1 || sense == 2 + Copy_u8Level)
+        SIM_voidSetFlag(SIM_GIFR, s->intf);
+
+    if (edge_hook != NULL)
+        edge_hook(Copy_u8Channel, Copy_u8Level, Copy_u64Cycle);
+}
+
+/* Every source edge up to now, in time order across the channels */
+static void SIM_voidExtiSync(u64 Copy_u64Now)
+{
+    u64 now_fp = Copy_u64Now << SIM_FP_SHIFT;
+
+    for (;;)
+    {
+        u8 first = SIM_EXTI_CHANNELS;
+        u64 next = SIM_NO_EDGE;
+
+        for (u8 ch = 0; ch < SIM_EXTI_CHANNELS; ch++)
+        {
+            if (src[ch].period == 0) continue;
+            u64 t = (src[ch].next_rise < src[ch].next_fall) ? src[ch].next_rise : src[ch].next_fall;
+            if (t < next)
+            {
+                next = t;
+                first = ch;
+            }
+        }
+        if (first == SIM_EXTI_CHANNELS || next > now_fp) break;
+
+        SIM_ExtiSrc_t *s = &src[first];
+        if (next == s->next_rise)
+        {
+            SIM_voidExtiEdge(first, 1, next >> SIM_FP_SHIFT);
+            s->next_fall = s->next_rise + s->high;
+            s->next_rise += s->period;
+        }
+        else
+        {
+            SIM_voidExtiEdge(first, 0, next >> SIM_FP_SHIFT);
+            s->next_fall = SIM_NO_EDGE;
+        }
+    }
+}
+
+void SIM_voidExtiInit(void)
+{
+    SIM_voidAttach(SIM_voidExtiSync);
+}
+
+/* Same conventions as SIM_voidSetPwm; the first rising edge comes one period
+   plus Copy_u32PhasePermille of a period from now */
+void SIM_voidSetExtiPwm(u8 Copy_u8Channel, u32 Copy_u32FreqMilliHz, u16 Copy_u16DutyPermille,
+                        u16 Copy_u16PhasePermille)
+{
+    SIM_ExtiSrc_t *s = &src[Copy_u8Channel];
+    u64 now_fp = SIM_u64GetCycles() << SIM_FP_SHIFT;
+
+    if (Copy_u32FreqMilliHz == 0 || Copy_u16DutyPermille == 0 || Copy_u16DutyPermille >= 1000)
+    {
+        s->period = 0;
+        SIM_voidExtiEdge(Copy_u8Channel, Copy_u16DutyPermille >= 1000 && Copy_u32FreqMilliHz != 0,
+                         SIM_u64GetCycles());
+        return;
+    }
+
+    s->period = ((u64)SIM_F_CPU * 1000ULL << SIM_FP_SHIFT) / Copy_u32FreqMilliHz;
+    s->high = s->period * Copy_u16DutyPermille / 1000;
+    s->next_rise = now_fp + s->period + s->period * Copy_u16PhasePermille / 1000;
+    s->next_fall = (s->level) ? now_fp + s->high : SIM_NO_EDGE;
+}
+
+void SIM_voidOnExtiEdge(SIM_EdgeFn_t Copy_pfHook)
+{
+    edge_hook = Copy_pfHook;
+}
@@ -0,0 +1,162 @@
+#ifndef SIM_INT_H_
+#define SIM_INT_H_
+
+#include "Service/std_types.h"
+
+/* Host simulation of the ATmega32 around the firmware
+   - I/O space 0x20-0x5F is a RAM register file; firmware reaches it through
+     SIM_pu8Access(), which also advances simulated time and lets every
+     peripheral model react to what the previous access changed
+   - Time is counted in CPU cycles (F_CPU = 16 MHz). Register accesses, delays
+     and interrupt entry/exit are charged, and each interrupt vector adds a
+     hand-counted estimate of its handler's instructions (table in
+     SIM_prog.c); other C code is free, so main-loop figures are a lower
+     bound dominated by bus and delay time */
+
+#define SIM_F_CPU          16000000UL
+
+// Size of the simulated data space holding the I/O registers
+#define SIM_IO_SIZE        0x60
+
+// Cycles charged per register access (in/out/sbi/cbi take 1-2)
+#define SIM_ACCESS_CYCLES  2
+// Granularity of delays and sleep (interrupt latency they can add)
+#define SIM_DELAY_STEP     8
+// Interrupt response + reti (4 + 4 cycles per the datasheet)
+#define SIM_IRQ_CYCLES     8
+
+// Register addresses the models use (data space)
+#define SIM_ADCL    0x24
+#define SIM_ADCH    0x25
+#define SIM_ADCSRA  0x26
+#define SIM_ADMUX   0x27
+#define SIM_UBRRL   0x29
+#define SIM_UCSRB   0x2A
+#define SIM_UCSRA   0x2B
+#define SIM_UDR     0x2C
+#define SIM_PIND    0x30
+#define SIM_DDRD    0x31
+#define SIM_PORTD   0x32
+#define SIM_PINC    0x33
+#define SIM_DDRC    0x34
+#define SIM_PORTC   0x35
+#define SIM_PINB    0x36
+#define SIM_DDRB    0x37
+#define SIM_PORTB   0x38
+#define SIM_PINA    0x39
+#define SIM_DDRA    0x3A
+#define SIM_PORTA   0x3B
+#define SIM_OCR2    0x43
+#define SIM_TCNT2   0x44
+#define SIM_TCCR2   0x45
+#define SIM_ICR1    0x46
+#define SIM_OCR1B   0x48
+#define SIM_OCR1A   0x4A
+#define SIM_TCNT1   0x4C
+#define SIM_TCCR1B  0x4E
+#define SIM_TCCR1A  0x4F
+#define SIM_SFIOR   0x50
+#define SIM_TCNT0   0x52
+#define SIM_TCCR0   0x53
+#define SIM_MCUCSR  0x54
+#define SIM_MCUCR   0x55
+#define SIM_TIFR    0x58
+#define SIM_TIMSK   0x59
+#define SIM_GIFR    0x5A
+#define SIM_GICR    0x5B
+#define SIM_OCR0    0x5C
+#define SIM_SREG    0x5F
+
+// Port indices for SIM_voidDrivePins (same order as DIO_PORTA..DIO_PORTD)
+#define SIM_PORT_A  0
+#define SIM_PORT_B  1
+#define SIM_PORT_C  2
+#define SIM_PORT_D  3
+
+// Peripheral model hook: called on every sync with the current cycle count
+typedef void (*SIM_SyncFn_t)(u64 Copy_u64Now);
+
+/* Register file */
+extern volatile u8 SIM_au8Io[SIM_IO_SIZE];
+u16  SIM_u16Read16(u8 Copy_u8Addr);
+void SIM_voidWrite16(u8 Copy_u8Addr, u16 Copy_u16Val);
+
+/* Interrupt flags living in write-one-to-clear registers (TIFR, GIFR):
+   models set them here, firmware writes of 1 clear them */
+void SIM_voidSetFlag(u8 Copy_u8Addr, u8 Copy_u8Bit);
+
+/* Pins driven from outside the MCU (input signals, GLCD data bus on reads):
+   the pins in the mask are driven / released, the rest of the port is untouched */
+void SIM_voidDrivePins(u8 Copy_u8Port, u8 Copy_u8Mask, u8 Copy_u8Val);
+void SIM_voidReleasePins(u8 Copy_u8Port, u8 Copy_u8Mask);
+
+/* Time */
+u64  SIM_u64GetCycles(void);
+void SIM_voidDelayCycles(u32 Copy_u32Cycles);
+void SIM_voidSleep(void);
+// Cycles spent asleep; the hooks see the cycle each sleep starts and ends on
+u64  SIM_u64SleepCycles(void);
+void SIM_voidOnSleep(SIM_SyncFn_t Copy_pfSleep, SIM_SyncFn_t Copy_pfWake);
+
+/* Interrupt load: per vector, handler runs and the cycles from entry to the
+   end of reti, less those of handlers nested in it */
+typedef struct
+{
+    u32 count;
+    u64 cycles;
+    u32 max;
+} SIM_IrqStats_t;
+// Every cycle spent in a handler so far (each counted once when nested)
+u64  SIM_u64IrqCycles(void);
+const char *SIM_pcIrqStats(u8 Copy_u8Index, SIM_IrqStats_t *Copy_pStats);
+void SIM_voidResetIrqStats(void);
+
+/* Peripheral models and periodic hooks */
+void SIM_voidAttach(SIM_SyncFn_t Copy_pfSync);
+
+/* Write-triggered register (a data register the firmware only stores to):
+   every access to Copy_u8Addr is taken as a write, and the stored value is
+   handed to the model at the next sync. One such register */
+typedef void (*SIM_WriteFn_t)(u8 Copy_u8Value);
+void SIM_voidWatchWrites(u8 Copy_u8Addr, SIM_WriteFn_t Copy_pfWrite);
+void SIM_voidEvery(u64 Copy_u64Period, SIM_SyncFn_t Copy_pfHook);
+
+/* Run the firmware entry point until the cycle budget is used up
+   (main() never returns, so the simulator unwinds out of it) */
+u64  SIM_u64Run(int (*Copy_pfEntry)(void), u64 Copy_u64Cycles);
+
+/* Timer0, Timer1, Timer2 and the PWM source on ICP1 (PD6), also wired to T1 (PB1) */
+void SIM_voidTimersInit(void);
+void SIM_voidSetPwm(u32 Copy_u32FreqMilliHz, u16 Copy_u16DutyPermille);
+// Every Nth period of that PWM has a high time of Copy_u32HighCycles (runt or
+// stretched pulse), 0 = none
+void SIM_voidSetGlitch(u32 Copy_u32EveryPeriods, u32 Copy_u32HighCycles);
+// Called with the cycle of each Timer0 compare match
+void SIM_voidOnTimer0Match(SIM_SyncFn_t Copy_pfHook);
+
+/* PWM sources on INT0 (PD2), INT1 (PD3) and INT2 (PB2), channels 0-2; the
+   hook sees every source edge (channel, new level, cycle it happened on) */
+#define SIM_EXTI_CHANNELS 3
+typedef void (*SIM_EdgeFn_t)(u8 Copy_u8Channel, u8 Copy_u8Level, u64 Copy_u64Cycle);
+void SIM_voidExtiInit(void);
+void SIM_voidSetExtiPwm(u8 Copy_u8Channel, u32 Copy_u32FreqMilliHz, u16 Copy_u16DutyPermille,
+                        u16 Copy_u16PhasePermille);
+void SIM_voidOnExtiEdge(SIM_EdgeFn_t Copy_pfHook);
+
+/* USART transmitter on TXD: bytes leave at the programmed baud rate and are
+   written to a file descriptor (a pty master or a capture file), -1 = dropped */
+void SIM_voidUartInit(int Copy_iFd);
+u32  SIM_u32UartBytes(void);
+
+/* ADC with one analog source on ADC0 (PA0): a periodic waveform between two
+   levels given in 10-bit counts (0-1023); other channels read 0. Needs
+   SIM_voidTimersInit() first for the Timer0 auto trigger */
+#define SIM_ANALOG_DC        0     // Constant at the low level
+#define SIM_ANALOG_SINE      1
+#define SIM_ANALOG_TRIANGLE  2
+#define SIM_ANALOG_SQUARE    3
+#define SIM_ANALOG_SAW       4
+void SIM_voidAdcInit(void);
+void SIM_voidSetAnalog(u8 Copy_u8Shape, u32 Copy_u32FreqMilliHz, u16 Copy_u16Low, u16 Copy_u16High);
+
+#endif /* SIM_INT_H_ */
@@ -0,0 +1,381 @@
+/*
+   ATmega32 host simulation core: register file, simulated time,
+   interrupt dispatch and run control
+*/
+
+#include <setjmp.h>
+#include <stddef.h>
+#include "SIM_int.h"
+
+/* Interrupt handlers the firmware may define (ISR() turns them into plain functions) */
+#define SIM_VECTOR(name) void name(void) __attribute__((weak));
+SIM_VECTOR(INT0_vect)
+SIM_VECTOR(INT1_vect)
+SIM_VECTOR(INT2_vect)
+SIM_VECTOR(TIMER2_COMP_vect)
+SIM_VECTOR(TIMER2_OVF_vect)
+SIM_VECTOR(TIMER1_CAPT_vect)
+SIM_VECTOR(TIMER1_COMPA_vect)
+SIM_VECTOR(TIMER1_COMPB_vect)
+SIM_VECTOR(TIMER1_OVF_vect)
+SIM_VECTOR(TIMER0_COMP_vect)
+SIM_VECTOR(TIMER0_OVF_vect)
+SIM_VECTOR(USART_RXC_vect)
+SIM_VECTOR(USART_UDRE_vect)
+SIM_VECTOR(USART_TXC_vect)
+SIM_VECTOR(ADC_vect)
+
+/* Instruction cycles of the firmware's handlers besides their register
+   accesses, which the simulator cannot see: ESTIMATES counted by hand for the
+   avr-gcc -Os code shape on the common path (edge stored, byte sent ...),
+   not taken from a listing; replace them with counts from the .lss or an
+   instruction-level simulator when the AVR toolchain is at hand. Entry is
+   the prologue (8 + 2 per register saved), charged before the handler runs;
+   body is the rest up to reti, charged after it */
+#if ICU_TRIGGER_ENABLE
+#define SIM_CAPT_ENTRY 44     // 18 registers: the inlined trigger test
+#define SIM_CAPT_BODY  180    // Edge store 113 plus the trigger test, 55 on average
+#else
+#define SIM_CAPT_ENTRY 32
+#define SIM_CAPT_BODY  113
+#endif
+
+/* ATmega32 vector table in priority order */
+static const struct
+{
+    void (*handler)(void);    // NULL when the firmware does not define it
+    u8 flag_reg, flag_bit;    // Interrupt flag
+    u8 en_reg, en_bit;        // Interrupt enable
+    u8 clear_on_entry;        // Hardware clears the flag when the vector runs
+    u8 entry, body;           // Estimated handler cycles, see above
+    const char *name;
+} vectors[] = {
+    { INT0_vect,         SIM_GIFR, 6, SIM_GICR,  6, 1, 32, 162, "INT0" },
+    { INT1_vect,         SIM_GIFR, 7, SIM_GICR,  7, 1, 32, 162, "INT1" },
+    { INT2_vect,         SIM_GIFR, 5, SIM_GICR,  5, 1, 36, 170, "INT2" },
+    { TIMER2_COMP_vect,  SIM_TIFR, 7, SIM_TIMSK, 7, 1, 32,  66, "TIMER2_COMP" },
+    { TIMER2_OVF_vect,   SIM_TIFR, 6, SIM_TIMSK, 6, 1,  0,   0, "TIMER2_OVF" },
+    { TIMER1_CAPT_vect,  SIM_TIFR, 5, SIM_TIMSK, 5, 1, SIM_CAPT_ENTRY, SIM_CAPT_BODY, "TIMER1_CAPT" },
+    { TIMER1_COMPA_vect, SIM_TIFR, 4, SIM_TIMSK, 4, 1,  0,   0, "TIMER1_COMPA" },
+    { TIMER1_COMPB_vect, SIM_TIFR, 3, SIM_TIMSK, 3, 1,  0,   0, "TIMER1_COMPB" },
+    { TIMER1_OVF_vect,   SIM_TIFR, 2, SIM_TIMSK, 2, 1, 12,  21, "TIMER1_OVF" },
+    { TIMER0_COMP_vect,  SIM_TIFR, 1, SIM_TIMSK, 1, 1, 28,  64, "TIMER0_COMP" },
+    { TIMER0_OVF_vect,   SIM_TIFR, 0, SIM_TIMSK, 0, 1,  0,   0, "TIMER0_OVF" },
+    { USART_RXC_vect,    0x2B,     7, 0x2A,      7, 0,  0,   0, "USART_RXC" },   // Cleared by reading UDR
+    { USART_UDRE_vect,   0x2B,     5, 0x2A,      5, 0, 24,  57, "USART_UDRE" },  // Cleared by writing UDR
+    { USART_TXC_vect,    0x2B,     6, 0x2A,      6, 1,  0,   0, "USART_TXC" },
+    { ADC_vect,          0x26,     4, 0x26,      3, 1, 32,  71, "ADC" },
+};
+
+/* Registers holding write-one-to-clear flags and which bits are flags */
+static const struct
+{
+    u8 addr;
+    u8 mask;
+} w1c_regs[] = {
+    { SIM_TIFR, 0xFF },
+    { SIM_GIFR, 0xE0 },
+    { 0x2B,     0x40 },   // UCSRA.TXC
+    { 0x26,     0x10 },   // ADCSRA.ADIF
+};
+#define SIM_W1C_COUNT (sizeof(w1c_regs) / sizeof(w1c_regs[0]))
+
+#define SIM_MAX_PERIPH 8
+
+volatile u8 SIM_au8Io[SIM_IO_SIZE];
+
+static u8 w1c_flags[SIM_W1C_COUNT];   // Flag values as the models last left them
+static u8 ext_mask[4], ext_val[4];    // Pins driven from outside, per port
+
+static SIM_SyncFn_t periph[SIM_MAX_PERIPH];
+static u8 periph_count = 0;
+
+static u8 watch_addr = 0;             // Register whose accesses are taken as writes (0 = none)
+static SIM_WriteFn_t watch_fn = NULL;
+static u8 watch_pending = 0;          // The last access was to it: its value is seen at the next sync
+
+static SIM_SyncFn_t hook = NULL;
+static u64 hook_period = 0, hook_next = 0;
+
+static u64 cycles = 0;
+static u64 irq_count = 0;
+static u64 irq_cycles = 0;            // In handlers, entry and exit included (outermost ones only)
+static u64 sleep_cycles = 0;
+static SIM_IrqStats_t irq_stats[sizeof(vectors) / sizeof(vectors[0])];
+static SIM_SyncFn_t sleep_hook = NULL, wake_hook = NULL;
+static u8 in_sync = 0;
+
+static jmp_buf run_env;
+static u8 running = 0;
+static u64 run_stop = 0;
+
+/* 16-bit helpers (AVR is little endian: low byte at the lower address) */
+u16 SIM_u16Read16(u8 Copy_u8Addr)
+{
+    return SIM_au8Io[Copy_u8Addr] | ((u16)SIM_au8Io[Copy_u8Addr + 1] << 8);
+}
+
+void SIM_voidWrite16(u8 Copy_u8Addr, u16 Copy_u16Val)
+{
+    SIM_au8Io[Copy_u8Addr] = (u8)Copy_u16Val;
+    SIM_au8Io[Copy_u8Addr + 1] = (u8)(Copy_u16Val >> 8);
+}
+
+/* Set a write-one-to-clear interrupt flag from a model */
+void SIM_voidSetFlag(u8 Copy_u8Addr, u8 Copy_u8Bit)
+{
+    SIM_au8Io[Copy_u8Addr] |= (1 << Copy_u8Bit);
+    for (u8 i = 0; i < SIM_W1C_COUNT; i++)
+    {
+        if (w1c_regs[i].addr == Copy_u8Addr)
+            w1c_flags[i] = SIM_au8Io[Copy_u8Addr] & w1c_regs[i].mask;
+    }
+}
+
+/* Apply firmware writes to flag registers. A store that leaves the flag bits
+   unchanged looks exactly like a read, so writing 1 to a flag that is the only
+   one pending is not seen; the vectors clear their own flags on entry. */
+static void SIM_voidW1CUpdate(void)
+{
+    for (u8 i = 0; i < SIM_W1C_COUNT; i++)
+    {
+        u8 addr = w1c_regs[i].addr;
+        u8 mask = w1c_regs[i].mask;
+        u8 seen = SIM_au8Io[addr] & mask;
+
+        if (seen != w1c_flags[i])
+            w1c_flags[i] &= ~seen;
+        SIM_au8Io[addr] = (SIM_au8Io[addr] & ~mask) | w1c_flags[i];
+    }
+}
+
+static void SIM_voidClearFlag(u8 Copy_u8Addr, u8 Copy_u8Bit)
+{
+    SIM_au8Io[Copy_u8Addr] &= ~(1 << Copy_u8Bit);
+    for (u8 i = 0; i < SIM_W1C_COUNT; i++)
+    {
+        if (w1c_regs[i].addr == Copy_u8Addr)
+            w1c_flags[i] &= ~(1 << Copy_u8Bit);
+    }
+}
+
+/* Pins driven from outside the MCU; other pins of the port keep their driver */
+void SIM_voidDrivePins(u8 Copy_u8Port, u8 Copy_u8Mask, u8 Copy_u8Val)
+{
+    ext_mask[Copy_u8Port] |= Copy_u8Mask;
+    ext_val[Copy_u8Port] = (ext_val[Copy_u8Port] & ~Copy_u8Mask) | (Copy_u8Val & Copy_u8Mask);
+}
+
+void SIM_voidReleasePins(u8 Copy_u8Port, u8 Copy_u8Mask)
+{
+    ext_mask[Copy_u8Port] &= ~Copy_u8Mask;
+    ext_val[Copy_u8Port] &= ~Copy_u8Mask;
+}
+
+/* PINx = what the MCU drives on outputs, what the outside drives on inputs */
+static void SIM_voidPinsUpdate(void)
+{
+    for (u8 port = 0; port < 4; port++)
+    {
+        u8 port_addr = SIM_PORTA - 3 * port;
+        u8 ddr = SIM_au8Io[port_addr - 1];
+        u8 out = SIM_au8Io[port_addr] & ddr;
+        u8 in = ext_val[port] & ~ddr;
+        // Undriven inputs follow the pull-up setting in PORTx
+        u8 floating = ~ddr & ~ext_mask[port] & SIM_au8Io[port_addr];
+
+        SIM_au8Io[port_addr - 2] = out | in | floating;
+    }
+}
+
+/* Run the highest priority pending interrupt (one per sync, like one
+   instruction of the main program between two vectors) */
+static void SIM_voidDispatch(void)
+{
+    if (!(SIM_au8Io[SIM_SREG] & 0x80)) return;
+
+    for (u8 i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++)
+    {
+        if (vectors[i].handler == NULL) continue;
+        if (!(SIM_au8Io[vectors[i].flag_reg] & (1 << vectors[i].flag_bit))) continue;
+        if (!(SIM_au8Io[vectors[i].en_reg] & (1 << vectors[i].en_bit))) continue;
+
+        if (vectors[i].clear_on_entry)
+            SIM_voidClearFlag(vectors[i].flag_reg, vectors[i].flag_bit);
+
+        // A handler that sets I can be interrupted: the time of the ones nested
+        // in it is kept apart, so each vector is charged for its own code only
+        u64 start = cycles;
+        u64 outer = irq_cycles;
+        irq_cycles = 0;
+
+        SIM_au8Io[SIM_SREG] &= ~0x80;
+        cycles += SIM_IRQ_CYCLES / 2 + vectors[i].entry;
+        irq_count++;
+        vectors[i].handler();
+        cycles += SIM_IRQ_CYCLES / 2 + vectors[i].body;
+        SIM_au8Io[SIM_SREG] |= 0x80;
+
+        u32 own = (u32)(cycles - start - irq_cycles);
+        irq_stats[i].count++;
+        irq_stats[i].cycles += own;
+        if (own > irq_stats[i].max) irq_stats[i].max = own;
+        irq_cycles = outer + (cycles - start);
+        return;
+    }
+}
+
+/* Bring every model up to the current cycle */
+static void SIM_voidSync(void)
+{
+    if (!in_sync)
+    {
+        in_sync = 1;
+        if (watch_pending)
+        {
+            watch_pending = 0;
+            watch_fn(SIM_au8Io[watch_addr]);
+        }
+        SIM_voidW1CUpdate();
+        SIM_voidPinsUpdate();
+        for (u8 i = 0; i < periph_count; i++)
+            periph[i](cycles);
+        SIM_voidPinsUpdate();
+        if (hook != NULL && cycles >= hook_next)
+        {
+            hook_next += hook_period;
+            hook(cycles);
+        }
+        in_sync = 0;
+
+        if (running && cycles >= run_stop)
+        {
+            running = 0;
+            longjmp(run_env, 1);
+        }
+    }
+    SIM_voidDispatch();
+}
+
+/* Every firmware register access lands here */
+volatile u8 *SIM_pu8Access(u8 Copy_u8Addr)
+{
+    cycles += SIM_ACCESS_CYCLES;
+    SIM_voidSync();
+    if (Copy_u8Addr == watch_addr && watch_fn != NULL)
+        watch_pending = 1;
+    return &SIM_au8Io[Copy_u8Addr];
+}
+
+void SIM_voidSei(void)
+{
+    // Pending interrupts run at the next access, so "sei(); sleep_cpu();" still sleeps first
+    SIM_au8Io[SIM_SREG] |= 0x80;
+}
+
+void SIM_voidCli(void)
+{
+    SIM_au8Io[SIM_SREG] &= ~0x80;
+}
+
+u64 SIM_u64GetCycles(void)
+{
+    return cycles;
+}
+
+/* Busy-wait: advanced in small steps so interrupts still run on time */
+void SIM_voidDelayCycles(u32 Copy_u32Cycles)
+{
+    // The store just before the delay lands after its access synced the models;
+    // show it to them now, when it happened, rather than at the end of the wait
+    SIM_voidSync();
+    while (Copy_u32Cycles > SIM_DELAY_STEP)
+    {
+        cycles += SIM_DELAY_STEP;
+        Copy_u32Cycles -= SIM_DELAY_STEP;
+        SIM_voidSync();
+    }
+    cycles += Copy_u32Cycles;
+    SIM_voidSync();
+}
+
+/* Idle sleep: time passes until an interrupt handler has run */
+void SIM_voidSleep(void)
+{
+    u64 start = irq_count;
+
+    if (sleep_hook != NULL)
+        sleep_hook(cycles);
+    while (irq_count == start)
+    {
+        cycles += SIM_DELAY_STEP;
+        sleep_cycles += SIM_DELAY_STEP;
+        SIM_voidSync();
+    }
+    if (wake_hook != NULL)
+        wake_hook(cycles);
+}
+
+u64 SIM_u64SleepCycles(void)
+{
+    return sleep_cycles;
+}
+
+void SIM_voidOnSleep(SIM_SyncFn_t Copy_pfSleep, SIM_SyncFn_t Copy_pfWake)
+{
+    sleep_hook = Copy_pfSleep;
+    wake_hook = Copy_pfWake;
+}
+
+u64 SIM_u64IrqCycles(void)
+{
+    return irq_cycles;
+}
+
+void SIM_voidResetIrqStats(void)
+{
+    for (u8 i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++)
+        irq_stats[i].count = irq_stats[i].cycles = irq_stats[i].max = 0;
+}
+
+/* Name of vector Copy_u8Index in priority order and its figures so far,
+   NULL past the last one */
+const char *SIM_pcIrqStats(u8 Copy_u8Index, SIM_IrqStats_t *Copy_pStats)
+{
+    if (Copy_u8Index >= sizeof(vectors) / sizeof(vectors[0]))
+        return NULL;
+    *Copy_pStats = irq_stats[Copy_u8Index];
+    return vectors[Copy_u8Index].name;
+}
+
+void SIM_voidAttach(SIM_SyncFn_t Copy_pfSync)
+{
+    if (periph_count < SIM_MAX_PERIPH)
+        periph[periph_count++] = Copy_pfSync;
+}
+
+void SIM_voidWatchWrites(u8 Copy_u8Addr, SIM_WriteFn_t Copy_pfWrite)
+{
+    watch_addr = Copy_u8Addr;
+    watch_fn = Copy_pfWrite;
+}
+
+void SIM_voidEvery(u64 Copy_u64Period, SIM_SyncFn_t Copy_pfHook)
+{
+    hook = Copy_pfHook;
+    hook_period = Copy_u64Period;
+    hook_next = cycles + Copy_u64Period;
+}
+
+/* Run the firmware until the budget is spent; returns the cycle count */
+u64 SIM_u64Run(int (*Copy_pfEntry)(void), u64 Copy_u64Cycles)
+{
+    run_stop = cycles + Copy_u64Cycles;
+    running = 1;
+    if (setjmp(run_env) == 0)
+    {
+        Copy_pfEntry();
+        running = 0;
+    }
+    return cycles;
+}
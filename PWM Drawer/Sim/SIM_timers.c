@@ -0,0 +1,212 @@
+/*
+   Timer0 and Timer2 (normal / CTC mode, compare flag), Timer1 (normal mode,
+   input capture, compare flags, external clock on T1) and the PWM source
+   wired to ICP1 (PD6) and T1 (PB1). Timer0 compare matches are also handed
+   to a hook (the ADC auto trigger)
+*/
+
+#include <stddef.h>
+#include "SIM_int.h"
+
+#define SIM_ICP1_BIT  6     // PD6
+#define SIM_T1_BIT    1     // PB1
+#define SIM_FP_SHIFT  16    // Signal edge times are kept in 1/65536 cycle units
+
+// Clock select CSn2:0 -> prescaler (0 = stopped, external clock handled separately)
+static const u16 prescale[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+// Timer2 has its own prescaler (no external clock, two extra steps)
+static const u16 prescale2[8] = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+
+// 8-bit timer: registers, flag bits in TIFR and how far it has been counted
+typedef struct
+{
+    u8  tccr, tcnt, ocr;
+    u8  ocf_bit, tov_bit;
+    const u16 *prescale;
+    u64 last;               // Cycle the timer was last brought up to date
+    u32 frac;               // Cycles accumulated towards the next tick
+} SIM_Timer8_t;
+
+static SIM_Timer8_t timer0 = { SIM_TCCR0, SIM_TCNT0, SIM_OCR0, 1, 0, prescale, 0, 0 };
+static SIM_Timer8_t timer2 = { SIM_TCCR2, SIM_TCNT2, SIM_OCR2, 7, 6, prescale2, 0, 0 };
+
+static SIM_SyncFn_t t0_match_hook = NULL;
+
+static u64 t1_last = 0;
+static u32 t1_frac = 0;
+
+static u64 pwm_period = 0;  // 0 = constant level
+static u64 pwm_high = 0;
+static u64 pwm_next_rise = 0;
+static u64 pwm_next_fall = 0;
+static u8  pwm_level = 0;
+static u32 glitch_every = 0;    // Every Nth period gets glitch_high instead (0 = none)
+static u32 glitch_count = 0;
+static u64 glitch_high = 0;
+
+/* Count an 8-bit timer up to a cycle: TOP is OCRn in CTC mode (WGMn1:0 = 2), 0xFF otherwise */
+static void SIM_voidTimer8Advance(SIM_Timer8_t *Copy_pTimer, u64 Copy_u64To)
+{
+    u8 tccr = SIM_au8Io[Copy_pTimer->tccr];
+    u16 presc = Copy_pTimer->prescale[tccr & 0x07];
+    u64 from = Copy_pTimer->last;
+    u32 from_frac = Copy_pTimer->frac;
+    u64 elapsed = Copy_u64To - from + from_frac;
+
+    Copy_pTimer->last = Copy_u64To;
+    if (presc == 0)
+    {
+        Copy_pTimer->frac = 0;
+        return;
+    }
+
+    u64 ticks = elapsed / presc;
+    Copy_pTimer->frac = (u32)(elapsed % presc);
+    if (ticks == 0) return;
+
+    u8 ctc = (tccr & 0x48) == 0x08;
+    u8 ocr = SIM_au8Io[Copy_pTimer->ocr];
+    u16 modulo = ctc ? (u16)ocr + 1 : 0x100;
+    u16 tcnt = SIM_au8Io[Copy_pTimer->tcnt] % modulo;
+
+    // Compare match if OCRn lies in (tcnt, tcnt + ticks] counting modulo TOP + 1
+    u16 to_match = (u16)((ocr + modulo - tcnt - 1) % modulo);
+    if (to_match < ticks)
+    {
+        SIM_voidSetFlag(SIM_TIFR, Copy_pTimer->ocf_bit);
+        // Syncs come far more often than compare matches: at most one per call
+        if (Copy_pTimer == &timer0 && t0_match_hook != NULL)
+            t0_match_hook(from + (u64)(to_match + 1) * presc - from_frac);
+    }
+    if (!ctc && tcnt + ticks > 0xFF)
+        SIM_voidSetFlag(SIM_TIFR, Copy_pTimer->tov_bit);
+
+    SIM_au8Io[Copy_pTimer->tcnt] = (u8)((tcnt + ticks) % modulo);
+}
+
+/* Count Timer1 up to a cycle, raising overflow and compare flags on the way */
+static void SIM_voidTimer1Advance(u64 Copy_u64To)
+{
+    u16 presc = prescale[SIM_au8Io[SIM_TCCR1B] & 0x07];
+    u64 elapsed = Copy_u64To - t1_last + t1_frac;
+
+    t1_last = Copy_u64To;
+    if (presc == 0)
+    {
+        t1_frac = 0;
+        return;
+    }
+
+    u64 ticks = elapsed / presc;
+    t1_frac = (u32)(elapsed % presc);
+    if (ticks == 0) return;
+
+    u16 tcnt = SIM_u16Read16(SIM_TCNT1);
+
+    // A compare register matches if it lies in (tcnt, tcnt + ticks]
+    if (ticks >= 0x10000 || (u16)(SIM_u16Read16(SIM_OCR1A) - tcnt - 1) < ticks)
+        SIM_voidSetFlag(SIM_TIFR, 4);
+    if (ticks >= 0x10000 || (u16)(SIM_u16Read16(SIM_OCR1B) - tcnt - 1) < ticks)
+        SIM_voidSetFlag(SIM_TIFR, 3);
+    if ((u64)tcnt + ticks > 0xFFFF)
+        SIM_voidSetFlag(SIM_TIFR, 2);
+
+    SIM_voidWrite16(SIM_TCNT1, (u16)(tcnt + ticks));
+}
+
+/* Signal edge on ICP1 and T1: capture if it matches the edge select bit,
+   count it if Timer1 is clocked from T1 (CS12:0 = 6 falling, 7 rising) */
+static void SIM_voidIcpEdge(u8 Copy_u8Level)
+{
+    u8 rising_selected = (SIM_au8Io[SIM_TCCR1B] >> 6) & 1;
+    u8 clock = SIM_au8Io[SIM_TCCR1B] & 0x07;
+
+    pwm_level = Copy_u8Level;
+    SIM_voidDrivePins(SIM_PORT_D, 1 << SIM_ICP1_BIT, Copy_u8Level << SIM_ICP1_BIT);
+    SIM_voidDrivePins(SIM_PORT_B, 1 << SIM_T1_BIT, Copy_u8Level << SIM_T1_BIT);
+
+    // The counter input only sees the signal while the pin is not driven by the MCU
+    if (clock == 6 + Copy_u8Level && !(SIM_au8Io[SIM_DDRB] & (1 << SIM_T1_BIT)))
+    {
+        u16 tcnt = SIM_u16Read16(SIM_TCNT1) + 1;
+        SIM_voidWrite16(SIM_TCNT1, tcnt);
+        if (tcnt == 0)
+            SIM_voidSetFlag(SIM_TIFR, 2);
+    }
+
+    if (Copy_u8Level == rising_selected && (SIM_au8Io[SIM_TCCR1B] & 0x07) != 0)
+    {
+        SIM_voidWrite16(SIM_ICR1, SIM_u16Read16(SIM_TCNT1));
+        SIM_voidSetFlag(SIM_TIFR, 5);
+    }
+}
+
+/* Process every signal edge up to now in order, then the timers themselves */
+static void SIM_voidTimersSync(u64 Copy_u64Now)
+{
+    u64 now_fp = Copy_u64Now << SIM_FP_SHIFT;
+
+    while (pwm_period != 0)
+    {
+        u64 next = (pwm_next_rise < pwm_next_fall) ? pwm_next_rise : pwm_next_fall;
+        if (next > now_fp) break;
+
+        SIM_voidTimer1Advance(next >> SIM_FP_SHIFT);
+        if (next == pwm_next_rise)
+        {
+            SIM_voidIcpEdge(1);
+            pwm_next_fall = pwm_next_rise + pwm_high;
+            if (glitch_every != 0 && ++glitch_count >= glitch_every)
+            {
+                glitch_count = 0;
+                pwm_next_fall = pwm_next_rise + glitch_high;
+            }
+            pwm_next_rise += pwm_period;
+        }
+        else
+        {
+            SIM_voidIcpEdge(0);
+            pwm_next_fall = (u64)-1;
+        }
+    }
+
+    SIM_voidTimer1Advance(Copy_u64Now);
+    SIM_voidTimer8Advance(&timer0, Copy_u64Now);
+    SIM_voidTimer8Advance(&timer2, Copy_u64Now);
+}
+
+void SIM_voidTimersInit(void)
+{
+    SIM_voidAttach(SIM_voidTimersSync);
+}
+
+void SIM_voidOnTimer0Match(SIM_SyncFn_t Copy_pfHook)
+{
+    t0_match_hook = Copy_pfHook;
+}
+
+/* PWM on ICP1: frequency in mHz, duty in 0.1 % steps (0 / 1000 = constant level) */
+void SIM_voidSetPwm(u32 Copy_u32FreqMilliHz, u16 Copy_u16DutyPermille)
+{
+    u64 now_fp = SIM_u64GetCycles() << SIM_FP_SHIFT;
+
+    if (Copy_u32FreqMilliHz == 0 || Copy_u16DutyPermille == 0 || Copy_u16DutyPermille >= 1000)
+    {
+        pwm_period = 0;
+        SIM_voidIcpEdge(Copy_u16DutyPermille >= 1000 && Copy_u32FreqMilliHz != 0);
+        return;
+    }
+
+    pwm_period = ((u64)SIM_F_CPU * 1000ULL << SIM_FP_SHIFT) / Copy_u32FreqMilliHz;
+    pwm_high = pwm_period * Copy_u16DutyPermille / 1000;
+    pwm_next_rise = now_fp + pwm_period;
+    pwm_next_fall = (pwm_level) ? now_fp + pwm_high : (u64)-1;
+}
+
+/* Odd pulse in the PWM: every Nth high time lasts Copy_u32HighCycles instead */
+void SIM_voidSetGlitch(u32 Copy_u32EveryPeriods, u32 Copy_u32HighCycles)
+{
+    glitch_every = Copy_u32EveryPeriods;
+    glitch_count = 0;
+    glitch_high = (u64)Copy_u32HighCycles << SIM_FP_SHIFT;
+}
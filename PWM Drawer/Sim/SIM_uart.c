@@ -0,0 +1,84 @@
+/*
+   USART transmitter: UDR buffer and shift register at the baud rate set in
+   UBRRL / U2X (UBRRH is taken as 0, so rates from 3.9 kbaud up), 8N1 frames.
+   Finished bytes go to a file descriptor, e.g. a pty master.
+*/
+
+#include <unistd.h>
+#include "SIM_int.h"
+
+#define SIM_UART_FRAME_BITS 10      // Start, 8 data, stop
+
+static int out_fd = -1;
+static u8  shift_busy = 0;
+static u8  shift_val = 0;
+static u64 shift_end = 0;           // Cycle the byte in the shift register is out
+static u8  udr_full = 0;
+static u8  udr_val = 0;
+static u32 bytes_out = 0;
+
+static u32 SIM_u32CharCycles(void)
+{
+    u32 per_bit = (SIM_au8Io[SIM_UCSRA] & 0x02) ? 8 : 16;
+    return SIM_UART_FRAME_BITS * per_bit * ((u32)SIM_au8Io[SIM_UBRRL] + 1);
+}
+
+/* UDR store: straight into the shift register if it is idle, else buffered */
+static void SIM_voidUartWrite(u8 Copy_u8Value)
+{
+    if (!(SIM_au8Io[SIM_UCSRB] & 0x08))     // TXEN
+        return;
+    if (!shift_busy)
+    {
+        shift_val = Copy_u8Value;
+        shift_busy = 1;
+        shift_end = SIM_u64GetCycles() + SIM_u32CharCycles();
+    }
+    else
+    {
+        // A store with UDRE clear overwrites the buffered byte, as on the chip
+        udr_val = Copy_u8Value;
+        udr_full = 1;
+    }
+}
+
+static void SIM_voidUartSync(u64 Copy_u64Now)
+{
+    while (shift_busy && Copy_u64Now >= shift_end)
+    {
+        if (out_fd >= 0 && write(out_fd, &shift_val, 1) != 1)
+            out_fd = -1;
+        bytes_out++;
+        SIM_voidSetFlag(SIM_UCSRA, 6);      // TXC
+
+        if (udr_full)
+        {
+            shift_val = udr_val;
+            udr_full = 0;
+            shift_end += SIM_u32CharCycles();
+        }
+        else
+        {
+            shift_busy = 0;
+        }
+    }
+
+    // UDRE: the buffer can take a byte
+    if (udr_full)
+        SIM_au8Io[SIM_UCSRA] &= ~0x20;
+    else
+        SIM_au8Io[SIM_UCSRA] |= 0x20;
+}
+
+void SIM_voidUartInit(int Copy_iFd)
+{
+    out_fd = Copy_iFd;
+    SIM_au8Io[SIM_UCSRA] = 0x20;
+    SIM_voidWatchWrites(SIM_UDR, SIM_voidUartWrite);
+    SIM_voidAttach(SIM_voidUartSync);
+}
+
+u32 SIM_u32UartBytes(void)
+{
+    return bytes_out;
+}
@@ -0,0 +1,233 @@
+/*
+   FMT check and benchmark: compares the Service/FMT conversions with the
+   sprintf() formats they replace over edge cases and a pseudo-random sweep,
+   checks the engineering notation against a 64-bit reference, then counts
+   the 32-bit arithmetic each way of printing the frequency line needs.
+   Exits 1 on the first mismatch.
+
+   Host time says little about the AVR, which has no divide instruction, so
+   the cost is counted in the operations whose price differs there:
+   - sprintf: one __udivmodsi4 for v / 1000 and v % 1000 (gcc shares it),
+     then one 32-bit divide by 10 per digit the %lu / %03u conversions make
+   - FMT_u8Fixed: per power of ten, one 32-bit compare more than the digit
+     and one subtraction per unit of the digit, no division or multiply
+   The cycle figures price these with FMT_CY_* below, estimates for
+   avr-gcc -Os and avr-libc; vfprintf's format parsing and character output
+   are left out, so the sprintf figure is a lower bound.
+
+   fmt_bench [--count N]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Service/FMT/FMT_interface.h"
+
+// AVR cycles per operation (estimates)
+#define FMT_CY_UDIVMOD32 650    // libgcc __udivmodsi4: 32 shift-subtract steps
+#define FMT_CY_DIV10     50     // avr-libc __ultoa_invert, one digit
+#define FMT_CY_CMP32     14     // pow10[] load, 4 x cp/cpc, branch
+#define FMT_CY_SUB32     7      // 4 x sub/sbc, digit++, loop
+
+static u32 failures = 0;
+
+static void FMT_voidExpect(const char *what, u32 val, const char *got, const char *want)
+{
+    if (strcmp(got, want) != 0 && failures++ < 10)
+        printf("MISMATCH %s(%lu): got \"%s\" want \"%s\"\n", what, (unsigned long)val, got, want);
+}
+
+/* The three status lines exactly as main() used to print them */
+static void FMT_voidCheckLines(u32 val)
+{
+    char got[40], want[40], *p;
+
+    snprintf(want, sizeof(want), "FREQ=%lu.%03ukHz", (unsigned long)(val / 1000), (unsigned)(val % 1000));
+    p = got + FMT_u8String(got, "FREQ=");
+    p += FMT_u8Fixed(p, val, 3);
+    FMT_u8String(p, "kHz");
+    FMT_voidExpect("freq line", val, got, want);
+
+    snprintf(want, sizeof(want), "DUTY=%u%%", (unsigned)(u8)val);
+    p = got + FMT_u8String(got, "DUTY=");
+    p += FMT_u8Unsigned(p, (u8)val);
+    FMT_u8String(p, "%");
+    FMT_voidExpect("duty line", val, got, want);
+
+    snprintf(want, sizeof(want), "%lu", (unsigned long)val);
+    u8 len = FMT_u8Unsigned(got, val);
+    FMT_voidExpect("unsigned", val, got, want);
+    if (len != strlen(want))
+        FMT_voidExpect("unsigned length", val, "", "?");
+
+    for (u8 dec = 1; dec <= 9; dec++)
+    {
+        unsigned long long div = 1;
+        for (u8 i = 0; i < dec; i++) div *= 10;
+        snprintf(want, sizeof(want), "%lu.%0*llu", (unsigned long)(val / div), dec, val % div);
+        FMT_u8Fixed(got, val, dec);
+        FMT_voidExpect("fixed", val, got, want);
+    }
+}
+
+/* Engineering notation reference: thousandths of the chosen prefix in 64 bits */
+static void FMT_voidCheckEngineering(u32 val, u8 frac)
+{
+    static const char *const f_units[3] = { "Hz", "kHz", "MHz" };
+    static const char *const t_units[3] = { "us", "ms", "s" };
+    unsigned long long base = 1, whole, milli;
+    char got[FMT_ENG_MAX], want[40];
+    u8 prefix = 0;
+
+    for (u8 i = 0; i < frac; i++) base *= 10;
+    whole = val / base;
+    if (whole >= 1000000ULL) prefix = 2;
+    else if (whole >= 1000ULL) prefix = 1;
+
+    milli = (unsigned long long)val * 1000ULL / base;
+    for (u8 i = 0; i < prefix; i++) milli /= 1000;
+
+    snprintf(want, sizeof(want), "%llu.%03llu%s", milli / 1000, milli % 1000, f_units[prefix]);
+    FMT_u8Frequency(got, val, frac);
+    FMT_voidExpect("frequency", val, got, want);
+
+    snprintf(want, sizeof(want), "%llu.%03llu%s", milli / 1000, milli % 1000, t_units[prefix]);
+    FMT_u8Time(got, val, frac);
+    FMT_voidExpect("time", val, got, want);
+}
+
+static u32 lcg_state = 12345;
+static u32 FMT_u32Random(void)
+{
+    lcg_state = lcg_state * 1664525UL + 1013904223UL;
+    // Spread the magnitudes: random value shifted down by a random amount
+    return lcg_state >> ((lcg_state >> 7) % 32);
+}
+
+/* Operations one line takes each way */
+typedef struct
+{
+    u32 udivmod32;
+    u32 div10;
+    u32 cmp32;
+    u32 sub32;
+} FMT_Ops_t;
+
+static u8 FMT_u8Digits(u32 Copy_u32Val)
+{
+    u8 n = 1;
+    while (Copy_u32Val >= 10)
+    {
+        Copy_u32Val /= 10;
+        n++;
+    }
+    return n;
+}
+
+/* "FREQ=%lu.%03ukHz" with v / 1000 and v % 1000 */
+static void FMT_voidCountSprintf(u32 Copy_u32Val, FMT_Ops_t *Copy_pOps)
+{
+    Copy_pOps->udivmod32 += 1;
+    Copy_pOps->div10 += FMT_u8Digits(Copy_u32Val / 1000) + FMT_u8Digits(Copy_u32Val % 1000);
+}
+
+/* FMT_u8Fixed(v, 3), from the digits it printed: the leading zeros it drops
+   still cost their one compare */
+static void FMT_voidCountFixed(const char *Copy_pcText, FMT_Ops_t *Copy_pOps)
+{
+    Copy_pOps->cmp32 += 10;
+    for (const char *c = Copy_pcText; *c != '\0'; c++)
+    {
+        if (*c >= '0' && *c <= '9')
+        {
+            Copy_pOps->cmp32 += (u32)(*c - '0');
+            Copy_pOps->sub32 += (u32)(*c - '0');
+        }
+    }
+}
+
+static u32 FMT_u32Cycles(const FMT_Ops_t *Copy_pOps)
+{
+    return Copy_pOps->udivmod32 * FMT_CY_UDIVMOD32 + Copy_pOps->div10 * FMT_CY_DIV10 +
+           Copy_pOps->cmp32 * FMT_CY_CMP32 + Copy_pOps->sub32 * FMT_CY_SUB32;
+}
+
+static void FMT_voidReport(const char *Copy_pcName, const FMT_Ops_t *Copy_pOps, u32 Copy_u32Lines)
+{
+    printf("%s_per_line udivmod32=%.2f div10=%.2f cmp32=%.2f sub32=%.2f avr_cycles=%.0f\n", Copy_pcName,
+           (double)Copy_pOps->udivmod32 / Copy_u32Lines, (double)Copy_pOps->div10 / Copy_u32Lines,
+           (double)Copy_pOps->cmp32 / Copy_u32Lines, (double)Copy_pOps->sub32 / Copy_u32Lines,
+           (double)FMT_u32Cycles(Copy_pOps) / Copy_u32Lines);
+}
+
+int main(int argc, char **argv)
+{
+    u32 count = 1000000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--count") == 0 && i + 1 < argc)
+            count = strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--count N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Edge cases: around every power of ten and the ends of the range
+    u32 checked = 0;
+    for (u32 p = 1; ; p *= 10)
+    {
+        for (s32 d = -2; d <= 2; d++)
+        {
+            u32 v = p + (u32)d;
+            FMT_voidCheckLines(v);
+            for (u8 frac = 0; frac <= 9; frac++)
+                FMT_voidCheckEngineering(v, frac);
+            checked++;
+        }
+        if (p == 1000000000UL) break;
+    }
+    FMT_voidCheckLines(0xFFFFFFFFUL);
+    FMT_voidCheckLines(0);
+    for (u8 frac = 0; frac <= 9; frac++)
+    {
+        FMT_voidCheckEngineering(0xFFFFFFFFUL, frac);
+        FMT_voidCheckEngineering(0, frac);
+    }
+
+    for (u32 i = 0; i < count / 16; i++)
+    {
+        u32 v = FMT_u32Random();
+        FMT_voidCheckLines(v);
+        FMT_voidCheckEngineering(v, (u8)(i % 10));
+        checked++;
+    }
+
+    printf("values_checked=%u\n", (unsigned)(checked + 2));
+    printf("mismatches=%u\n", (unsigned)failures);
+    if (failures != 0)
+        return 1;
+
+    // Count the frequency line both ways, over random values and at 1 kHz
+    char buf[16];
+    FMT_Ops_t by_sprintf = { 0 }, by_fmt = { 0 }, one_sprintf = { 0 }, one_fmt = { 0 };
+    lcg_state = 1;
+    for (u32 i = 0; i < count; i++)
+    {
+        u32 v = FMT_u32Random();
+        FMT_voidCountSprintf(v, &by_sprintf);
+        FMT_u8Fixed(buf, v, 3);
+        FMT_voidCountFixed(buf, &by_fmt);
+    }
+    FMT_voidCountSprintf(1000, &one_sprintf);
+    FMT_u8Fixed(buf, 1000, 3);
+    FMT_voidCountFixed(buf, &one_fmt);
+
+    FMT_voidReport("sprintf", &by_sprintf, count);
+    FMT_voidReport("fmt", &by_fmt, count);
+    printf("speedup=%.2f\n", (double)FMT_u32Cycles(&by_sprintf) / FMT_u32Cycles(&by_fmt));
+    printf("speedup_1khz=%.2f\n", (double)FMT_u32Cycles(&one_sprintf) / FMT_u32Cycles(&one_fmt));
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+   Font harness: draws every printable character in FONT_5x7 and checks the
+   display RAM against the glyph tables, then prints the bus writes of the
+   large FONT_10x16 readout against the 5x7 status line for a first draw and
+   a one-digit change, and the glyph table sizes. The host build has no AVR
+   map, so the SRAM figures are printed as constants (keys ending in _const),
+   not measured.
+
+   font_bench [--out PREFIX]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SIM_int.h"
+#include "KS0108/KS0108_int.h"
+#include "HAL/GLCD/GLCD_int.h"
+#include "HAL/FONT/FONT_int.h"
+
+// Before flash storage the 5x7 table was initialized data: the baseline AVR
+// map (Debug/PWM_Drawer.map) has .rodata.font5x7 at 0x127 bytes in .data
+#define FONT_BASELINE_SRAM_BYTES 0x127
+
+static const char *prefix = NULL;
+static u32 violations = 0;
+
+static u32 FONT_u32BusWrites(void)
+{
+    KS0108_Stats_t st;
+    KS0108_voidGetStats(&st);
+    KS0108_voidResetStats();
+    violations += KS0108_u32Violations(&st);
+    return st.commands + st.data_writes;
+}
+
+static void FONT_voidDump(const char *name)
+{
+    char path[256];
+    if (prefix == NULL) return;
+    snprintf(path, sizeof(path), "%s_%s.pbm", prefix, name);
+    KS0108_u8WritePbm(path);
+}
+
+static u32 FONT_u32GlyphBytes(const FONT_t *Copy_pFont)
+{
+    FONT_t desc;
+    FONT_voidLoad(Copy_pFont, &desc);
+    return (u32)(desc.last - desc.first + 1) * desc.width * desc.pages;
+}
+
+/* Glyph page at screen page / column as drawn on the display */
+static u8 FONT_u8Matches(const FONT_t *Copy_pDesc, char Copy_cChar, u8 Copy_u8Page, u8 Copy_u8Col)
+{
+    u8 cols[FONT_MAX_ADVANCE];
+    u8 n = FONT_u8Columns(Copy_pDesc, Copy_cChar, 0, cols);
+
+    for (u8 i = 0; i < n; i++)
+        for (u8 bit = 0; bit < 8; bit++)
+            if (KS0108_u8GetPixel(Copy_u8Col + i, Copy_u8Page * 8 + bit) != ((cols[i] >> bit) & 1))
+                return 0;
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            prefix = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--out PREFIX]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    KS0108_voidInit();
+    GLCD_voidInit();
+    GLCD_voidClear();
+    FONT_u32BusWrites();
+
+    // Printable ASCII, 21 characters per line
+    FONT_t small;
+    char line[22];
+    u32 ok = 0;
+
+    FONT_voidLoad(&FONT_5x7, &small);
+    for (u8 page = 0; page * 21 < 95; page++)
+    {
+        u8 n = 0;
+        for (u8 c = 32 + page * 21; c <= 126 && n < 21; c++)
+            line[n++] = (char)c;
+        line[n] = '\0';
+        GLCD_voidDisplayLine(page, line);
+        for (u8 i = 0; i < n; i++)
+            ok += FONT_u8Matches(&small, line[i], page, i * 6);
+    }
+    printf("font5x7_chars_ok=%u/95\n", (unsigned)ok);
+    printf("charset_bus_writes=%u\n", (unsigned)FONT_u32BusWrites());
+    FONT_voidDump("charset");
+
+    // Frequency readout: 5x7 status line against the large digits
+    GLCD_voidClear();
+    FONT_u32BusWrites();
+    GLCD_voidDisplayLine(0, "FREQ=123.456kHz");
+    printf("small_first_bus_writes=%u\n", (unsigned)FONT_u32BusWrites());
+    GLCD_voidDisplayLine(0, "FREQ=123.457kHz");
+    printf("small_digit_bus_writes=%u\n", (unsigned)FONT_u32BusWrites());
+
+    GLCD_voidClear();
+    FONT_u32BusWrites();
+    GLCD_voidDisplayLineFont(&FONT_10x16, 0, "123.456");
+    printf("large_first_bus_writes=%u\n", (unsigned)FONT_u32BusWrites());
+    GLCD_voidDisplayLineFont(&FONT_10x16, 0, "123.457");
+    printf("large_digit_bus_writes=%u\n", (unsigned)FONT_u32BusWrites());
+    FONT_voidDump("large");
+
+    // Glyph tables and descriptors are all in flash
+    printf("font5x7_glyph_bytes=%u\n", (unsigned)FONT_u32GlyphBytes(&FONT_5x7));
+    printf("font10x16_glyph_bytes=%u\n", (unsigned)FONT_u32GlyphBytes(&FONT_10x16));
+    // Constants: glyphs and descriptors are PROGMEM, and the old table's size
+    // comes from the baseline map
+    printf("font_sram_bytes_const=0\n");
+    printf("font_sram_baseline_bytes_const=%u\n", (unsigned)FONT_BASELINE_SRAM_BYTES);
+    printf("glcd_timing_violations=%u\n", (unsigned)violations);
+    return 0;
+}
@@ -0,0 +1,186 @@
+/*
+   Graphics primitive harness: draws lines in every octant, spans,
+   rectangles and fills with HAL/GFX and with a pixel-at-a-time reference
+   (textbook Bresenham through GLCD_voidFbSetPixel), checks that both give
+   the same framebuffer, and prints the pixels a per-pixel read-modify-write
+   would cost against the page bytes GFX writes.
+
+   gfx_bench [--out PREFIX]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SIM_int.h"
+#include "KS0108/KS0108_int.h"
+#include "HAL/GLCD/GLCD_int.h"
+#include "HAL/GFX/GFX_int.h"
+
+typedef enum { SHAPE_HLINE, SHAPE_VLINE, SHAPE_LINE, SHAPE_RECT, SHAPE_FILL } Shape_t;
+
+typedef struct
+{
+    const char *name;
+    Shape_t shape;
+    u8 x0, y0, x1, y1;
+} Case_t;
+
+static const Case_t cases[] = {
+    { "vedge_24px",   SHAPE_VLINE,  10, 40, 10, 63 },   // A WAVE edge column
+    { "vedge_odd",    SHAPE_VLINE,  20,  3, 20, 50 },
+    { "hspan",        SHAPE_HLINE,   5, 17, 120, 17 },
+    { "line_shallow", SHAPE_LINE,    0,  0, 127, 20 },
+    { "line_steep",   SHAPE_LINE,   30,  0,  45, 63 },
+    { "line_up",      SHAPE_LINE,    0, 63, 100,  5 },
+    { "line_back",    SHAPE_LINE,  127, 10,  60, 60 },
+    { "line_diag",    SHAPE_LINE,    0,  0,  63, 63 },
+    { "line_point",   SHAPE_LINE,   70, 30,  70, 30 },
+    { "rect",         SHAPE_RECT,    8,  6, 119, 57 },
+    { "fill",         SHAPE_FILL,   33, 13,  90, 50 },
+};
+
+static u8 ref[GLCD_PAGES][GLCD_WIDTH];
+
+static void GFX_voidSnapshot(u8 Copy_pu8Dst[GLCD_PAGES][GLCD_WIDTH])
+{
+    for (u8 p = 0; p < GLCD_PAGES; p++)
+        for (u8 x = 0; x < GLCD_WIDTH; x++)
+            Copy_pu8Dst[p][x] = GLCD_u8FbReadByte(p, x);
+}
+
+/* Reference: one pixel at a time, returns the pixels drawn */
+static u32 GFX_u32RefLine(int x0, int y0, int x1, int y1)
+{
+    if (x0 > x1)
+    {
+        int t = x0; x0 = x1; x1 = t;
+        t = y0; y0 = y1; y1 = t;
+    }
+    int dx = x1 - x0, dy = abs(y1 - y0), sy = (y1 > y0) ? 1 : -1;
+    int err = dx - dy;
+    u32 n = 0;
+
+    for (;;)
+    {
+        GLCD_voidFbSetPixel((u8)x0, (u8)y0);
+        n++;
+        if (x0 == x1 && y0 == y1) break;
+        int e2 = 2 * err;
+        if (e2 > -dy) { err -= dy; x0++; }
+        if (e2 < dx)  { err += dx; y0 += sy; }
+    }
+    return n;
+}
+
+static u32 GFX_u32Reference(const Case_t *c)
+{
+    u32 n = 0;
+    switch (c->shape)
+    {
+    case SHAPE_HLINE:
+    case SHAPE_VLINE:
+    case SHAPE_LINE:
+        return GFX_u32RefLine(c->x0, c->y0, c->x1, c->y1);
+    case SHAPE_RECT:
+        n += GFX_u32RefLine(c->x0, c->y0, c->x1, c->y0);
+        n += GFX_u32RefLine(c->x0, c->y1, c->x1, c->y1);
+        n += GFX_u32RefLine(c->x0, c->y0 + 1, c->x0, c->y1 - 1);
+        n += GFX_u32RefLine(c->x1, c->y0 + 1, c->x1, c->y1 - 1);
+        return n;
+    case SHAPE_FILL:
+        for (int x = c->x0; x <= c->x1; x++)
+            n += GFX_u32RefLine(x, c->y0, x, c->y1);
+        return n;
+    }
+    return 0;
+}
+
+static void GFX_voidDraw(const Case_t *c, u8 Copy_u8Op)
+{
+    switch (c->shape)
+    {
+    case SHAPE_HLINE: GFX_voidHLine(c->x0, c->x1, c->y0, Copy_u8Op); break;
+    case SHAPE_VLINE: GFX_voidVLine(c->x0, c->y0, c->y1, Copy_u8Op); break;
+    case SHAPE_LINE:  GFX_voidLine(c->x0, c->y0, c->x1, c->y1, Copy_u8Op); break;
+    case SHAPE_RECT:  GFX_voidRect(c->x0, c->y0, c->x1, c->y1, Copy_u8Op); break;
+    case SHAPE_FILL:  GFX_voidFillRect(c->x0, c->y0, c->x1, c->y1, Copy_u8Op); break;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *prefix = NULL;
+    u32 mismatches = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            prefix = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--out PREFIX]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    KS0108_voidInit();
+    GLCD_voidInit();
+
+    printf("%-13s %8s %11s\n", "case", "pixels", "page_bytes");
+    for (u8 i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        const Case_t *c = &cases[i];
+        u8 fb[GLCD_PAGES][GLCD_WIDTH];
+        u32 bytes = 0;
+
+        GLCD_voidFbClear();
+        u32 pixels = GFX_u32Reference(c);
+        GFX_voidSnapshot(ref);
+
+        // On a blank screen GFX writes every byte it touches exactly once
+        GLCD_voidFbClear();
+        GFX_voidDraw(c, GFX_SET);
+        GFX_voidSnapshot(fb);
+        for (u8 p = 0; p < GLCD_PAGES; p++)
+            for (u8 x = 0; x < GLCD_WIDTH; x++)
+                bytes += fb[p][x] != 0;
+        if (memcmp(fb, ref, sizeof(fb)) != 0)
+        {
+            printf("MISMATCH %s\n", c->name);
+            mismatches++;
+        }
+
+        // Invert twice and clear must leave nothing behind
+        GFX_voidDraw(c, GFX_INVERT);
+        GFX_voidDraw(c, GFX_INVERT);
+        GFX_voidDraw(c, GFX_CLEAR);
+        GFX_voidSnapshot(fb);
+        for (u8 p = 0; p < GLCD_PAGES; p++)
+            for (u8 x = 0; x < GLCD_WIDTH; x++)
+                if (fb[p][x])
+                {
+                    printf("LEFTOVER %s page %u col %u\n", c->name, (unsigned)p, (unsigned)x);
+                    mismatches++;
+                    p = GLCD_PAGES - 1;
+                    break;
+                }
+
+        printf("%-13s %8u %11u\n", c->name, (unsigned)pixels, (unsigned)bytes);
+    }
+
+    if (prefix)
+    {
+        char path[256];
+        GLCD_voidFbClear();
+        for (u8 i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+            if (cases[i].shape != SHAPE_FILL)
+                GFX_voidDraw(&cases[i], GFX_SET);
+        GFX_voidFillRect(33, 13, 90, 50, GFX_INVERT);
+        GLCD_voidFlush();
+        snprintf(path, sizeof(path), "%s_all.pbm", prefix);
+        KS0108_u8WritePbm(path);
+    }
+
+    printf("mismatches=%u\n", (unsigned)mismatches);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,311 @@
+/*
+   Multi-channel capture harness: PWM sources on INT0-INT2 and ICP1 at the
+   same time, timestamped by MCAL/EXTI against Timer1 (clock / 1) and
+   measured by APP/MCH.
+   - accuracy: frequency and duty per channel against the source settings
+   - latency:  cycles from each source edge to its software timestamp
+   - sweep:    every channel at the same frequency with coincident edges (the
+               worst case for latency), until edges are missed
+   The handlers are charged the simulator's hand-counted per-vector estimates
+   (SIM_prog.c) but main loop code is free, so sim_ceiling_hz_all_channels is what the
+   simulator sustains, an upper bound for the chip. Every sweep row up to
+   MCH_CEILING_HZ, the figure the documentation quotes, must be clean:
+   no missed, overrun or backward edge and at most 100 ppm of error.
+
+   mch_bench [--ms N]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "SIM_int.h"
+#include "MCAL/ICU/ICU_interface.h"
+#include "MCAL/EXTI/EXTI_interface.h"
+#include "APP/MCH/MCH_int.h"
+
+#define BENCH_LOG_SIZE 64     // Source edges not yet matched to a timestamp, per channel
+#define MCH_CEILING_HZ 10000  // All four inputs at once, coincident edges
+
+typedef struct
+{
+    u32 freq_mhz;
+    u16 duty;                 // Permille
+} Signal_t;
+
+/* Source edges as the simulator produced them, to match against the stamps */
+static struct
+{
+    u64 cycle[BENCH_LOG_SIZE];
+    u8  level[BENCH_LOG_SIZE];
+    u8  head, tail;
+} edge_log[EXTI_CHANNELS];
+
+static u8  raw_mode = 0;      // 1: the loop drains the rings itself and measures latency
+static u64 tick_offset = 0;   // Simulated cycle = Timer1 ticks + tick_offset (clock / 1)
+
+static u64 lat_sum[EXTI_CHANNELS];
+static u32 lat_count[EXTI_CHANNELS];
+static u32 lat_min[EXTI_CHANNELS];
+static u32 lat_max[EXTI_CHANNELS];
+
+static void MCH_voidLogEdge(u8 Copy_u8Channel, u8 Copy_u8Level, u64 Copy_u64Cycle)
+{
+    u8 head = edge_log[Copy_u8Channel].head;
+    edge_log[Copy_u8Channel].cycle[head % BENCH_LOG_SIZE] = Copy_u64Cycle;
+    edge_log[Copy_u8Channel].level[head % BENCH_LOG_SIZE] = Copy_u8Level;
+    edge_log[Copy_u8Channel].head = head + 1;
+}
+
+/* Latest source edge of the stamped level at or before the stamp */
+static void MCH_voidMatch(u8 Copy_u8Channel, const ICU_Edge_t *Copy_pEdge)
+{
+    u64 stamp = (u64)Copy_pEdge->timestamp + tick_offset;
+    u8 level = (Copy_pEdge->flags & ICU_FLAG_RISING) ? 1 : 0;
+    u64 found = (u64)-1;
+
+    while (edge_log[Copy_u8Channel].tail != edge_log[Copy_u8Channel].head)
+    {
+        u8 t = edge_log[Copy_u8Channel].tail % BENCH_LOG_SIZE;
+        if (edge_log[Copy_u8Channel].cycle[t] > stamp) break;
+        if (edge_log[Copy_u8Channel].level[t] == level)
+            found = edge_log[Copy_u8Channel].cycle[t];
+        edge_log[Copy_u8Channel].tail++;
+    }
+    if (found == (u64)-1) return;
+
+    u32 lat = (u32)(stamp - found);
+    lat_sum[Copy_u8Channel] += lat;
+    lat_count[Copy_u8Channel]++;
+    if (lat < lat_min[Copy_u8Channel]) lat_min[Copy_u8Channel] = lat;
+    if (lat > lat_max[Copy_u8Channel]) lat_max[Copy_u8Channel] = lat;
+}
+
+/* Firmware side: the main loop of a capture-only application, run until a
+   cycle. Timer1 is not stopped in between, so timestamps stay comparable */
+static void MCH_voidLoopUntil(u64 Copy_u64End)
+{
+    ICU_Edge_t batch[16];
+
+    while (SIM_u64GetCycles() < Copy_u64End)
+    {
+        cli();
+        if (ICU_u8Available() == 0 && EXTI_u8Pending() == 0)
+        {
+            sei();
+            sleep_cpu();
+        }
+        sei();
+
+        // ICP1 only loads the CPU here
+        while (ICU_u8ReadEdges(batch, 16) > 0)
+            ;
+
+        if (raw_mode)
+        {
+            for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+            {
+                u8 n;
+                while ((n = EXTI_u8ReadEdges(ch, batch, 16)) > 0)
+                    for (u8 i = 0; i < n; i++)
+                        MCH_voidMatch(ch, &batch[i]);
+            }
+        }
+        else
+        {
+            MCH_voidProcess();
+        }
+    }
+}
+
+static void MCH_voidSignals(u32 Copy_u32IcpMilliHz, const Signal_t *Copy_pSig, u16 Copy_u16PhaseStep)
+{
+    SIM_voidSetPwm(Copy_u32IcpMilliHz, 300);
+    for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+        SIM_voidSetExtiPwm(ch, Copy_pSig[ch].freq_mhz, Copy_pSig[ch].duty, (u16)(ch * Copy_u16PhaseStep));
+}
+
+static void MCH_voidMissed(u32 *Copy_pu32Missed, u32 *Copy_pu32Overruns, u32 *Copy_pu32Backward)
+{
+    *Copy_pu32Missed = *Copy_pu32Overruns = *Copy_pu32Backward = 0;
+    for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+    {
+        EXTI_Stats_t st;
+        EXTI_voidGetStats(ch, &st);
+        *Copy_pu32Missed += st.missed;
+        *Copy_pu32Overruns += st.overruns;
+        *Copy_pu32Backward += st.backward;
+    }
+}
+
+/* Settle, drop the partial sums, then measure for Copy_u64Cycles */
+static void MCH_voidMeasure(u64 Copy_u64Cycles, MCH_Result_t *Copy_pResult, u8 *Copy_pu8Valid)
+{
+    MCH_voidLoopUntil(SIM_u64GetCycles() + SIM_F_CPU / 100);
+    for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+        MCH_u8GetResult(ch, &Copy_pResult[ch]);
+    MCH_voidLoopUntil(SIM_u64GetCycles() + Copy_u64Cycles);
+    for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+        Copy_pu8Valid[ch] = MCH_u8GetResult(ch, &Copy_pResult[ch]);
+}
+
+/* Measured frequency error in ppm of the source frequency */
+static s32 MCH_s32ErrorPpm(const MCH_Result_t *Copy_pResult, u32 Copy_u32FreqMilliHz)
+{
+    double f = (double)SIM_F_CPU * 1000.0 / Copy_pResult->period;
+    return (s32)((f - Copy_u32FreqMilliHz) * 1e6 / Copy_u32FreqMilliHz);
+}
+
+static u64 window = 0;
+static u8 fail = 0;
+
+static int MCH_iBench(void)
+{
+    static const Signal_t mixed[EXTI_CHANNELS] = {
+        { 2500000, 250 },     // 2.5 kHz, 25 %
+        {  331000, 600 },     // 331 Hz, 60 %
+        { 9981285, 500 },     // 9.981 kHz (1603 cycles), 50 %
+    };
+    MCH_Result_t res[EXTI_CHANNELS];
+    u8 valid[EXTI_CHANNELS];
+    u32 missed, overruns, backward, m0, o0, b0;
+    u8 flags;
+
+    ICU_voidInit();
+    ICU_voidSetClock(ICU_CLOCK_DIV1);
+
+    // Timer1 is read by the first access inside ICU_u32Now()
+    cli();
+    u64 before = SIM_u64GetCycles() + SIM_ACCESS_CYCLES;
+    tick_offset = before - ICU_u32Now(&flags);
+    sei();
+
+    MCH_voidInit();
+    EXTI_voidInit();
+
+    // Accuracy: unrelated signals (no common multiple of the periods, so edges
+    // of different channels meet at random, not at the same point each time),
+    // ICP1 at 1 kHz
+    MCH_voidSignals(1000000, mixed, 333);
+    MCH_voidMissed(&m0, &o0, &b0);
+    MCH_voidMeasure(window, res, valid);
+    MCH_voidMissed(&missed, &overruns, &backward);
+    printf("%-4s %10s %10s %8s %6s %6s %9s\n", "ch", "set_mhz", "meas_mhz", "err_ppm", "duty", "meas", "spread_cy");
+    for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+    {
+        if (!valid[ch])
+        {
+            printf("int%u no periods\n", (unsigned)ch);
+            fail = 1;
+            continue;
+        }
+        u32 meas = (u32)((u64)SIM_F_CPU * 1000 / res[ch].period);
+        u16 duty = (u16)(((u64)res[ch].high * 1000 + res[ch].period / 2) / res[ch].period);
+        s32 ppm = MCH_s32ErrorPpm(&res[ch], mixed[ch].freq_mhz);
+        printf("int%u %10u %10u %8d %6u %6u %9u\n", (unsigned)ch, (unsigned)mixed[ch].freq_mhz,
+               (unsigned)meas, (int)ppm, (unsigned)mixed[ch].duty, (unsigned)duty,
+               (unsigned)(res[ch].period_max - res[ch].period_min));
+        if (ppm > 100 || ppm < -100 || duty + 2 < mixed[ch].duty || duty > mixed[ch].duty + 2)
+            fail = 1;
+    }
+    printf("missed=%u overruns=%u backward=%u\n", (unsigned)(missed - m0), (unsigned)(overruns - o0),
+           (unsigned)(backward - b0));
+    if (missed != m0 || overruns != o0 || backward != b0)
+        fail = 1;
+
+    // Latency from source edge to timestamp: the same signals in phase (every
+    // INT1 and INT2 edge can meet an INT0 edge), ICP1 at 20 kHz
+    raw_mode = 1;
+    for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+    {
+        lat_sum[ch] = 0;
+        lat_count[ch] = 0;
+        lat_min[ch] = 0xFFFFFFFFUL;
+        lat_max[ch] = 0;
+        edge_log[ch].tail = edge_log[ch].head;
+    }
+    MCH_voidSignals(20000000, mixed, 0);
+    MCH_voidLoopUntil(SIM_u64GetCycles() + window);
+    u32 worst = 0;
+    for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+    {
+        if (lat_count[ch] == 0) continue;
+        printf("int%u_latency_cycles min=%u mean=%u max=%u edges=%u\n", (unsigned)ch,
+               (unsigned)lat_min[ch], (unsigned)(lat_sum[ch] / lat_count[ch]),
+               (unsigned)lat_max[ch], (unsigned)lat_count[ch]);
+        if (lat_max[ch] > worst) worst = lat_max[ch];
+    }
+    printf("latency_worst_cycles=%u\n", (unsigned)worst);
+    raw_mode = 0;
+    MCH_voidInit();     // Its pairing state is from before the raw run
+
+    // Sweep: all channels and ICP1 at the same frequency, edges coincident
+    static const u32 sweep_hz[] = { 1000, 5000, 10000, 15000, 20000, 50000, 100000, 200000 };
+    u32 ceiling = 0;
+    u8 clean = 1;
+    printf("%-8s %8s %8s %8s %10s\n", "freq_hz", "missed", "overruns", "backward", "worst_ppm");
+    for (u8 i = 0; i < sizeof(sweep_hz) / sizeof(sweep_hz[0]); i++)
+    {
+        Signal_t same[EXTI_CHANNELS];
+        for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+        {
+            same[ch].freq_mhz = sweep_hz[i] * 1000;
+            same[ch].duty = 500;
+        }
+        MCH_voidSignals(sweep_hz[i] * 1000, same, 0);
+        MCH_voidMissed(&m0, &o0, &b0);
+        MCH_voidMeasure(SIM_F_CPU / 10, res, valid);
+        MCH_voidMissed(&missed, &overruns, &backward);
+        missed -= m0;
+        overruns -= o0;
+        backward -= b0;
+
+        s32 worst_ppm = 0;
+        for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+        {
+            s32 ppm = valid[ch] ? MCH_s32ErrorPpm(&res[ch], same[ch].freq_mhz) : 1000000;
+            if (ppm < 0) ppm = -ppm;
+            if (ppm > worst_ppm) worst_ppm = ppm;
+        }
+        printf("%-8u %8u %8u %8u %10d\n", (unsigned)sweep_hz[i], (unsigned)missed, (unsigned)overruns,
+               (unsigned)backward, (int)worst_ppm);
+        // Ceiling: the last frequency of the unbroken clean run from the bottom.
+        // Past it the low-priority TIMER1_OVF starves behind the edge ISRs and
+        // stamps miss a wrap; EXTI drops those (backward) and MCH never pairs them
+        if (clean && missed == 0 && overruns == 0 && backward == 0 && worst_ppm <= 100)
+            ceiling = sweep_hz[i];
+        else
+            clean = 0;
+    }
+    printf("sim_ceiling_hz_all_channels=%u\n", (unsigned)ceiling);
+    if (ceiling < MCH_CEILING_HZ)
+        fail = 1;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    u32 ms = 500;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--ms") == 0 && i + 1 < argc)
+            ms = (u32)strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--ms N]\n", argv[0]);
+            return 2;
+        }
+    }
+    window = (u64)SIM_F_CPU / 1000 * ms;
+
+    SIM_voidTimersInit();
+    SIM_voidExtiInit();
+    SIM_voidOnExtiEdge(MCH_voidLogEdge);
+
+    // The whole sequence is one firmware run, as the budget only stops it early
+    SIM_u64Run(MCH_iBench, (u64)SIM_F_CPU * 3600);
+    printf("result=%s\n", fail ? "FAIL" : "ok");
+    return fail;
+}
@@ -0,0 +1,308 @@
+/*
+   Cycle and bus cost of the display and capture hot paths, as one CSV table
+   so a change in any of them shows up in a diff of the output:
+   - glcd_clear, glcd_display_string ("FREQ=1.000kHz" at 0,0, unbuffered)
+   - clear_text_area: the raw blank of pages 0-3 main() used to do before
+     every update, and display_lines: the cached status lines replacing it
+   - draw_waveform: WAVE refresh after 5 new periods, first and steady state
+     (the duty alternating between 30 and 40 %, so every refresh moves edges)
+   - main_loop_wake / main_loop_frame: the firmware main() run on the PWM
+     source, its duty stepping between 30 and 40 % every 100 ms so frames
+     have something to redraw; cycles awake between two sleeps (interrupts
+     excluded), split by whether the display frame was due
+   - isr_*: entry to end of reti per vector during that run, e.g.
+     isr_timer1_capt, nested handlers excluded
+   With GLCD_ASYNC_ENABLE the GLCD rows include GLCD_voidSync(), so their bus
+   figures stay comparable to the direct build; in the main loop the frame's
+   bus writes move into isr_timer2_comp.
+   Register accesses, delays and interrupt entry / exit are charged by the
+   simulator, plus a fixed per-vector estimate of the handler's instructions
+   (hand-counted, SIM_prog.c): the isr_* rows are those estimates plus the
+   accesses the handler made, not measurements of the chip. Other C code is
+   free: the GLCD and main loop rows are lower bounds set by bus time, as is
+   the GLCD queue drain inside isr_timer2_comp.
+
+   perf_bench [--freq HZ] [--ms N]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SIM_int.h"
+#include "KS0108/KS0108_int.h"
+#include "HAL/GLCD/GLCD_int.h"
+#include "HAL/GLCD/GLCD_cfg.h"
+#include "APP/WAVE/WAVE_int.h"
+#include "MCAL/TICK/TICK_cfg.h"
+
+#define PERF_FRAME_TICKS (TICK_HZ / TICK_FRAME_HZ)
+
+// Firmware main() is built as FW_main for the host
+int FW_main(void);
+
+typedef struct
+{
+    u32 calls;
+    u64 cycles;
+    u32 max;
+    u64 bus;
+} PERF_Row_t;
+
+static u32 PERF_u32BusWrites(void)
+{
+    KS0108_Stats_t st;
+    KS0108_voidGetStats(&st);
+    return st.commands + st.data_writes;
+}
+
+static void PERF_voidAdd(PERF_Row_t *Copy_pRow, u64 Copy_u64Cycles, u32 Copy_u32Bus)
+{
+    Copy_pRow->calls++;
+    Copy_pRow->cycles += Copy_u64Cycles;
+    if (Copy_u64Cycles > Copy_pRow->max) Copy_pRow->max = (u32)Copy_u64Cycles;
+    Copy_pRow->bus += Copy_u32Bus;
+}
+
+static void PERF_voidPrint(const char *Copy_pcName, const PERF_Row_t *Copy_pRow, u8 Copy_u8HasBus)
+{
+    u32 calls = Copy_pRow->calls ? Copy_pRow->calls : 1;
+
+    printf("%s,%u,%u,%u,", Copy_pcName, (unsigned)Copy_pRow->calls,
+           (unsigned)(Copy_pRow->cycles / calls), (unsigned)Copy_pRow->max);
+    if (Copy_u8HasBus)
+        printf("%u", (unsigned)((Copy_pRow->bus + calls / 2) / calls));
+    printf("\n");
+}
+
+/* Time Copy_u8Calls runs of Copy_pfCase, Copy_pfPrep (if any) untimed before each */
+static void PERF_voidCase(const char *Copy_pcName, void (*Copy_pfCase)(void),
+                          void (*Copy_pfPrep)(void), u8 Copy_u8Calls)
+{
+    PERF_Row_t row = { 0 };
+
+    for (u8 i = 0; i < Copy_u8Calls; i++)
+    {
+        if (Copy_pfPrep != NULL)
+            Copy_pfPrep();
+#if GLCD_ASYNC_ENABLE
+        GLCD_voidSync();        // Nothing queued before the case is charged to it
+#endif
+        u32 bus = PERF_u32BusWrites();
+        u64 start = SIM_u64GetCycles();
+        Copy_pfCase();
+#if GLCD_ASYNC_ENABLE
+        GLCD_voidSync();
+#endif
+        PERF_voidAdd(&row, SIM_u64GetCycles() - start, PERF_u32BusWrites() - bus);
+    }
+    PERF_voidPrint(Copy_pcName, &row, 1);
+}
+
+/* ---------------------- Display cases ---------------------- */
+static void PERF_voidClear(void)
+{
+    GLCD_voidClear();
+}
+
+static void PERF_voidDisplayString(void)
+{
+    GLCD_voidGotoXY(0, 0);
+    GLCD_voidDisplayString((u8 *)"FREQ=1.000kHz");
+}
+
+static void PERF_voidClearTextArea(void)
+{
+    for (u8 page = 0; page < 4; page++)
+    {
+        for (u8 chip = 1; chip <= 2; chip++)
+        {
+            GLCD_voidCommand(0xB8 | page, chip);
+            GLCD_voidCommand(0x40, chip);
+            for (u8 col = 0; col < 64; col++)
+                GLCD_voidWriteData(0x00, chip);
+        }
+    }
+}
+
+/* Status lines as main() shows them, alternating so every call changes some glyphs */
+static u8 lines_odd = 0;
+static void PERF_voidDisplayLines(void)
+{
+    static const char *const text[2][4] = {
+        { "FREQ=1.000kHz", "DUTY=30.0%", "TIME=1.000ms", "DIV=500.0us" },
+        { "FREQ=1.001kHz", "DUTY=30.1%", "TIME=999.0us", "DIV=500.0us" },
+    };
+    for (u8 page = 0; page < 4; page++)
+        GLCD_voidDisplayLine(page, text[lines_odd][page]);
+    lines_odd ^= 1;
+}
+
+/* Edge stream at clock / 1: 1 kHz */
+static u32 edge_now = 0;
+static void PERF_voidEdge(u32 Copy_u32After, u8 Copy_u8Rising)
+{
+    ICU_Edge_t edge;
+    edge_now += Copy_u32After;
+    edge.timestamp = edge_now;
+    edge.flags = (ICU_CLOCK_DIV1 << ICU_FLAG_CLOCK_SHIFT) | (Copy_u8Rising ? ICU_FLAG_RISING : 0);
+    WAVE_voidAddEdge(&edge);
+}
+
+static u32 edge_high = 6400;
+static void PERF_voidFeedEdges(void)
+{
+    u32 low = 16000 - edge_high;
+
+    edge_high = (edge_high == 4800) ? 6400 : 4800;
+    for (u8 i = 0; i < 5; i++)
+    {
+        PERF_voidEdge(low, 1);
+        PERF_voidEdge(edge_high, 0);
+        low = 16000 - edge_high;
+    }
+}
+
+static void PERF_voidDrawWaveform(void)
+{
+    WAVE_voidRefresh();
+}
+
+/* ---------------------- Main loop ---------------------- */
+static u32 source_mhz = 0;
+static u8  source_step = 0;
+static void PERF_voidStepDuty(u64 Copy_u64Now)
+{
+    (void)Copy_u64Now;
+    source_step ^= 1;
+    SIM_voidSetPwm(source_mhz, source_step ? 400 : 300);
+}
+
+static u64 measure_from = 0;
+static u8  measuring = 0;
+static u64 sleep_from = 0;          // Sleep cycles before the window
+static u64 wake_at = 0, irq_at = 0;
+static u32 bus_at = 0;
+static u8  tick_vector = 0xFF;
+static u32 tick_base = 0;           // Ticks since TICK_voidInit when the counts were reset
+static u32 ticks_at = 0;
+static u8  frame_due = 0;
+static PERF_Row_t wake_row, frame_row;
+
+/* Timer2 ticks since TICK_voidInit (the firmware's frame phase) */
+static u32 PERF_u32Ticks(void)
+{
+    SIM_IrqStats_t st;
+    if (tick_vector == 0xFF)
+        return 0;
+    SIM_pcIrqStats(tick_vector, &st);
+    return tick_base + st.count;
+}
+
+/* Woken up: an awake span starts. The frame is due in it if the tick that
+   makes it due ran since the last wake-up */
+static void PERF_voidWake(u64 Copy_u64Now)
+{
+    u32 ticks = PERF_u32Ticks();
+
+    if (!measuring && Copy_u64Now >= measure_from)
+    {
+        tick_base = ticks;
+        SIM_voidResetIrqStats();
+        sleep_from = SIM_u64SleepCycles();
+        measuring = 1;
+    }
+    frame_due = (ticks / PERF_FRAME_TICKS) != (ticks_at / PERF_FRAME_TICKS);
+    ticks_at = ticks;
+    wake_at = Copy_u64Now;
+    irq_at = SIM_u64IrqCycles();
+    bus_at = PERF_u32BusWrites();
+}
+
+/* Going to sleep: the span ends */
+static void PERF_voidSleep(u64 Copy_u64Now)
+{
+    if (!measuring || wake_at == 0)
+        return;
+    PERF_voidAdd(frame_due ? &frame_row : &wake_row,
+                 Copy_u64Now - wake_at - (SIM_u64IrqCycles() - irq_at), PERF_u32BusWrites() - bus_at);
+    wake_at = 0;
+}
+
+int main(int argc, char **argv)
+{
+    u32 freq_hz = 1000;
+    u32 ms = 1000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--freq") == 0 && i + 1 < argc)
+            freq_hz = (u32)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--ms") == 0 && i + 1 < argc)
+            ms = (u32)strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--freq HZ] [--ms N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    printf("case,calls,cycles_mean,cycles_max,bus_writes_per_call\n");
+
+    KS0108_voidInit();
+    GLCD_voidInit();
+    PERF_voidCase("glcd_clear", PERF_voidClear, NULL, 4);
+    PERF_voidCase("glcd_display_string", PERF_voidDisplayString, NULL, 8);
+    PERF_voidCase("clear_text_area", PERF_voidClearTextArea, NULL, 8);
+    GLCD_voidClear();
+    PERF_voidCase("display_lines", PERF_voidDisplayLines, NULL, 8);
+
+    GLCD_voidClear();
+    WAVE_voidInit();
+    WAVE_voidSetTimebase(500);
+    PERF_voidCase("draw_waveform_first", PERF_voidDrawWaveform, PERF_voidFeedEdges, 1);
+    PERF_voidCase("draw_waveform", PERF_voidDrawWaveform, PERF_voidFeedEdges, 8);
+
+    // The whole firmware: splash, then measure once the capture has settled
+    SIM_voidTimersInit();
+    SIM_voidExtiInit();
+    SIM_voidAdcInit();
+    SIM_voidUartInit(-1);
+    source_mhz = freq_hz * 1000;
+    SIM_voidSetPwm(source_mhz, 300);
+    SIM_voidEvery(SIM_F_CPU / 10, PERF_voidStepDuty);
+    SIM_voidOnSleep(PERF_voidSleep, PERF_voidWake);
+
+    SIM_IrqStats_t st;
+    const char *name;
+    for (u8 v = 0; (name = SIM_pcIrqStats(v, &st)) != NULL; v++)
+        if (strcmp(name, "TIMER2_COMP") == 0)
+            tick_vector = v;
+
+    u64 start = SIM_u64GetCycles();
+    measure_from = start + SIM_F_CPU * 3 / 2;
+    u64 end = SIM_u64Run(FW_main, SIM_F_CPU * 3 / 2 + (u64)SIM_F_CPU / 1000 * ms);
+    PERF_voidPrint("main_loop_wake", &wake_row, 1);
+    PERF_voidPrint("main_loop_frame", &frame_row, 1);
+
+    for (u8 v = 0; (name = SIM_pcIrqStats(v, &st)) != NULL; v++)
+    {
+        char row_name[32];
+        PERF_Row_t row = { st.count, st.cycles, st.max, 0 };
+
+        if (st.count == 0) continue;
+        snprintf(row_name, sizeof(row_name), "isr_%s", name);
+        for (char *c = row_name; *c; c++)
+            if (*c >= 'A' && *c <= 'Z') *c += 'a' - 'A';
+        PERF_voidPrint(row_name, &row, 0);
+    }
+
+    // Over the measured window: share of it not asleep
+    u64 window = end - measure_from;
+    printf("\n");
+    printf("window_cycles=%llu\n", (unsigned long long)window);
+    printf("cpu_load_pct=%u\n", (unsigned)(100 - (SIM_u64SleepCycles() - sleep_from) * 100 / window));
+    KS0108_Stats_t ks;
+    KS0108_voidGetStats(&ks);
+    printf("glcd_timing_violations=%u\n", (unsigned)KS0108_u32Violations(&ks));
+    return 0;
+}
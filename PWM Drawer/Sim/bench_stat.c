@@ -0,0 +1,164 @@
+/*
+   Period statistics harness: streams synthetic period / high-time sets
+   (steady, Gaussian-like and sinusoidal jitter, a slow drift, one huge
+   outlier and deviations past the clamp) through APP/STAT and checks every
+   published window against a double-precision two-pass reference. Windows
+   with a sample more than STAT_DEV_LIMIT from the first one must be flagged
+   clamped; their mean and stddev are approximate and not compared.
+
+   stat_bench
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "Service/std_types.h"
+#include "APP/STAT/STAT_int.h"
+#include "APP/STAT/STAT_cfg.h"
+#include "APP/STAT/STAT_priv.h"
+
+typedef struct
+{
+    const char *name;
+    u32 period;         // Nominal period and high time (cycles)
+    u32 high;
+    u32 jitter;         // Amplitude of the period jitter (cycles)
+    u8  shape;          // 0 steady, 1 pseudo-random, 2 sine, 3 drift, 4 outlier
+} Signal_t;
+
+static const Signal_t signals[] = {
+    { "steady_1k",     16000,     4800,    0, 0 },
+    { "random_1k",     16000,     4800,  120, 1 },
+    { "random_50k",      320,      160,    3, 1 },
+    { "sine_100",     160000,    80000, 2000, 2 },
+    { "drift_2hz",   8000000,   800000, 90000, 3 },
+    { "outlier_1k",    16000,     4800,   40, 4 },
+    { "slow_0.1hz", 160000000, 16000000, 400000, 1 },
+    { "ramp_0.1hz",  160000000, 16000000, 12000000, 3 },
+};
+
+static u32 rng = 12345;
+static s32 STAT_s32Noise(u32 Copy_u32Amp)
+{
+    // Sum of 4 uniform values: roughly Gaussian, +-Copy_u32Amp
+    s32 acc = 0;
+    for (u8 i = 0; i < 4; i++)
+    {
+        rng = rng * 1103515245UL + 12345;
+        acc += (s32)((rng >> 8) % (2 * Copy_u32Amp + 1)) - (s32)Copy_u32Amp;
+    }
+    return acc / 4;
+}
+
+static u32 STAT_u32Sample(const Signal_t *s, u32 n)
+{
+    switch (s->shape)
+    {
+    case 1: return s->period + STAT_s32Noise(s->jitter);
+    case 2: return (u32)(s->period + s->jitter * sin(n * 0.37));
+    case 3: return s->period + (n % STAT_WINDOW) * s->jitter / STAT_WINDOW;
+    case 4: return s->period + STAT_s32Noise(s->jitter) + ((n % STAT_WINDOW) == 17 ? 100000 : 0);
+    }
+    return s->period;
+}
+
+/* Error against the reference in cycles, a failure when above tol */
+static double STAT_f64Check(const char *what, u32 got, double want, double tol, u32 *bad)
+{
+    double err = fabs((double)got - want);
+    if (err > tol)
+    {
+        printf("  %s: got %u want %.3f\n", what, (unsigned)got, want);
+        (*bad)++;
+    }
+    return err;
+}
+
+int main(void)
+{
+    u32 bad = 0;
+
+    printf("%-12s %12s %10s %10s %10s %8s %7s\n", "signal", "mean", "sd", "pp", "c2c", "sd_err", "clamped");
+    for (u8 k = 0; k < sizeof(signals) / sizeof(signals[0]); k++)
+    {
+        const Signal_t *s = &signals[k];
+        static u32 per[STAT_WINDOW], hi[STAT_WINDOW];
+        STAT_Result_t r;
+        double worst_sd = 0;
+        u32 last = 0;           // Period before the window
+
+        STAT_voidReset();
+        for (u32 w = 0; w < 8; w++)
+        {
+            for (u32 i = 0; i < STAT_WINDOW; i++)
+            {
+                per[i] = STAT_u32Sample(s, w * STAT_WINDOW + i);
+                hi[i] = s->high + (s->shape ? STAT_s32Noise(s->jitter / 2 + 1) : 0);
+                STAT_voidAddPeriod(per[i], hi[i]);
+                if (i < STAT_WINDOW - 1 && STAT_u8GetResult(&r))
+                {
+                    printf("  result published early\n");
+                    bad++;
+                }
+            }
+            if (!STAT_u8GetResult(&r))
+            {
+                printf("  no result after a full window\n");
+                bad++;
+                continue;
+            }
+
+            // Two-pass reference
+            double m = 0, mh = 0, v = 0, vh = 0;
+            u32 mn = per[0], mx = per[0], c2c = 0;
+            u8 clamped = 0;
+            for (u32 i = 0; i < STAT_WINDOW; i++)
+            {
+                if (fabs((double)per[i] - per[0]) > STAT_DEV_LIMIT || fabs((double)hi[i] - hi[0]) > STAT_DEV_LIMIT)
+                    clamped = 1;
+                m += per[i];
+                mh += hi[i];
+                if (per[i] < mn) mn = per[i];
+                if (per[i] > mx) mx = per[i];
+                // The first period of a window follows the last one of the previous window
+                if (i > 0 || w > 0)
+                {
+                    u32 prev = (i > 0) ? per[i - 1] : last;
+                    u32 d = per[i] > prev ? per[i] - prev : prev - per[i];
+                    if (d > c2c) c2c = d;
+                }
+            }
+            last = per[STAT_WINDOW - 1];
+            m /= STAT_WINDOW;
+            mh /= STAT_WINDOW;
+            for (u32 i = 0; i < STAT_WINDOW; i++)
+            {
+                v += (per[i] - m) * (per[i] - m);
+                vh += (hi[i] - mh) * (hi[i] - mh);
+            }
+            double sd = sqrt(v / STAT_WINDOW), sdh = sqrt(vh / STAT_WINDOW);
+
+            STAT_f64Check("clamped", r.clamped, clamped, 0, &bad);
+            if (!clamped)
+            {
+                STAT_f64Check("mean", r.period.mean, m, 0.5, &bad);
+                STAT_f64Check("high mean", r.high.mean, mh, 0.5, &bad);
+                double e = STAT_f64Check("stddev", r.period.stddev, sd, 1.0, &bad);
+                if (e > worst_sd) worst_sd = e;
+                STAT_f64Check("high stddev", r.high.stddev, sdh, 1.0, &bad);
+            }
+            STAT_f64Check("min", r.period.min, mn, 0, &bad);
+            STAT_f64Check("max", r.period.max, mx, 0, &bad);
+            STAT_f64Check("jitter_pp", r.jitter_pp, mx - mn, 0, &bad);
+            STAT_f64Check("jitter_c2c", r.jitter_c2c, c2c, 0, &bad);
+
+            if (w == 7)
+                printf("%-12s %12u %10u %10u %10u %8.3f %7u\n", s->name, (unsigned)r.period.mean,
+                       (unsigned)r.period.stddev, (unsigned)r.jitter_pp, (unsigned)r.jitter_c2c, worst_sd,
+                       (unsigned)r.clamped);
+        }
+    }
+
+    printf("failures=%u\n", (unsigned)bad);
+    return bad ? 1 : 0;
+}
@@ -0,0 +1,164 @@
+/*
+   Strip chart harness: feeds a slowly swept duty / frequency history into
+   the STRIP chart (start-line scroll, only the new row written) and into a
+   full-redraw chart of the same layout (every row replotted one pixel up
+   through the frame buffer each time), and prints the bus writes of both.
+
+   strip_bench [--rows N] [--out PREFIX]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SIM_int.h"
+#include "KS0108/KS0108_int.h"
+#include "HAL/GLCD/GLCD_int.h"
+#include "APP/STRIP/STRIP_int.h"
+#include "APP/STRIP/STRIP_cfg.h"
+
+// Chart rows under the one-page header
+#define BENCH_CHART_ROWS ((GLCD_PAGES - 1) * 8)
+
+static const char *prefix = NULL;
+
+static u32 STRIP_u32BusWrites(void)
+{
+    KS0108_Stats_t st;
+    KS0108_voidGetStats(&st);
+    KS0108_voidResetStats();
+    return st.commands + st.data_writes;
+}
+
+static void STRIP_voidDump(const char *name)
+{
+    char path[256];
+    if (prefix == NULL) return;
+    snprintf(path, sizeof(path), "%s_%s.pbm", prefix, name);
+    KS0108_u8WritePbm(path);
+}
+
+/* Test signal for row n: duty ramps 10-90 %, frequency climbs 50 Hz - 200 kHz */
+static u16 STRIP_u16Duty(u32 n)
+{
+    u32 step = n % 160;
+    return (u16)(100 + ((step < 80) ? step : 160 - step) * 10);
+}
+
+static u32 STRIP_u32Freq(u32 n)
+{
+    return 50UL << ((n / 12) % 13);
+}
+
+/* Full-redraw chart: newest row at the bottom, each older one a pixel higher */
+static u8 hist_duty[BENCH_CHART_ROWS];
+static u8 hist_freq[BENCH_CHART_ROWS];
+static u8 hist_count = 0;
+
+static void STRIP_voidFullPlot(u8 y, u8 x, u8 prev)
+{
+    u8 from = x, to = x;
+    if (prev < from) from = prev;
+    if (prev > to) to = prev;
+    for (u8 c = from; c <= to; c++)
+        GLCD_voidFbOrByte(y / 8, c, 1 << (y % 8));
+}
+
+static void STRIP_voidFullRedraw(u16 Copy_u16Duty, u32 Copy_u32Freq)
+{
+    if (hist_count == BENCH_CHART_ROWS)
+    {
+        memmove(hist_duty, hist_duty + 1, BENCH_CHART_ROWS - 1);
+        memmove(hist_freq, hist_freq + 1, BENCH_CHART_ROWS - 1);
+        hist_count--;
+    }
+    hist_duty[hist_count] = STRIP_u8DutyX(Copy_u16Duty);
+    hist_freq[hist_count] = STRIP_u8FreqX(Copy_u32Freq);
+    hist_count++;
+
+    GLCD_voidFbClearPages(1, GLCD_PAGES - 1);
+    for (u8 i = 0; i < hist_count; i++)
+    {
+        u8 y = (u8)(GLCD_HEIGHT - hist_count + i);
+        u8 prev = i ? i - 1 : 0;
+        STRIP_voidFullPlot(y, hist_duty[i], hist_duty[prev]);
+        STRIP_voidFullPlot(y, hist_freq[i], hist_freq[prev]);
+    }
+    GLCD_voidFlush();
+}
+
+int main(int argc, char **argv)
+{
+    u32 rows = 512;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--rows") == 0 && i + 1 < argc)
+            rows = (u32)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            prefix = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--rows N] [--out PREFIX]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Start-line scroll: one chart row per STRIP_DECIMATE samples
+    KS0108_voidInit();
+    GLCD_voidInit();
+    STRIP_voidInit();
+    STRIP_voidSetHeader("STRIP BENCH");
+    STRIP_voidRefresh();
+    STRIP_u32BusWrites();
+
+    u32 strip_total = 0, strip_max = 0;
+    for (u32 n = 0; n < rows; n++)
+    {
+        for (u8 s = 0; s < STRIP_DECIMATE; s++)
+            STRIP_voidAddSample(STRIP_u16Duty(n), STRIP_u32Freq(n));
+        STRIP_voidRefresh();
+
+        u32 w = STRIP_u32BusWrites();
+        strip_total += w;
+        if (w > strip_max) strip_max = w;
+    }
+    STRIP_voidDump("scroll");
+
+    KS0108_Stats_t st;
+    KS0108_voidGetStats(&st);
+    u32 violations = KS0108_u32Violations(&st);
+
+    // Full redraw of the same rows at a fixed start line
+    KS0108_voidInit();
+    GLCD_voidInit();
+    GLCD_voidClear();
+    STRIP_voidSetHeader("STRIP BENCH");
+    GLCD_voidFlush();
+    STRIP_u32BusWrites();
+
+    u32 full_total = 0, full_max = 0;
+    for (u32 n = 0; n < rows; n++)
+    {
+        STRIP_voidFullRedraw(STRIP_u16Duty(n), STRIP_u32Freq(n));
+
+        u32 w = STRIP_u32BusWrites();
+        full_total += w;
+        if (w > full_max) full_max = w;
+    }
+    STRIP_voidDump("full");
+
+    KS0108_voidGetStats(&st);
+    violations += KS0108_u32Violations(&st);
+
+    printf("rows=%u\n", (unsigned)rows);
+    printf("scroll_bus_writes=%u\n", (unsigned)strip_total);
+    printf("scroll_bus_writes_per_row=%u.%02u\n", (unsigned)(strip_total / rows),
+           (unsigned)((strip_total % rows) * 100 / rows));
+    printf("scroll_bus_writes_max_row=%u\n", (unsigned)strip_max);
+    printf("full_redraw_bus_writes=%u\n", (unsigned)full_total);
+    printf("full_redraw_bus_writes_per_row=%u.%02u\n", (unsigned)(full_total / rows),
+           (unsigned)((full_total % rows) * 100 / rows));
+    printf("full_redraw_bus_writes_max_row=%u\n", (unsigned)full_max);
+    printf("glcd_timing_violations=%u\n", (unsigned)violations);
+    return 0;
+}
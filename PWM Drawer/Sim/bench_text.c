@@ -0,0 +1,156 @@
+/*
+   GLCD text benchmark: bus transactions and simulated time needed to render
+   the three status lines main() prints, decoded by the KS0108 model. Then
+   the per-frame cost of the status lines: the old clear-and-redraw of the
+   text area against GLCD_voidDisplayLine() for an unchanged frame, one
+   changed digit and a shorter value.
+
+   glcd_text_bench [--repeat N]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SIM_int.h"
+#include "KS0108/KS0108_int.h"
+#include "HAL/GLCD/GLCD_int.h"
+
+// The status lines as main() lays them out (page, column, text)
+static const struct
+{
+    u8 page;
+    u8 col;
+    const char *text;
+} lines[] = {
+    { 0, 0,  "FREQ=1.000kHz" },
+    { 1, 0,  "DUTY=25.0%" },
+    { 2, 0,  "TIME=1.000ms" },
+};
+
+static u32 violations = 0;
+
+static u32 TEXT_u32BusWrites(void)
+{
+    KS0108_Stats_t st;
+    KS0108_voidGetStats(&st);
+    KS0108_voidResetStats();
+    violations += KS0108_u32Violations(&st);
+    return st.commands + st.data_writes;
+}
+
+/* Text area pixels, to check both methods leave the same screen */
+static void TEXT_voidSnapshot(u8 Copy_pu8Dst[32][GLCD_WIDTH])
+{
+    for (u8 y = 0; y < 32; y++)
+        for (u8 x = 0; x < GLCD_WIDTH; x++)
+            Copy_pu8Dst[y][x] = KS0108_u8GetPixel(x, y);
+}
+
+/* What main() used to do every update: blank pages 0-3, then draw */
+static void TEXT_voidClearRedraw(const char *const *Copy_ppText)
+{
+    for (u8 page = 0; page < 4; page++)
+    {
+        for (u8 chip = 1; chip <= 2; chip++)
+        {
+            GLCD_voidCommand(0xB8 | page, chip);
+            GLCD_voidCommand(0x40, chip);
+            for (u8 col = 0; col < 64; col++)
+                GLCD_voidWriteData(0x00, chip);
+        }
+    }
+    for (u8 page = 0; page < 4; page++)
+    {
+        GLCD_voidGotoXY(page, 0);
+        GLCD_voidDisplayString((u8 *)Copy_ppText[page]);
+    }
+}
+
+static void TEXT_voidLines(const char *const *Copy_ppText)
+{
+    for (u8 page = 0; page < 4; page++)
+        GLCD_voidDisplayLine(page, Copy_ppText[page]);
+}
+
+int main(int argc, char **argv)
+{
+    u32 repeat = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+            repeat = strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fprintf(stderr, "usage: %s [--repeat N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    KS0108_voidInit();
+    GLCD_voidInit();
+    KS0108_voidResetStats();
+
+    u64 start = SIM_u64GetCycles();
+    for (u32 r = 0; r < repeat; r++)
+    {
+        for (u8 i = 0; i < sizeof(lines) / sizeof(lines[0]); i++)
+        {
+            GLCD_voidGotoXY(lines[i].page, lines[i].col);
+            GLCD_voidDisplayString((u8 *)lines[i].text);
+        }
+    }
+    u64 cycles = SIM_u64GetCycles() - start;
+
+    KS0108_Stats_t st;
+    KS0108_voidGetStats(&st);
+    u32 chars = 0;
+    for (u8 i = 0; i < sizeof(lines) / sizeof(lines[0]); i++)
+        chars += (u32)strlen(lines[i].text);
+    chars *= repeat;
+
+    printf("chars=%u\n", (unsigned)chars);
+    printf("glcd_commands=%u\n", (unsigned)st.commands);
+    printf("glcd_data_writes=%u\n", (unsigned)st.data_writes);
+    printf("glcd_status_reads=%u\n", (unsigned)st.status_reads);
+    printf("bus_writes_per_char=%.2f\n", (double)(st.commands + st.data_writes) / chars);
+    printf("cycles=%llu\n", (unsigned long long)cycles);
+    printf("us_per_char=%.2f\n", (double)cycles / (SIM_F_CPU / 1000000UL) / chars);
+    violations = KS0108_u32Violations(&st);
+
+    // Status frames as the main loop produces them
+    static const char *const frames[][4] = {
+        { "FREQ=1.000kHz", "DUTY=25.0%", "TIME=1.000ms",   "DIV=500.000us" },   // First
+        { "FREQ=1.000kHz", "DUTY=25.0%", "TIME=1.000ms",   "DIV=500.000us" },   // Steady
+        { "FREQ=1.001kHz", "DUTY=25.0%", "TIME=999.000us", "DIV=500.000us" },   // One digit / new unit
+        { "FREQ=1.001kHz", "DUTY=5.0%",  "TIME=999.000us", "" },                // Shorter, line gone
+    };
+    static const char *const names[] = { "first", "steady", "change", "shorter" };
+
+    static u8 expect[4][32][GLCD_WIDTH], got[32][GLCD_WIDTH];
+    u32 mismatches = 0;
+
+    GLCD_voidClear();
+    TEXT_u32BusWrites();
+    for (u8 f = 0; f < 4; f++)
+    {
+        TEXT_voidClearRedraw(frames[f]);
+        printf("clear_redraw_%s_bus_writes=%u\n", names[f], (unsigned)TEXT_u32BusWrites());
+        TEXT_voidSnapshot(expect[f]);
+    }
+
+    GLCD_voidClear();
+    TEXT_u32BusWrites();
+    for (u8 f = 0; f < 4; f++)
+    {
+        TEXT_voidLines(frames[f]);
+        printf("display_line_%s_bus_writes=%u\n", names[f], (unsigned)TEXT_u32BusWrites());
+        TEXT_voidSnapshot(got);
+        if (memcmp(got, expect[f], sizeof(got)) != 0)
+            mismatches++;
+    }
+    printf("screen_mismatches=%u\n", (unsigned)mismatches);
+
+    printf("glcd_timing_violations=%u\n", (unsigned)violations);
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+   Waveform plot harness: feeds a synthetic edge stream (1 kHz, 30 %, with
+   jitter and one runt pulse) through the WAVE engine, then views the
+   recorded history at several pans and zooms without new captures. Every
+   view is dumped as a frame; bus traffic per step is printed.
+
+   wave_bench [--out PREFIX]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SIM_int.h"
+#include "KS0108/KS0108_int.h"
+#include "HAL/GLCD/GLCD_int.h"
+#include "APP/WAVE/WAVE_int.h"
+#include "APP/HIST/HIST_int.h"
+#include "APP/HIST/HIST_cfg.h"
+
+static const char *prefix = NULL;
+
+static u32 WAVE_u32BusWrites(void)
+{
+    KS0108_Stats_t st;
+    KS0108_voidGetStats(&st);
+    KS0108_voidResetStats();
+    return st.commands + st.data_writes;
+}
+
+static void WAVE_voidDump(const char *name)
+{
+    char path[256];
+    if (prefix == NULL) return;
+    snprintf(path, sizeof(path), "%s_%s.pbm", prefix, name);
+    KS0108_u8WritePbm(path);
+}
+
+/* Edge stream in CPU cycles, timestamps as the ICU reports them at clock / 1 */
+static u32 now = 0;
+static void WAVE_voidEdge(u32 Copy_u32After, u8 Copy_u8Rising)
+{
+    ICU_Edge_t edge;
+    now += Copy_u32After;
+    edge.timestamp = now;
+    edge.flags = (ICU_CLOCK_DIV1 << ICU_FLAG_CLOCK_SHIFT) | (Copy_u8Rising ? ICU_FLAG_RISING : 0);
+    WAVE_voidAddEdge(&edge);
+}
+
+static s32 last_jitter = 0;
+static void WAVE_voidPeriods(u32 Copy_u32Count, u8 Copy_u8Runt)
+{
+    for (u32 i = 0; i < Copy_u32Count; i++)
+    {
+        // 16000 cycle period, 4800 high, +-120 cycles of jitter on the falling edge
+        s32 jitter = (s32)((i * 7919) % 241) - 120;
+
+        WAVE_voidEdge((u32)(16000 - 4800 - last_jitter), 1);
+        if (Copy_u8Runt && i == Copy_u32Count / 2)
+        {
+            // Runt: a 1.5 us dip in the high time
+            WAVE_voidEdge(2000, 0);
+            WAVE_voidEdge(24, 1);
+            WAVE_voidEdge((u32)(4800 - 2024 + jitter), 0);
+        }
+        else
+        {
+            WAVE_voidEdge((u32)(4800 + jitter), 0);
+        }
+        last_jitter = jitter;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            prefix = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--out PREFIX]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    KS0108_voidInit();
+    GLCD_voidInit();
+    GLCD_voidClear();
+    WAVE_voidInit();
+    WAVE_voidSetTimebase(500);
+    WAVE_u32BusWrites();
+
+    // Live sweeps: the first draws the trace, the next ones only what moved
+    for (u8 sweep = 0; sweep < 3; sweep++)
+    {
+        WAVE_voidPeriods(5, sweep == 2);
+        WAVE_voidRefresh();
+        printf("sweep%u_bus_writes=%u\n", (unsigned)sweep, (unsigned)WAVE_u32BusWrites());
+    }
+    WAVE_voidDump("live");
+
+    // Fill the history, then look back without capturing anything new
+    WAVE_voidPeriods(40, 1);
+    printf("history_runs=%u\n", (unsigned)HIST_u8Count());
+    printf("history_bytes=%u\n", (unsigned)(HIST_SIZE * 2));
+
+    u64 span = 0;
+    for (u8 age = 0; age < HIST_u8Count(); age++)
+    {
+        u8 level;
+        span += HIST_u32GetRun(age, &level);
+    }
+    printf("history_span_us=%llu\n", (unsigned long long)(span / (SIM_F_CPU / 1000000UL)));
+    // The same span as a 1 bit per sample bitmap at 1 us resolution
+    printf("history_bitmap_bytes_1us=%llu\n", (unsigned long long)(span / (SIM_F_CPU / 1000000UL) / 8));
+
+    static const struct
+    {
+        const char *name;
+        u32 pan_us;
+        u32 us_per_div;
+    } views[] = {
+        { "view_now",     0,     500 },
+        { "view_back10ms", 10000, 500 },
+        { "view_runt",   19100,  20 },     // Zoomed on the runt pulse
+        { "view_all",        0, 5000 },
+    };
+    for (u8 v = 0; v < sizeof(views) / sizeof(views[0]); v++)
+    {
+        WAVE_voidView(views[v].pan_us, views[v].us_per_div);
+        printf("%s_bus_writes=%u\n", views[v].name, (unsigned)WAVE_u32BusWrites());
+        WAVE_voidDump(views[v].name);
+    }
+
+    WAVE_voidLive();
+    KS0108_Stats_t st;
+    KS0108_voidGetStats(&st);
+    printf("glcd_timing_violations=%u\n", (unsigned)KS0108_u32Violations(&st));
+    return 0;
+}
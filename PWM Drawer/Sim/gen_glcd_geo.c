@@ -0,0 +1,101 @@
+/*
+   Host generator for the GLCD geometry tables (HAL/GLCD/GLCD_geo.c): row ->
+   bit in its page, and the bits of a page covered by rows y0..y1. Run by
+   the CMake build, which compiles its output; with --check the checked-in
+   copy (used by the Microchip Studio project) must match, so a generator
+   change cannot leave the AVR build behind.
+
+   gen_glcd_geo OUT.c [--check CHECKED_IN.c]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+// KS0108 pair: 8 pages of 8 rows
+#define GEO_HEIGHT      64
+
+static char out[16384];
+static size_t len = 0;
+
+static void GEO_voidEmit(const char *Copy_pcFmt, ...)
+{
+    va_list ap;
+    va_start(ap, Copy_pcFmt);
+    len += (size_t)vsnprintf(out + len, sizeof(out) - len, Copy_pcFmt, ap);
+    va_end(ap);
+}
+
+/* One table of n bytes, 16 per line, after a comment line */
+static void GEO_voidTable(const char *Copy_pcComment, const char *Copy_pcDecl,
+                          const unsigned char *Copy_pu8Val, int Copy_iCount)
+{
+    GEO_voidEmit("\n/* %s */\n%s PROGMEM = {", Copy_pcComment, Copy_pcDecl);
+    for (int i = 0; i < Copy_iCount; i++)
+        GEO_voidEmit("%s0x%02X,", (i % 16 == 0) ? "\n    " : " ", Copy_pu8Val[i]);
+    GEO_voidEmit("\n};\n");
+}
+
+static int GEO_iWrite(const char *Copy_pcPath)
+{
+    FILE *f = fopen(Copy_pcPath, "wb");
+    if (f == NULL || fwrite(out, 1, len, f) != len || fclose(f) != 0)
+    {
+        fprintf(stderr, "gen_glcd_geo: cannot write %s\n", Copy_pcPath);
+        return 1;
+    }
+    return 0;
+}
+
+/* Compare with a checked-in copy, line endings aside */
+static int GEO_iCheck(const char *Copy_pcPath, const char *Copy_pcOut)
+{
+    static char have[sizeof(out)];
+    size_t n = 0;
+    int c;
+    FILE *f = fopen(Copy_pcPath, "rb");
+
+    if (f != NULL)
+    {
+        while ((c = fgetc(f)) != EOF && n < sizeof(have))
+            if (c != '\r') have[n++] = (char)c;
+        fclose(f);
+        if (n == len && memcmp(have, out, len) == 0)
+            return 0;
+    }
+    fprintf(stderr, "gen_glcd_geo: %s is out of date, copy %s over it\n", Copy_pcPath, Copy_pcOut);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned char mask[GEO_HEIGHT], span[64];
+
+    if (argc != 2 && !(argc == 4 && strcmp(argv[2], "--check") == 0))
+    {
+        fprintf(stderr, "usage: %s OUT.c [--check CHECKED_IN.c]\n", argv[0]);
+        return 2;
+    }
+
+    for (int y = 0; y < GEO_HEIGHT; y++)
+        mask[y] = (unsigned char)(1 << (y % 8));
+    // [y0 * 8 + y1], rows within one page, 0 when y0 > y1
+    for (int y0 = 0; y0 < 8; y0++)
+        for (int y1 = 0; y1 < 8; y1++)
+            span[y0 * 8 + y1] = (y0 > y1) ? 0 : (unsigned char)((0xFF << y0) & (0xFF >> (7 - y1)));
+
+    GEO_voidEmit("/*\n"
+                 "   GLCD geometry tables - generated by Sim/gen_glcd_geo.c, do not edit\n"
+                 "*/\n\n"
+                 "#include \"GLCD_geo.h\"\n");
+    GEO_voidTable("Row -> bit in its page", "const u8 GLCD_au8RowMask[GLCD_HEIGHT]", mask, GEO_HEIGHT);
+    GEO_voidTable("Rows y0..y1 of one page (0-7) -> bits, [y0 * 8 + y1]",
+                  "const u8 GLCD_au8SpanMask[64]", span, 64);
+
+    if (GEO_iWrite(argv[1]) != 0)
+        return 1;
+    if (argc == 4)
+        return GEO_iCheck(argv[3], argv[1]);
+    return 0;
+}
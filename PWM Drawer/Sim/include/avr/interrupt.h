@@ -0,0 +1,15 @@
+#ifndef SIM_AVR_INTERRUPT_H_
+#define SIM_AVR_INTERRUPT_H_
+
+/* Host stand-in for <avr/interrupt.h>: handlers become plain functions the
+   simulator calls (by vector name) when their flag and enable bits are set */
+
+void SIM_voidSei(void);
+void SIM_voidCli(void);
+
+#define sei() SIM_voidSei()
+#define cli() SIM_voidCli()
+
+#define ISR(vector, ...) void vector(void); void vector(void)
+
+#endif /* SIM_AVR_INTERRUPT_H_ */
@@ -0,0 +1,157 @@
+#ifndef SIM_AVR_IO_H_
+#define SIM_AVR_IO_H_
+
+/* Host stand-in for <avr/io.h> (ATmega32). Register names resolve to the
+   simulator's I/O space through SIM_pu8Access(), the same path the
+   MCAL/reg_def.h registers take in a SIM_HOST build. */
+
+#include <stdint.h>
+
+volatile uint8_t *SIM_pu8Access(uint8_t Copy_u8Addr);
+
+#define _SFR_MEM8(addr)  (*SIM_pu8Access(addr))
+#define _SFR_MEM16(addr) (*(volatile uint16_t*)SIM_pu8Access(addr))
+#define _BV(bit)         (1 << (bit))
+
+/* Registers (data-space addresses) */
+#define ADCW    _SFR_MEM16(0x24)
+#define ADC     _SFR_MEM16(0x24)
+#define ADCL    _SFR_MEM8(0x24)
+#define ADCH    _SFR_MEM8(0x25)
+#define ADCSRA  _SFR_MEM8(0x26)
+#define ADMUX   _SFR_MEM8(0x27)
+#define ACSR    _SFR_MEM8(0x28)
+#define UBRRL   _SFR_MEM8(0x29)
+#define UCSRB   _SFR_MEM8(0x2A)
+#define UCSRA   _SFR_MEM8(0x2B)
+#define UDR     _SFR_MEM8(0x2C)
+#define PIND    _SFR_MEM8(0x30)
+#define DDRD    _SFR_MEM8(0x31)
+#define PORTD   _SFR_MEM8(0x32)
+#define PINC    _SFR_MEM8(0x33)
+#define DDRC    _SFR_MEM8(0x34)
+#define PORTC   _SFR_MEM8(0x35)
+#define PINB    _SFR_MEM8(0x36)
+#define DDRB    _SFR_MEM8(0x37)
+#define PORTB   _SFR_MEM8(0x38)
+#define PINA    _SFR_MEM8(0x39)
+#define DDRA    _SFR_MEM8(0x3A)
+#define PORTA   _SFR_MEM8(0x3B)
+#define UBRRH   _SFR_MEM8(0x40)
+#define UCSRC   _SFR_MEM8(0x40)
+#define OCR2    _SFR_MEM8(0x43)
+#define TCNT2   _SFR_MEM8(0x44)
+#define TCCR2   _SFR_MEM8(0x45)
+#define ICR1    _SFR_MEM16(0x46)
+#define ICR1L   _SFR_MEM8(0x46)
+#define ICR1H   _SFR_MEM8(0x47)
+#define OCR1B   _SFR_MEM16(0x48)
+#define OCR1A   _SFR_MEM16(0x4A)
+#define TCNT1   _SFR_MEM16(0x4C)
+#define TCCR1B  _SFR_MEM8(0x4E)
+#define TCCR1A  _SFR_MEM8(0x4F)
+#define SFIOR   _SFR_MEM8(0x50)
+#define TCNT0   _SFR_MEM8(0x52)
+#define TCCR0   _SFR_MEM8(0x53)
+#define MCUCSR  _SFR_MEM8(0x54)
+#define MCUCR   _SFR_MEM8(0x55)
+#define TIFR    _SFR_MEM8(0x58)
+#define TIMSK   _SFR_MEM8(0x59)
+#define GIFR    _SFR_MEM8(0x5A)
+#define GICR    _SFR_MEM8(0x5B)
+#define OCR0    _SFR_MEM8(0x5C)
+#define SREG    _SFR_MEM8(0x5F)
+
+/* TIMSK / TIFR */
+#define OCIE2   7
+#define TOIE2   6
+#define TICIE1  5
+#define OCIE1A  4
+#define OCIE1B  3
+#define TOIE1   2
+#define OCIE0   1
+#define TOIE0   0
+#define OCF2    7
+#define TOV2    6
+#define ICF1    5
+#define OCF1A   4
+#define OCF1B   3
+#define TOV1    2
+#define OCF0    1
+#define TOV0    0
+
+/* TCCR1A / TCCR1B */
+#define WGM11   1
+#define WGM10   0
+#define ICNC1   7
+#define ICES1   6
+#define WGM13   4
+#define WGM12   3
+#define CS12    2
+#define CS11    1
+#define CS10    0
+
+/* TCCR0 / TCCR2 */
+#define WGM00   6
+#define COM01   5
+#define COM00   4
+#define WGM01   3
+#define CS02    2
+#define CS01    1
+#define CS00    0
+#define WGM20   6
+#define COM21   5
+#define COM20   4
+#define WGM21   3
+#define CS22    2
+#define CS21    1
+#define CS20    0
+
+/* GICR / GIFR / MCUCR / MCUCSR */
+#define INT1    7
+#define INT0    6
+#define INT2    5
+#define INTF1   7
+#define INTF0   6
+#define INTF2   5
+#define SE      7
+#define ISC11   3
+#define ISC10   2
+#define ISC01   1
+#define ISC00   0
+#define ISC2    6
+
+/* ADC */
+#define REFS1   7
+#define REFS0   6
+#define ADLAR   5
+#define ADEN    7
+#define ADSC    6
+#define ADATE   5
+#define ADIF    4
+#define ADIE    3
+#define ADPS2   2
+#define ADPS1   1
+#define ADPS0   0
+#define ADTS2   7
+#define ADTS1   6
+#define ADTS0   5
+
+/* USART */
+#define RXC     7
+#define TXC     6
+#define UDRE    5
+#define U2X     1
+#define RXCIE   7
+#define TXCIE   6
+#define UDRIE   5
+#define RXEN    4
+#define TXEN    3
+#define URSEL   7
+#define UCSZ1   2
+#define UCSZ0   1
+
+/* Pin numbers used by the firmware */
+#define PD6     6
+
+#endif /* SIM_AVR_IO_H_ */
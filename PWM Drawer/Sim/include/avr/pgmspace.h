@@ -0,0 +1,20 @@
+#ifndef SIM_AVR_PGMSPACE_H_
+#define SIM_AVR_PGMSPACE_H_
+
+/* Host stand-in for <avr/pgmspace.h>: one address space, so program memory
+   is ordinary const data and the flash reads are plain loads */
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+
+#define pgm_read_byte(addr)  (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr)   (*(const void *const *)(addr))
+
+#define memcpy_P(dst, src, n) memcpy((dst), (src), (n))
+#define PSTR(s)               (s)
+
+#endif /* SIM_AVR_PGMSPACE_H_ */
@@ -0,0 +1,16 @@
+#ifndef SIM_AVR_SLEEP_H_
+#define SIM_AVR_SLEEP_H_
+
+/* Host stand-in for <avr/sleep.h>: sleeping advances simulated time until
+   an interrupt handler has run */
+
+void SIM_voidSleep(void);
+
+#define SLEEP_MODE_IDLE 0
+
+#define set_sleep_mode(mode) ((void)(mode))
+#define sleep_enable()       ((void)0)
+#define sleep_disable()      ((void)0)
+#define sleep_cpu()          SIM_voidSleep()
+
+#endif /* SIM_AVR_SLEEP_H_ */
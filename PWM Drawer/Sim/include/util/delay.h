@@ -0,0 +1,20 @@
+#ifndef SIM_UTIL_DELAY_H_
+#define SIM_UTIL_DELAY_H_
+
+/* Host stand-in for <util/delay.h>: busy-waits become simulated cycles,
+   computed from F_CPU exactly like avr-libc does */
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#warning "F_CPU not defined for <util/delay.h>"
+#define F_CPU 1000000UL
+#endif
+
+void SIM_voidDelayCycles(uint32_t Copy_u32Cycles);
+
+#define _delay_us(us) SIM_voidDelayCycles((uint32_t)((double)(F_CPU) * (us) / 1e6 + 0.999))
+#define _delay_ms(ms) SIM_voidDelayCycles((uint32_t)((double)(F_CPU) * (ms) / 1e3 + 0.999))
+#define __builtin_avr_delay_cycles(cycles) SIM_voidDelayCycles((uint32_t)(cycles))
+
+#endif /* SIM_UTIL_DELAY_H_ */
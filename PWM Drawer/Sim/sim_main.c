@@ -0,0 +1,296 @@
+/*
+   Host simulation entry point: runs the unmodified firmware main() against
+   the simulated ATmega32, the PWM source and the KS0108 model, then dumps
+   the display and the bus statistics.
+
+   pwm_drawer_sim [--cycles N] [--freq HZ] [--duty PCT] [--glcd-busy NS]
+                  [--int0|--int1|--int2 HZ] [--int0-duty|--int1-duty|--int2-duty PCT]
+                  [--out FILE.pbm|FILE.png] [--frames PREFIX --frame-every N]
+                  [--uart FILE|pty] [--glitch-every N --glitch-width NS]
+                  [--adc dc|sine|triangle|square|saw] [--adc-freq HZ]
+                  [--adc-low PCT] [--adc-high PCT]
+
+   The INTn sources only matter to a firmware built with EXTI_ENABLE, the
+   analog source on ADC0 (levels in % of AVCC) to one built with ADC_ENABLE.
+   --uart saves what the firmware transmits on TXD (TLM_ENABLE frames) to a
+   file, or with "pty" to a raw pseudo-terminal whose name is printed first.
+   The simulation then runs at the pace of whoever reads it, e.g.
+   tlm_decode --in /dev/pts/N --csv run, and only exits once it has read
+   everything (Linux drops unread pty data on hangup).
+   --glitch-every N gives every Nth PWM period a high time of --glitch-width
+   instead, e.g. one runt among thousands for the trigger (ICU_TRIGGER_ENABLE).
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include "SIM_int.h"
+#include "KS0108/KS0108_int.h"
+#include "HAL/GLCD/GLCD_int.h"
+#include "HAL/GLCD/GLCD_cfg.h"
+#include "MCAL/ICU/ICU_interface.h"
+#include "MCAL/ICU/ICU_cfg.h"
+#include "MCAL/EXTI/EXTI_interface.h"
+#include "MCAL/EXTI/EXTI_cfg.h"
+#include "MCAL/ADC/ADC_interface.h"
+#include "MCAL/ADC/ADC_cfg.h"
+
+// Firmware main() is built as FW_main for the host
+int FW_main(void);
+
+static const char *frame_prefix = NULL;
+static u32 frame_index = 0;
+static int pty_hold = -1;           // Our own slave fd: keeps the output queued until a reader comes
+
+/* Parse a decimal like "12.5" into thousandths without floating point rounding surprises */
+static u32 SIM_u32ParseMilli(const char *str)
+{
+    u32 whole = 0, frac = 0, scale = 1000;
+
+    while (*str >= '0' && *str <= '9')
+        whole = whole * 10 + (*str++ - '0');
+    if (*str == '.')
+    {
+        str++;
+        while (*str >= '0' && *str <= '9' && scale > 1)
+        {
+            scale /= 10;
+            frac += (*str++ - '0') * scale;
+        }
+    }
+    return whole * 1000 + frac;
+}
+
+/* TXD sink: a file, or the master side of a new pty */
+static int SIM_iOpenUart(const char *Copy_pcPath)
+{
+    int fd;
+
+    if (strcmp(Copy_pcPath, "pty") != 0)
+        return open(Copy_pcPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0)
+        return -1;
+    pty_hold = open(ptsname(fd), O_RDONLY | O_NOCTTY);
+    if (pty_hold < 0)
+        return -1;
+
+    // Binary stream: no echo, no CR / LF translation
+    struct termios tio;
+    tcgetattr(pty_hold, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(pty_hold, TCSANOW, &tio);
+
+    fprintf(stderr, "uart_pty=%s\n", ptsname(fd));
+    return fd;
+}
+
+/* Wait for the reader to take everything queued on the pty */
+static void SIM_voidDrainUart(void)
+{
+    int queued;
+
+    if (pty_hold < 0)
+        return;
+    while (ioctl(pty_hold, FIONREAD, &queued) == 0 && queued > 0)
+        usleep(10000);
+    close(pty_hold);
+}
+
+static u8 SIM_u8ParseShape(const char *Copy_pcName)
+{
+    static const char *const names[] = { "dc", "sine", "triangle", "square", "saw" };
+
+    for (u8 i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+    {
+        if (strcmp(Copy_pcName, names[i]) == 0)
+            return i;
+    }
+    return 0xFF;
+}
+
+/* Write a frame as PNG or PBM depending on the file extension */
+static u8 SIM_u8WriteFrame(const char *path)
+{
+    size_t len = strlen(path);
+    if (len > 4 && strcmp(path + len - 4, ".png") == 0)
+        return KS0108_u8WritePng(path);
+    return KS0108_u8WritePbm(path);
+}
+
+static void SIM_voidFrameHook(u64 Copy_u64Now)
+{
+    char path[256];
+    (void)Copy_u64Now;
+    snprintf(path, sizeof(path), "%s_%04u.pbm", frame_prefix, (unsigned)frame_index++);
+    SIM_u8WriteFrame(path);
+}
+
+int main(int argc, char **argv)
+{
+    u64 budget = 2 * SIM_F_CPU;     // Two seconds of firmware time
+    u32 freq_mhz = 1000000;         // 1 kHz
+    u32 duty_permille = 250;        // 25 %
+    u64 frame_every = 0;
+    u32 busy_ns = 1000;             // KS0108 instruction time
+    const char *out = NULL;
+    const char *uart = NULL;
+    u8  adc_shape = SIM_ANALOG_SINE;
+    u32 adc_freq_mhz = 1000000;     // 1 kHz
+    u32 adc_low_permille = 100;     // 10 % .. 90 % of AVCC
+    u32 adc_high_permille = 900;
+    u32 glitch_every = 0;
+    u32 glitch_ns = 0;
+    u32 int_freq_mhz[SIM_EXTI_CHANNELS] = { 0, 0, 0 };
+    u32 int_duty_permille[SIM_EXTI_CHANNELS] = { 500, 500, 500 };
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (val == NULL)
+        {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return 2;
+        }
+        if (strcmp(arg, "--cycles") == 0) budget = strtoull(val, NULL, 0);
+        else if (strcmp(arg, "--freq") == 0) freq_mhz = SIM_u32ParseMilli(val);
+        else if (strcmp(arg, "--duty") == 0) duty_permille = SIM_u32ParseMilli(val) / 100;
+        else if (strcmp(arg, "--glcd-busy") == 0) busy_ns = strtoul(val, NULL, 0);
+        else if (strncmp(arg, "--int", 5) == 0 && arg[5] >= '0' && arg[5] < '0' + SIM_EXTI_CHANNELS &&
+                 (arg[6] == '\0' || strcmp(arg + 6, "-duty") == 0))
+        {
+            if (arg[6] == '\0') int_freq_mhz[arg[5] - '0'] = SIM_u32ParseMilli(val);
+            else int_duty_permille[arg[5] - '0'] = SIM_u32ParseMilli(val) / 100;
+        }
+        else if (strcmp(arg, "--out") == 0) out = val;
+        else if (strcmp(arg, "--frames") == 0) frame_prefix = val;
+        else if (strcmp(arg, "--frame-every") == 0) frame_every = strtoull(val, NULL, 0);
+        else if (strcmp(arg, "--uart") == 0) uart = val;
+        else if (strcmp(arg, "--glitch-every") == 0) glitch_every = strtoul(val, NULL, 0);
+        else if (strcmp(arg, "--glitch-width") == 0) glitch_ns = strtoul(val, NULL, 0);
+        else if (strcmp(arg, "--adc") == 0)
+        {
+            adc_shape = SIM_u8ParseShape(val);
+            if (adc_shape == 0xFF)
+            {
+                fprintf(stderr, "unknown waveform %s\n", val);
+                return 2;
+            }
+        }
+        else if (strcmp(arg, "--adc-freq") == 0) adc_freq_mhz = SIM_u32ParseMilli(val);
+        else if (strcmp(arg, "--adc-low") == 0) adc_low_permille = SIM_u32ParseMilli(val) / 100;
+        else if (strcmp(arg, "--adc-high") == 0) adc_high_permille = SIM_u32ParseMilli(val) / 100;
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 2;
+        }
+        i++;
+    }
+
+    SIM_voidTimersInit();
+    SIM_voidExtiInit();
+    SIM_voidAdcInit();
+    SIM_voidSetAnalog(adc_shape, adc_freq_mhz, (u16)((adc_low_permille * 1023 + 500) / 1000),
+                      (u16)((adc_high_permille * 1023 + 500) / 1000));
+    if (uart == NULL)
+    {
+        SIM_voidUartInit(-1);
+    }
+    else
+    {
+        int fd = SIM_iOpenUart(uart);
+        if (fd < 0)
+        {
+            fprintf(stderr, "cannot open %s\n", uart);
+            return 1;
+        }
+        SIM_voidUartInit(fd);
+    }
+    KS0108_voidInit();
+    KS0108_voidSetBusyCycles((u32)((busy_ns * (SIM_F_CPU / 1000000UL) + 999) / 1000));
+    SIM_voidSetPwm(freq_mhz, (u16)duty_permille);
+    SIM_voidSetGlitch(glitch_every, (u32)((u64)glitch_ns * (SIM_F_CPU / 1000000UL) / 1000));
+    for (u8 ch = 0; ch < SIM_EXTI_CHANNELS; ch++)
+    {
+        if (int_freq_mhz[ch] != 0)
+            SIM_voidSetExtiPwm(ch, int_freq_mhz[ch], (u16)int_duty_permille[ch], 0);
+    }
+    if (frame_prefix != NULL && frame_every != 0)
+        SIM_voidEvery(frame_every, SIM_voidFrameHook);
+
+    u64 ran = SIM_u64Run(FW_main, budget);
+    SIM_voidDrainUart();
+
+    KS0108_Stats_t st;
+    KS0108_voidGetStats(&st);
+    printf("cycles=%llu\n", (unsigned long long)ran);
+    printf("glcd_commands=%u\n", (unsigned)st.commands);
+    printf("glcd_data_writes=%u\n", (unsigned)st.data_writes);
+    printf("glcd_data_reads=%u\n", (unsigned)st.data_reads);
+    printf("glcd_status_reads=%u\n", (unsigned)st.status_reads);
+    printf("glcd_timing_violations=%u\n", (unsigned)KS0108_u32Violations(&st));
+    if (KS0108_u32Violations(&st) != 0)
+    {
+        printf("  cycle=%u pweh=%u pwel=%u setup=%u data=%u busy=%u bus=%u\n",
+               (unsigned)st.viol_cycle, (unsigned)st.viol_pweh, (unsigned)st.viol_pwel,
+               (unsigned)st.viol_setup, (unsigned)st.viol_data, (unsigned)st.viol_busy,
+               (unsigned)st.viol_bus);
+    }
+
+    // Driver-side view of the same traffic (GLCD_BUS_STATS_ENABLE)
+    GLCD_BusStats_t bus;
+    GLCD_voidGetBusStats(&bus);
+    printf("fw_bus_transactions=%u\n", (unsigned)(bus.commands + bus.data_writes));
+    printf("fw_bus_cycles=%u\n", (unsigned)bus.cycles);
+    printf("uart_bytes=%u\n", (unsigned)SIM_u32UartBytes());
+
+#if GLCD_ASYNC_ENABLE
+    GLCD_QueueStats_t q;
+    GLCD_voidGetQueueStats(&q);
+    printf("glcd_queued=%u stalls=%u deferred=%u max_fill=%u max_bytes=%u\n", (unsigned)q.queued,
+           (unsigned)q.stalls, (unsigned)q.deferred, (unsigned)q.max_fill, (unsigned)q.max_bytes);
+#endif
+
+    // Capture ring headroom: how long the main loop left edges waiting
+    ICU_Stats_t icu;
+    ICU_voidGetStats(&icu);
+    printf("icu_captured=%u overruns=%u max_fill=%u", (unsigned)icu.captured,
+           (unsigned)icu.overruns, (unsigned)icu.max_fill);
+#if ICU_TRIGGER_ENABLE
+    printf(" triggers=%u", (unsigned)icu.triggers);
+#endif
+    printf("\n");
+
+#if EXTI_ENABLE
+    for (u8 ch = 0; ch < EXTI_CHANNELS; ch++)
+    {
+        EXTI_Stats_t ex;
+        EXTI_voidGetStats(ch, &ex);
+        printf("int%u_captured=%u overruns=%u missed=%u max_fill=%u\n", (unsigned)ch,
+               (unsigned)ex.captured, (unsigned)ex.overruns, (unsigned)ex.missed, (unsigned)ex.max_fill);
+    }
+#endif
+
+#if ADC_ENABLE
+    ADC_Stats_t ad;
+    ADC_voidGetStats(&ad);
+    printf("adc_samples=%u records=%u forced=%u\n", (unsigned)ad.samples, (unsigned)ad.records,
+           (unsigned)ad.forced);
+#endif
+
+    if (out != NULL && SIM_u8WriteFrame(out) != 0)
+    {
+        fprintf(stderr, "cannot write %s\n", out);
+        return 1;
+    }
+    return 0;
+}
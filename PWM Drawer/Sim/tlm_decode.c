@@ -0,0 +1,224 @@
+/*
+   Host decoder for the firmware's telemetry stream (APP/TLM): reads the raw
+   USART bytes from a file, a pty or stdin, checks every frame and replays
+   the records into CSV files.
+
+   tlm_decode [--in FILE|-] [--csv PREFIX]
+
+   With --csv, PREFIX_meas.csv, PREFIX_periods.csv and PREFIX_stats.csv are
+   written; without it the records are printed. A summary (frames, CRC
+   errors, sequence gaps, bytes skipped while resyncing) ends the output.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "Service/std_types.h"
+#include "Service/CRC/CRC_interface.h"
+#include "APP/TLM/TLM_int.h"
+
+typedef struct
+{
+    u32 frames;
+    u32 crc_errors;
+    u32 seq_gaps;           // Frames missing between two received ones
+    u32 skipped;            // Bytes dropped looking for a frame start
+    u32 unknown;            // Valid frames of a type this decoder does not know
+} TLM_Summary_t;
+
+static FILE *meas_csv, *periods_csv, *stats_csv;
+static TLM_Summary_t sum;
+static u8  have_seq = 0;
+static u8  last_seq = 0;
+static u32 frame_no = 0;    // Received frame count, the CSV time axis
+
+static u16 TLM_u16Get(const u8 *Copy_pu8Src)
+{
+    return (u16)(Copy_pu8Src[0] | (Copy_pu8Src[1] << 8));
+}
+
+static u32 TLM_u32Get(const u8 *Copy_pu8Src)
+{
+    return TLM_u16Get(Copy_pu8Src) | ((u32)TLM_u16Get(Copy_pu8Src + 2) << 16);
+}
+
+/* value / 10^frac as a decimal string */
+static void TLM_voidPrintScaled(FILE *Copy_pFile, u32 Copy_u32Value, u8 Copy_u8Frac)
+{
+    u32 scale = 1;
+    for (u8 i = 0; i < Copy_u8Frac; i++)
+        scale *= 10;
+    if (Copy_u8Frac == 0)
+        fprintf(Copy_pFile, "%u", (unsigned)Copy_u32Value);
+    else
+        fprintf(Copy_pFile, "%u.%0*u", (unsigned)(Copy_u32Value / scale), Copy_u8Frac,
+                (unsigned)(Copy_u32Value % scale));
+}
+
+static void TLM_voidRecord(u8 Copy_u8Type, u8 Copy_u8Seq, const u8 *Copy_pu8Payload, u8 Copy_u8Len)
+{
+    const u8 *p = Copy_pu8Payload;
+
+    switch (Copy_u8Type)
+    {
+    case TLM_TYPE_MEAS:
+        if (Copy_u8Len < TLM_MEAS_LEN) break;
+        fprintf(meas_csv, "%u,%u,", (unsigned)frame_no, (unsigned)Copy_u8Seq);
+        TLM_voidPrintScaled(meas_csv, TLM_u32Get(p), p[4]);
+        fprintf(meas_csv, ",");
+        TLM_voidPrintScaled(meas_csv, TLM_u16Get(p + 5), 1);
+        fprintf(meas_csv, ",%u,%u\n", (unsigned)TLM_u32Get(p + 7), (unsigned)p[11]);
+        return;
+
+    case TLM_TYPE_PERIODS:
+        if (Copy_u8Len < 2 || (Copy_u8Len - 2) % TLM_PERIOD_LEN != 0) break;
+        for (u8 i = 0; i < (Copy_u8Len - 2) / TLM_PERIOD_LEN; i++)
+        {
+            const u8 *rec = p + 2 + i * TLM_PERIOD_LEN;
+            fprintf(periods_csv, "%u,%u,%u,%u\n", (unsigned)Copy_u8Seq,
+                    (unsigned)(u16)(TLM_u16Get(p) + i), (unsigned)TLM_u32Get(rec),
+                    (unsigned)TLM_u32Get(rec + 4));
+        }
+        return;
+
+    case TLM_TYPE_STATS:
+        if (Copy_u8Len < TLM_STATS_LEN) break;
+        fprintf(stats_csv, "%u,%u,%u", (unsigned)frame_no, (unsigned)Copy_u8Seq, (unsigned)TLM_u16Get(p));
+        for (u8 i = 0; i < 11; i++)
+            fprintf(stats_csv, ",%u", (unsigned)TLM_u32Get(p + 2 + 4 * i));
+        fprintf(stats_csv, ",%u\n", (unsigned)p[46]);
+        return;
+    }
+    sum.unknown++;
+}
+
+/* Take the frame at the start of Copy_pu8Buf if there is a complete, valid
+   one; returns the bytes consumed, 0 if more are needed, or 1 to skip a
+   byte that cannot start a frame */
+static u32 TLM_u32Frame(const u8 *Copy_pu8Buf, u32 Copy_u32Len)
+{
+    u8 len;
+    u16 crc;
+
+    if (Copy_u32Len < 2)
+        return 0;
+    if (Copy_pu8Buf[0] != TLM_SYNC0 || Copy_pu8Buf[1] != TLM_SYNC1)
+        return 1;
+    if (Copy_u32Len < TLM_HEADER_LEN)
+        return 0;
+    len = Copy_pu8Buf[4];
+    if (len > TLM_PAYLOAD_MAX)
+        return 1;
+    if (Copy_u32Len < (u32)TLM_FRAME_OVERHEAD + len)
+        return 0;
+
+    crc = CRC_u16Update(CRC_INIT, Copy_pu8Buf + 2, len + 3);
+    if (crc != TLM_u16Get(Copy_pu8Buf + TLM_HEADER_LEN + len))
+    {
+        // Sync bytes inside a payload look like this too: only count
+        // a mismatch as an error, and resync from the next byte
+        sum.crc_errors++;
+        return 1;
+    }
+
+    u8 seq = Copy_pu8Buf[3];
+    if (have_seq)
+        sum.seq_gaps += (u8)(seq - last_seq - 1);
+    last_seq = seq;
+    have_seq = 1;
+
+    sum.frames++;
+    frame_no++;
+    TLM_voidRecord(Copy_pu8Buf[2], seq, Copy_pu8Buf + TLM_HEADER_LEN, len);
+    return TLM_FRAME_OVERHEAD + len;
+}
+
+static FILE *TLM_pOpenCsv(const char *Copy_pcPrefix, const char *Copy_pcName, const char *Copy_pcHeader)
+{
+    char path[256];
+    FILE *f;
+
+    snprintf(path, sizeof(path), "%s_%s.csv", Copy_pcPrefix, Copy_pcName);
+    f = fopen(path, "w");
+    if (f != NULL)
+        fprintf(f, "%s\n", Copy_pcHeader);
+    return f;
+}
+
+int main(int argc, char **argv)
+{
+    const char *in = "-";
+    const char *prefix = NULL;
+    FILE *src;
+    u8 buf[4096];
+    u32 fill = 0;
+    size_t got;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--in") == 0 && i + 1 < argc)
+            in = argv[++i];
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            prefix = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--in FILE|-] [--csv PREFIX]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    src = (strcmp(in, "-") == 0) ? stdin : fopen(in, "rb");
+    if (src == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", in);
+        return 1;
+    }
+
+    static const char meas_header[] = "frame,seq,freq_hz,duty_pct,period_cycles,flags";
+    static const char periods_header[] = "seq,index,period_cycles,high_cycles";
+    static const char stats_header[] = "frame,seq,count,period_min,period_max,period_mean,period_stddev,"
+                                       "high_min,high_max,high_mean,high_stddev,jitter_pp,jitter_rms,jitter_c2c,flags";
+    if (prefix != NULL)
+    {
+        meas_csv = TLM_pOpenCsv(prefix, "meas", meas_header);
+        periods_csv = TLM_pOpenCsv(prefix, "periods", periods_header);
+        stats_csv = TLM_pOpenCsv(prefix, "stats", stats_header);
+        if (meas_csv == NULL || periods_csv == NULL || stats_csv == NULL)
+        {
+            fprintf(stderr, "cannot write %s_*.csv\n", prefix);
+            return 1;
+        }
+    }
+    else
+    {
+        meas_csv = periods_csv = stats_csv = stdout;
+    }
+
+    // A pty reports EOF (EIO) once the simulator closes its side
+    while ((got = fread(buf + fill, 1, sizeof(buf) - fill, src)) > 0)
+    {
+        u32 pos = 0, used;
+
+        fill += (u32)got;
+        while ((used = TLM_u32Frame(buf + pos, fill - pos)) > 0)
+        {
+            if (used == 1)
+                sum.skipped++;
+            pos += used;
+        }
+        memmove(buf, buf + pos, fill - pos);
+        fill -= pos;
+    }
+    sum.skipped += fill;    // Trailing partial frame
+
+    if (prefix != NULL)
+    {
+        fclose(meas_csv);
+        fclose(periods_csv);
+        fclose(stats_csv);
+    }
+    fprintf(prefix != NULL ? stdout : stderr,
+            "frames=%u crc_errors=%u seq_gaps=%u skipped_bytes=%u unknown=%u\n",
+            (unsigned)sum.frames, (unsigned)sum.crc_errors, (unsigned)sum.seq_gaps,
+            (unsigned)sum.skipped, (unsigned)sum.unknown);
+    return 0;
+}